@@ -11,19 +11,26 @@
 #include <exec/execbase.h>
 #include <exec/memory.h>
 #include <devices/timer.h>
+#include <dos/dos.h>
+#include <dos/dostags.h>
 
 #include <proto/exec.h>
+#include <proto/dos.h>
 #include <proto/timer.h>
 #include <clib/alib_protos.h>
 
 #include "xsysinfo.h"
 #include "benchmark.h"
+#include "harness.h"
 #include "hardware.h"
 #include "debug.h"
 #include "cpu.h"
+#include "cache.h"
+#include "software.h"
 #include "locale_str.h"
 
 extern struct ExecBase *SysBase;
+extern struct DosLibrary *DOSBase;
 
 
 /* Global benchmark results */
@@ -68,9 +75,27 @@ static BOOL etimer_open = FALSE;
 /* External references */
 extern HardwareInfo hw_info;
 
-/* Dhrystone implementation (from original source) */
+/* Dhrystone implementation (from original source), one copy per build */
 int Dhry_Initialize(void);
 void Dhry_Run(unsigned long Number_Of_Runs);
+int Dhry020_Dhry_Initialize(void);
+void Dhry020_Dhry_Run(unsigned long Number_Of_Runs);
+int Dhry040_Dhry_Initialize(void);
+void Dhry040_Dhry_Run(unsigned long Number_Of_Runs);
+int Dhry060_Dhry_Initialize(void);
+void Dhry060_Dhry_Run(unsigned long Number_Of_Runs);
+
+/* Entry points and name for each DhryBuild */
+static const struct {
+    int (*initialize)(void);
+    void (*run)(unsigned long Number_Of_Runs);
+    const char *name;
+} dhry_builds[DHRY_BUILDS] = {
+    { Dhry_Initialize,         Dhry_Run,         "68000" },
+    { Dhry020_Dhry_Initialize, Dhry020_Dhry_Run, "68020/881" },
+    { Dhry040_Dhry_Initialize, Dhry040_Dhry_Run, "68040" },
+    { Dhry060_Dhry_Initialize, Dhry060_Dhry_Run, "68060" },
+};
 
 /*
  * Initialize timer for benchmarking
@@ -503,68 +528,372 @@ void wait_ticks(ULONG ticks)
 }
 
 /*
- * Run the original Dhrystone 2.1 benchmark
+ * Check whether Ctrl-C has been sent to the running task (without
+ * clearing it), the background task is cancelled this way
  */
-ULONG run_dhrystone(void)
+BOOL benchmark_cancelled(void)
 {
-    const ULONG default_loops = 1000UL;
-    const uint64_t min_runtime_us = 2000000ULL; /* Aim for ~2 seconds to reduce timer noise */
-    const uint64_t max_loops = 5000000ULL;      /* Upper bound from the original sources */
-    const int max_attempts = 3;
-    ULONG loops = default_loops;
-    ULONG E_Freq;
-    struct EClockVal start, end;
-    uint64_t elapsed = 0;
-    int attempt;
+    return (SetSignal(0, 0) & SIGBREAKF_CTRL_C) != 0;
+}
 
-    if (!benchmark_timer_available()) return 0;
+/* Timed runs after calibration, 0 = calibration run only (repeat mode off) */
+static ULONG bench_repeat_runs = 0;
 
-    for (attempt = 0; attempt < max_attempts; attempt++) {
-        if (!Dhry_Initialize()) {
-            return 0;
-        }
-        Forbid();
-        E_Freq = read_benchmark_clock(&start);
-        Dhry_Run(loops);
-        E_Freq = read_benchmark_clock(&end);
-        Permit();
-        elapsed = EClock_Diff_in_ms(&start, &end, E_Freq);
+/*
+ * Enable repeat mode with the given number of timed runs
+ */
+void set_benchmark_repeat(ULONG runs)
+{
+    if (runs > BENCH_MAX_REPEAT) runs = BENCH_MAX_REPEAT;
+    bench_repeat_runs = runs;
+}
+
+/*
+ * Dhrystone kernel, data is the DhryBuild. Initialize() resets the
+ * Dhrystone globals before every run
+ */
+static BOOL dhry_setup(APTR data)
+{
+    return dhry_builds[(ULONG)data].initialize() != 0;
+}
+
+static void dhry_run(APTR data, ULONG iterations, BenchWork *work)
+{
+    dhry_builds[(ULONG)data].run(iterations);
+    work->work = iterations;
+}
+
+/* Dhrystones per second for each build */
+static BenchKernel dhry_kernels[DHRY_BUILDS] = {
+    { "Dhrystone 68000", dhry_setup, dhry_run, (APTR)DHRY_BUILD_68000, 1000000,
+      DHRY_START_LOOPS, DHRY_MAX_LOOPS, DHRY_MIN_RUNTIME_US, BENCH_KERNEL_FORBID },
+    { "Dhrystone 68020", dhry_setup, dhry_run, (APTR)DHRY_BUILD_68020, 1000000,
+      DHRY_START_LOOPS, DHRY_MAX_LOOPS, DHRY_MIN_RUNTIME_US, BENCH_KERNEL_FORBID },
+    { "Dhrystone 68040", dhry_setup, dhry_run, (APTR)DHRY_BUILD_68040, 1000000,
+      DHRY_START_LOOPS, DHRY_MAX_LOOPS, DHRY_MIN_RUNTIME_US, BENCH_KERNEL_FORBID },
+    { "Dhrystone 68060", dhry_setup, dhry_run, (APTR)DHRY_BUILD_68060, 1000000,
+      DHRY_START_LOOPS, DHRY_MAX_LOOPS, DHRY_MIN_RUNTIME_US, BENCH_KERNEL_FORBID },
+};
+
+/* Shorter runs of the baseline for comparing many cache configurations */
+static BenchKernel dhry_short_kernel = {
+    "Dhrystone short", dhry_setup, dhry_run, (APTR)DHRY_BUILD_68000, 1000000,
+    DHRY_START_LOOPS, DHRY_MAX_LOOPS, CACHE_MATRIX_DHRY_US, BENCH_KERNEL_FORBID
+};
+
+/*
+ * Dhrystone build matching the CPU. The CPU builds use FPU code
+ * generation, so without a working FPU the baseline is used
+ */
+DhryBuild select_dhry_build(void)
+{
+    DhryBuild build;
 
-        if (elapsed >= min_runtime_us || loops >= max_loops) {
+    switch (hw_info.cpu_type) {
+        case CPU_68020:
+        case CPU_68EC020:
+        case CPU_68030:
+        case CPU_68EC030:
+            build = DHRY_BUILD_68020;
             break;
-        }
+        case CPU_68040:
+        case CPU_68LC040:
+        case CPU_68EC040:
+        case CPU_EMU:
+            build = DHRY_BUILD_68040;
+            break;
+        case CPU_68060:
+        case CPU_68EC060:
+        case CPU_68LC060:
+        case CPU_68080:
+            build = DHRY_BUILD_68060;
+            break;
+        default:
+            build = DHRY_BUILD_68000;
+            break;
+    }
 
-        if (elapsed < 100) { // super fast system
-            loops *= 16;
-            if (loops > max_loops) {
-                loops = max_loops;
-            }
-        } else {
-            unsigned long long scaled_loops = (min_runtime_us * (uint64_t)loops / elapsed) + (uint64_t)loops;
-            if (scaled_loops <= (uint64_t)loops) {
-                scaled_loops = (2ULL) * (uint64_t)loops; //double the loops
-            }
-            if (scaled_loops > max_loops) {
-                scaled_loops = max_loops;
+    if (hw_info.fpu_type == FPU_NONE || !hw_info.fpu_enabled) {
+        build = DHRY_BUILD_68000;
+    }
+
+    return build;
+}
+
+/*
+ * Name of a Dhrystone build
+ */
+const char *get_dhry_build_name(DhryBuild build)
+{
+    return build < DHRY_BUILDS ? dhry_builds[build].name : "";
+}
+
+/*
+ * Run the original Dhrystone 2.1 benchmark with the given build.
+ * In repeat mode the calibrated loop count is timed several more times
+ * and the median is returned, stats (if set) receives the distribution
+ */
+ULONG run_dhrystone_build(DhryBuild build, BenchStats *stats)
+{
+    if (build >= DHRY_BUILDS) build = DHRY_BUILD_68000;
+
+    return harness_run(&dhry_kernels[build], bench_repeat_runs, stats);
+}
+
+/*
+ * Run Dhrystone with the build picked for this CPU
+ */
+ULONG run_dhrystone(BenchStats *stats)
+{
+    return run_dhrystone_build(select_dhry_build(), stats);
+}
+
+/*
+ * Shorter Dhrystone run for comparing many configurations
+ */
+static ULONG run_dhrystone_short(void)
+{
+    return harness_run(&dhry_short_kernel, 0, NULL);
+}
+
+/* Results of the last cache configuration run */
+CacheMatrix cache_matrix;
+
+/*
+ * Next cache configuration to test, FALSE when all are done. Only
+ * features the CPU has are switched, and bursts/copyback only together
+ * with their cache
+ */
+static BOOL next_cache_config(ULONG *combo, CacheConfig *config)
+{
+    while (*combo < 64) {
+        ULONG c = (*combo)++;
+
+        config->icache = (c & 0x01) != 0;
+        config->dcache = (c & 0x02) != 0;
+        config->iburst = (c & 0x04) != 0;
+        config->dburst = (c & 0x08) != 0;
+        config->copyback = (c & 0x10) != 0;
+        config->super_scalar = (c & 0x20) != 0;
+
+        if (config->icache && !cpu_has_icache()) continue;
+        if (config->dcache && !cpu_has_dcache()) continue;
+        if (config->iburst && (!cpu_has_iburst() || !config->icache)) continue;
+        if (config->dburst && (!cpu_has_dburst() || !config->dcache)) continue;
+        if (config->copyback && (!cpu_has_copyback() || !config->dcache)) continue;
+        if (config->super_scalar && !cpu_has_super_scalar()) continue;
+
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+/*
+ * Run Dhrystone and the memory read kernel for every valid cache
+ * configuration, then restore the original settings
+ */
+void run_cache_matrix(CacheMatrix *matrix)
+{
+    CacheConfig original, wanted;
+    APTR buffer;
+    ULONG buffer_size = CACHE_MATRIX_BUFFER + 16;
+    ULONG combo = 0;
+    ULONG i;
+
+    memset(matrix, 0, sizeof(CacheMatrix));
+
+    if (!benchmark_timer_available()) return;
+
+    buffer = AllocMem(buffer_size, MEMF_FAST);
+    if (!buffer) buffer = AllocMem(buffer_size, MEMF_ANY);
+    if (!buffer) return;
+
+    get_cache_config(&original);
+
+    while (matrix->count < CACHE_MATRIX_MAX && next_cache_config(&combo, &wanted)) {
+        CacheMatrixEntry *entry = &matrix->entries[matrix->count];
+        BOOL duplicate = FALSE;
+
+        if (benchmark_cancelled()) break;
+
+        set_cache_config(&wanted);
+        get_cache_config(&entry->config);
+
+        /* On the 68040/060 several settings end up as the same CACR */
+        for (i = 0; i < matrix->count; i++) {
+            if (memcmp(&matrix->entries[i].config, &entry->config, sizeof(CacheConfig)) == 0) {
+                duplicate = TRUE;
+                break;
             }
-            loops = (ULONG)scaled_loops;
         }
+        if (duplicate) continue;
+
+        entry->dhrystones = run_dhrystone_short();
+        entry->read_speed = measure_mem_read_speed((volatile ULONG *)buffer, buffer_size,
+                                                   CACHE_MATRIX_ITERATIONS);
+        debug("  bench: cache config %lu: %lu dhrystones, %lu bytes/s\n",
+              combo - 1, entry->dhrystones, entry->read_speed);
+
+        if (entry->dhrystones > matrix->entries[matrix->best_dhrystones].dhrystones) {
+            matrix->best_dhrystones = matrix->count;
+        }
+        if (entry->read_speed > matrix->entries[matrix->best_read].read_speed) {
+            matrix->best_read = matrix->count;
+        }
+        matrix->count++;
     }
 
-    debug("  bench: finished Dhrystone with %lu attempts and %lu loops in %lu us\n", attempt, loops, (ULONG)elapsed);
-    if (elapsed == 0) {
-        return 0;
+    set_cache_config(&original);
+    refresh_cache_status();
+    FreeMem(buffer, buffer_size);
+
+    matrix->valid = matrix->count > 0;
+}
+
+/* DoFpuKernel() kernel and operations per loop for each FpuOp */
+static const struct {
+    const char *name;
+    ULONG kernel;
+    ULONG ops_per_loop;
+} fpu_ops[FPU_OPS] = {
+    { "FADD",  ASM_FPK_FADD,  8 },
+    { "FMUL",  ASM_FPK_FMUL,  8 },
+    { "FDIV",  ASM_FPK_FDIV,  4 },
+    { "FSQRT", ASM_FPK_FSQRT, 4 },
+    { "FSIN",  ASM_FPK_FSIN,  4 },
+    { "FLOGN", ASM_FPK_FLOGN, 4 },
+    { "FETOX", ASM_FPK_FETOX, 4 },
+    { "DAXPY", 0,             FPU_DAXPY_LENGTH * 2 },
+};
+
+/*
+ * Name of an FPU suite operation
+ */
+const char *get_fpu_op_name(FpuOp op)
+{
+    return op < FPU_OPS ? fpu_ops[op].name : "";
+}
+
+/*
+ * TRUE if a 680x0.library is loaded to handle unimplemented FPU instructions
+ */
+static BOOL fpsp_available(void)
+{
+    BOOL found;
+
+    Forbid();
+    found = FindName(&SysBase->LibList, (CONST_STRPTR)"68040.library") != NULL ||
+            FindName(&SysBase->LibList, (CONST_STRPTR)"68060.library") != NULL;
+    Permit();
+
+    return found;
+}
+
+/* Kernel data of an FPU suite operation */
+typedef struct {
+    ULONG op;
+    double *x;              /* DAXPY arrays */
+    double *y;
+} FpuSuiteData;
+
+static FpuSuiteData fpu_suite_data[FPU_OPS];
+static BenchKernel fpu_suite_kernels[FPU_OPS];
+
+static BOOL fpu_suite_setup(APTR data)
+{
+    FpuSuiteData *d = (FpuSuiteData *)data;
+    ULONG i;
+
+    if (d->op == FPU_OP_DAXPY) {
+        for (i = 0; i < FPU_DAXPY_LENGTH; i++) {
+            d->x[i] = 1.0;
+            d->y[i] = 0.5;
+        }
     }
+    return TRUE;
+}
 
-    {
-        uint64_t dhrystones_per_sec =
-            ((uint64_t)loops * 1000000ULL) / elapsed;
+static void fpu_suite_run(APTR data, ULONG iterations, BenchWork *work)
+{
+    FpuSuiteData *d = (FpuSuiteData *)data;
+
+    if (d->op == FPU_OP_DAXPY) {
+        DoDaxpy(d->x, d->y, FPU_DAXPY_LENGTH, iterations);
+    } else {
+        DoFpuKernel(iterations, fpu_ops[d->op].kernel);
+    }
+    work->work = (uint64_t)iterations * fpu_ops[d->op].ops_per_loop;
+}
+
+/*
+ * Run the FPU operation breakdown. Loops grow until the run takes
+ * FPU_SUITE_MIN_US, so slow (emulated) operations do not stall the suite.
+ * The 68881/68882 implement all operations, on the 68040/68060 (and the
+ * 68080) the transcendentals only run if a 680x0.library is there to
+ * emulate them
+ */
+void run_fpu_suite(FpuSuite *suite)
+{
+    double *x = NULL, *y = NULL;
+    BOOL transcendentals;
+    ULONG array_size = FPU_DAXPY_LENGTH * sizeof(double);
+    ULONG op;
+
+    memset(suite, 0, sizeof(FpuSuite));
+
+    if (hw_info.fpu_type == FPU_NONE || hw_info.fpu_type == FPU_UNKNOWN ||
+        !hw_info.fpu_enabled || !benchmark_timer_available()) {
+        return;
+    }
+
+    if (hw_info.fpu_type == FPU_68881 || hw_info.fpu_type == FPU_68882) {
+        transcendentals = TRUE;
+    } else {
+        transcendentals = fpsp_available();
+        suite->emulated = transcendentals && hw_info.fpu_type != FPU_68080;
+    }
 
-        if (dhrystones_per_sec > ULONG_MAX) {
-            return ULONG_MAX;
+    x = AllocMem(array_size, MEMF_ANY);
+    y = AllocMem(array_size, MEMF_ANY);
+
+    for (op = 0; op < FPU_OPS; op++) {
+        BenchKernel *kernel = &fpu_suite_kernels[op];
+        BenchWork work;
+        uint64_t elapsed_ns;
+
+        if (op >= FPU_OP_FSIN && op <= FPU_OP_FETOX && !transcendentals) continue;
+        if (op == FPU_OP_DAXPY && (!x || !y)) continue;
+        if (benchmark_cancelled()) goto cleanup;
+
+        fpu_suite_data[op].op = op;
+        fpu_suite_data[op].x = x;
+        fpu_suite_data[op].y = y;
+
+        memset(kernel, 0, sizeof(BenchKernel));
+        kernel->name = fpu_ops[op].name;
+        kernel->setup = fpu_suite_setup;
+        kernel->run = fpu_suite_run;
+        kernel->data = &fpu_suite_data[op];
+        kernel->scale = 100;
+        kernel->start_iterations = FPU_SUITE_MIN_LOOPS;
+        kernel->max_iterations = FPU_SUITE_MAX_LOOPS;
+        kernel->min_runtime_us = FPU_SUITE_MIN_US;
+        kernel->flags = BENCH_KERNEL_FORBID;
+
+        if (!harness_calibrate(kernel, &work, &elapsed_ns)) goto cleanup;
+
+        if (elapsed_ns > 0 && work.work > 0) {
+            suite->mops[op] = harness_rate(kernel, &work, elapsed_ns);
+            suite->ns_per_op[op] = (ULONG)(elapsed_ns / work.work);
         }
-        return (ULONG)dhrystones_per_sec;
     }
+
+    suite->valid = TRUE;
+
+cleanup:
+    if (x) FreeMem(x, array_size);
+    if (y) FreeMem(y, array_size);
 }
 
 /*
@@ -582,84 +911,69 @@ ULONG calculate_mips(ULONG dhrystones)
 }
 
 /*
- * Run MFLOPS benchmark (floating point)
+ * DoFlops() kernel for the detected FPU, 0 if there is none
  */
-ULONG run_mflops_benchmark(void)
+static ULONG get_flops_kernel(void)
 {
-    struct EClockVal start, end;
-    ULONG E_Freq;
-    uint64_t elapsed = 0;
-    ULONG iterations = 50000;
-    ULONG multiplier;
-    ULONG fpu;
-
-    /* Check if FPU is available */
-    if (hw_info.fpu_type == FPU_NONE) {
-        debug("  bench: no fpu!\n");
-        return 0;
-    }
-
     switch (hw_info.fpu_type)
         {
         case FPU_NONE:
+            debug("  bench: no fpu!\n");
             return 0;
         case FPU_68881:
-            fpu = ASM_FPU_68881;
-            break;
+            return ASM_FPU_68881;
         case FPU_68882:
-            fpu = ASM_FPU_68882;
-            break;
+            return ASM_FPU_68882;
         case FPU_68040:
-            fpu = ASM_FPU_68040;
-            break;
+            return ASM_FPU_68040;
         case FPU_68060:
-            fpu = ASM_FPU_68060;
-            break;
+            return ASM_FPU_68060;
         case FPU_68080:
-            fpu = ASM_FPU_68080;
-            break;
+            return ASM_FPU_68080;
         case FPU_UNKNOWN:
         default:
             debug("  bench: unknown fpu!\n");
             return 0;
         }
+}
 
-    if (!benchmark_timer_available()) {
-        debug("  bench: no timer!\n");
+/* DoFlops() kernel for the detected FPU, set before a run */
+static ULONG flops_fpu_kernel = 0;
+
+static void flops_run(APTR data, ULONG iterations, BenchWork *work)
+{
+    DoFlops(iterations, *(ULONG *)data);
+    work->work = (uint64_t)iterations * FLOP_LOOP_INSTRUCTIONS + FLOP_INIT_INSTRUCTIONS;
+}
+
+/* MFLOPS * 100, FPU instructions per microsecond */
+static BenchKernel flops_kernel = {
+    "MFLOPS", NULL, flops_run, &flops_fpu_kernel, 100,
+    FLOPS_BASE_LOOPS, FLOPS_BASE_LOOPS * MAX_MULTIPLY, MIN_FLOP_MEASURE, BENCH_KERNEL_FORBID
+};
+
+/*
+ * Run MFLOPS benchmark (floating point).
+ * Repeat mode works as for run_dhrystone()
+ */
+ULONG run_mflops_benchmark(BenchStats *stats)
+{
+    if (stats) memset(stats, 0, sizeof(BenchStats));
+
+    /* Check if FPU is available */
+    flops_fpu_kernel = get_flops_kernel();
+    if (flops_fpu_kernel == 0) {
         return 0;
     }
 
-    for (multiplier = 1; multiplier <= MAX_MULTIPLY && elapsed < MIN_FLOP_MEASURE; multiplier++)
-    {
-        iterations = FLOPS_BASE_LOOPS * multiplier;
-        Forbid();
-        E_Freq = read_benchmark_clock(&start);
-        DoFlops(iterations, fpu);
-        E_Freq = read_benchmark_clock(&end);
-        Permit();
-        elapsed = EClock_Diff_in_ms(&start, &end, E_Freq);
-    }
-    debug("  bench: flops elapsed: %lu, loops %lu\n", (ULONG)elapsed, iterations);
-
-    /* Calculate MFLOPS * 100 using integer math */
-    if (elapsed > 0) {
-        ULONG total_ops = (iterations * FLOP_LOOP_INSTRUCTIONS) + FLOP_INIT_INSTRUCTIONS;
-        unsigned long long scaled =
-            (unsigned long long)total_ops * 100ULL;
-        scaled /= elapsed; /* ops per microsecond = MFLOPS */
-        if (scaled > ULONG_MAX) {
-            return ULONG_MAX;
-        }
-        return (ULONG)scaled;
+    if (!benchmark_timer_available()) {
+        debug("  bench: no timer!\n");
+        return 0;
     }
 
-    return 0;
+    return harness_run(&flops_kernel, bench_repeat_runs, stats);
 }
 
-/*
- * Measure memory read speed for a given address range
- * Returns speed in bytes per second
- */
 /*
  * Measure loop overhead for compensation
  */
@@ -686,45 +1000,59 @@ ULONG measure_loop_overhead(ULONG count)
 }
 
 /*
- * Measure memory read speed for a given address range
- * Returns speed in bytes per second
+ * Align a benchmark buffer to 16 bytes for optimal burst mode,
+ * shrinking the usable size by the bytes skipped
  */
-ULONG measure_mem_read_speed(volatile ULONG *src, ULONG buffer_size, ULONG iterations)
+static volatile ULONG *align_bench_buffer(volatile ULONG *buffer, ULONG *buffer_size)
 {
-    ULONG E_Freq;
-    struct EClockVal start, end;
-    uint64_t elapsed;
-    ULONG overhead;
-    ULONG total_read = 0, total_loops = 0;
-    ULONG longs_per_read;
-    ULONG loop_count;
-    ULONG i;
-    volatile ULONG *aligned_src;
+    volatile ULONG *aligned = (volatile ULONG *)(((ULONG)buffer + 15) & ~15);
 
-    /* Ensure buffer is large enough for our unrolled loop */
-    if (!TimerBase) return 0;
+    if ((ULONG)aligned > (ULONG)buffer) {
+        ULONG diff = (ULONG)aligned - (ULONG)buffer;
+        if (*buffer_size > diff) *buffer_size -= diff;
+        else *buffer_size = 0;
+    }
 
-    /* Align source pointer to 16 bytes for optimal burst mode */
-    aligned_src = (volatile ULONG *)(((ULONG)src + 15) & ~15);
+    return aligned;
+}
 
-    /* Adjust buffer size if alignment reduced available space */
-    if ((ULONG)aligned_src > (ULONG)src) {
-        ULONG diff = (ULONG)aligned_src - (ULONG)src;
-        if (buffer_size > diff) buffer_size -= diff;
-        else buffer_size = 0;
-    }
+/* Buffer of a memory kernel */
+typedef struct {
+    volatile ULONG *src;
+    volatile ULONG *dst;
+    ULONG bytes;            /* Transferred per iteration */
+    ULONG loop_count;       /* Kernel loops per iteration (chain links for latency) */
+    ULONG copy_kernel;      /* ASM_COPY_* */
+} MemKernelData;
 
-    longs_per_read = buffer_size / sizeof(ULONG);
-    loop_count = longs_per_read / 32; /* 8 regs * 4 unrolls = 32 longs (128 bytes) per iter */
+/*
+ * Time a memory kernel once with the caller's iteration count,
+ * returns work per second
+ */
+static ULONG measure_mem_kernel(const char *name, BenchSetupFunc setup, BenchKernelFunc run,
+                                MemKernelData *data, ULONG iterations)
+{
+    BenchKernel kernel;
 
-    if (loop_count == 0) return 0;
+    memset(&kernel, 0, sizeof(kernel));
+    kernel.name = name;
+    kernel.setup = setup;
+    kernel.run = run;
+    kernel.data = data;
+    kernel.scale = 1000000;
+    kernel.flags = BENCH_KERNEL_FORBID;
 
-    Forbid();
-    E_Freq = read_benchmark_clock(&start);
+    return harness_measure(&kernel, iterations);
+}
+
+static void mem_read_run(APTR data, ULONG iterations, BenchWork *work)
+{
+    MemKernelData *d = (MemKernelData *)data;
+    ULONG i;
 
     for (i = 0; i < iterations; i++) {
-        volatile ULONG *p = aligned_src;
-        ULONG count = loop_count;
+        volatile ULONG *p = d->src;
+        ULONG count = d->loop_count;
 
         /* ASM loop: 4x unrolled movem.l (8 regs) = 128 bytes per loop iteration
          * Matches 'bustest' implementation for maximum bus saturation.
@@ -741,45 +1069,343 @@ ULONG measure_mem_read_speed(volatile ULONG *src, ULONG buffer_size, ULONG itera
             :
             : "d1", "d2", "d3", "d4", "a1", "a2", "a3", "a4", "cc", "memory"
         );
-        total_read += buffer_size;
-        total_loops += loop_count;
     }
-    E_Freq = read_benchmark_clock(&end);
-    Permit();
-    elapsed = EClock_Diff_in_ms(&start, &end, E_Freq);
 
+    work->work = (uint64_t)d->bytes * iterations;
+    work->counter_loops = d->loop_count * iterations;
+}
 
-    /* Compensate for loop overhead */
-    overhead = measure_loop_overhead(total_loops);
-    if (elapsed > overhead) {
-        elapsed -= overhead;
-    } else {
-        /* Should not happen, but safety first */
-        elapsed = 1;
+/*
+ * Measure memory read speed for a given address range
+ * Returns speed in bytes per second
+ */
+ULONG measure_mem_read_speed(volatile ULONG *src, ULONG buffer_size, ULONG iterations)
+{
+    MemKernelData data;
+
+    /* Ensure buffer is large enough for our unrolled loop */
+    if (!TimerBase) return 0;
+
+    memset(&data, 0, sizeof(data));
+    data.src = align_bench_buffer(src, &buffer_size);
+    data.bytes = buffer_size;
+    data.loop_count = (buffer_size / sizeof(ULONG)) / 32; /* 8 regs * 4 unrolls = 32 longs (128 bytes) per iter */
+
+    if (data.loop_count == 0) return 0;
+
+    return measure_mem_kernel("memory read", NULL, mem_read_run, &data, iterations);
+}
+
+static void mem_write_run(APTR data, ULONG iterations, BenchWork *work)
+{
+    MemKernelData *d = (MemKernelData *)data;
+    ULONG i;
+
+    for (i = 0; i < iterations; i++) {
+        DoMemWrite((APTR)d->dst, d->loop_count);
     }
 
-    if (elapsed > 0 && total_read > 0) {
-        return (ULONG)(((uint64_t)total_read * 1000000ULL) / elapsed);
+    work->work = (uint64_t)d->bytes * iterations;
+    work->counter_loops = d->loop_count * iterations;
+}
+
+/*
+ * Measure memory write speed for a given buffer
+ * Returns speed in bytes per second
+ */
+ULONG measure_mem_write_speed(volatile ULONG *dst, ULONG buffer_size, ULONG iterations)
+{
+    MemKernelData data;
+
+    if (!TimerBase) return 0;
+
+    memset(&data, 0, sizeof(data));
+    data.dst = align_bench_buffer(dst, &buffer_size);
+    data.loop_count = buffer_size / 128; /* 4x movem.l of 8 regs per block */
+    data.bytes = data.loop_count * 128;
+    if (data.loop_count == 0) return 0;
+
+    return measure_mem_kernel("memory write", NULL, mem_write_run, &data, iterations);
+}
+
+static void mem_copy_run(APTR data, ULONG iterations, BenchWork *work)
+{
+    MemKernelData *d = (MemKernelData *)data;
+    ULONG i;
+
+    for (i = 0; i < iterations; i++) {
+        DoMemCopy((APTR)d->src, (APTR)d->dst, d->loop_count, d->copy_kernel);
     }
 
-    return 0;
+    work->work = (uint64_t)d->bytes * iterations;
+    work->counter_loops = d->loop_count * iterations;
+}
+
+/*
+ * Measure memory copy speed within a buffer, copying its lower half
+ * to its upper half with the given ASM_COPY_* kernel
+ * Returns bytes copied per second
+ */
+ULONG measure_mem_copy_speed(volatile ULONG *buffer, ULONG buffer_size, ULONG iterations, ULONG kernel)
+{
+    MemKernelData data;
+
+    if (!TimerBase) return 0;
+
+    memset(&data, 0, sizeof(data));
+    data.src = align_bench_buffer(buffer, &buffer_size);
+
+    /* Keep both halves 128 byte multiples so move16 stays aligned */
+    data.bytes = (buffer_size / 2) & ~127;
+    data.loop_count = data.bytes / 128;
+    if (data.loop_count == 0) return 0;
+
+    data.dst = (volatile ULONG *)((ULONG)data.src + data.bytes);
+    data.copy_kernel = kernel;
+
+    return measure_mem_kernel("memory copy", NULL, mem_copy_run, &data, iterations);
+}
+
+/*
+ * Pointer chase setup: link one word per 16 byte line into a single
+ * cycle in random order, then walk it once to warm up caches and ATC
+ */
+static BOOL mem_latency_setup(APTR data)
+{
+    MemKernelData *d = (MemKernelData *)data;
+    volatile ULONG *base = d->src;
+    ULONG lines = d->loop_count;
+    ULONG seed = 0x2545F491;
+    ULONG i, j, tmp;
+    volatile ULONG *p;
+    ULONG count;
+
+    /* Sattolo shuffle of line indices gives a single cycle over all lines */
+    for (i = 0; i < lines; i++) {
+        base[i * 4] = i;
+    }
+    for (i = lines - 1; i > 0; i--) {
+        seed = seed * 1103515245UL + 12345UL;
+        j = (seed >> 8) % i;
+        tmp = base[i * 4];
+        base[i * 4] = base[j * 4];
+        base[j * 4] = tmp;
+    }
+
+    /* Turn indices into addresses of the next line */
+    for (i = 0; i < lines; i++) {
+        base[i * 4] = (ULONG)&base[base[i * 4] * 4];
+    }
+
+    /* One lap to warm up caches and ATC */
+    p = base;
+    count = lines;
+    __asm__ volatile (
+        "1: move.l (%0),%0\n\t"
+        "subq.l #1,%1\n\t"
+        "bne.s 1b"
+        : "+a" (p), "+d" (count)
+        :
+        : "cc", "memory"
+    );
+
+    return TRUE;
+}
+
+static void mem_latency_run(APTR data, ULONG iterations, BenchWork *work)
+{
+    MemKernelData *d = (MemKernelData *)data;
+    volatile ULONG *p = d->src;
+    ULONG count = iterations;
+
+    __asm__ volatile (
+        "1: move.l (%0),%0\n\t"
+        "subq.l #1,%1\n\t"
+        "bne.s 1b"
+        : "+a" (p), "+d" (count)
+        :
+        : "cc", "memory"
+    );
+
+    work->work = iterations;
+    work->counter_loops = iterations;
+}
+
+/*
+ * Measure dependent-load latency by chasing a pointer chain through
+ * working_set bytes, one link per 16 byte cache line in random order
+ * Returns ns per access scaled by 100
+ */
+ULONG measure_mem_latency(volatile ULONG *buffer, ULONG working_set, ULONG accesses)
+{
+    BenchKernel kernel;
+    MemKernelData data;
+    BenchWork work;
+    uint64_t elapsed_ns;
+
+    if (!TimerBase || accesses == 0) return 0;
+
+    memset(&data, 0, sizeof(data));
+    data.src = align_bench_buffer(buffer, &working_set);
+    data.loop_count = working_set / 16;
+    if (data.loop_count < 2) return 0;
+
+    memset(&kernel, 0, sizeof(kernel));
+    kernel.name = "memory latency";
+    kernel.setup = mem_latency_setup;
+    kernel.run = mem_latency_run;
+    kernel.data = &data;
+    kernel.flags = BENCH_KERNEL_FORBID;
+
+    if (!harness_time(&kernel, accesses, &work, &elapsed_ns)) return 0;
+
+    /* ns -> ns * 100 per access */
+    return (ULONG)((elapsed_ns * 100ULL) / accesses);
+}
+
+/*
+ * Run the read kernel over working sets from CACHE_SWEEP_MIN_SIZE up to
+ * whatever fits in buffer_size, reading CACHE_SWEEP_BYTES per step
+ */
+void run_cache_sweep(volatile ULONG *buffer, ULONG buffer_size, CacheSweep *sweep)
+{
+    volatile ULONG *aligned;
+    ULONG size, iterations;
+    int i;
+
+    memset(sweep, 0, sizeof(*sweep));
+
+    read_cache_state(&sweep->icache, &sweep->dcache, &sweep->iburst,
+                     &sweep->dburst, &sweep->copyback);
+
+    /* Align once so every step reads exactly its working-set size */
+    aligned = align_bench_buffer(buffer, &buffer_size);
+
+    for (i = 0, size = CACHE_SWEEP_MIN_SIZE;
+         i < CACHE_SWEEP_SIZES && size <= buffer_size;
+         i++, size <<= 1) {
+        iterations = CACHE_SWEEP_BYTES / size;
+        if (iterations == 0) iterations = 1;
+        sweep->bytes_sec[i] = measure_mem_read_speed(aligned, size, iterations);
+        debug("  bench: sweep %lu bytes: %lu bytes/s\n", size, sweep->bytes_sec[i]);
+    }
+
+    sweep->valid = TRUE;
+}
+
+/*
+ * Pick the fastest copy kernel the detected CPU supports
+ */
+ULONG select_copy_kernel(UWORD mem_type)
+{
+    /* Burst line transfers into Chip RAM are not safe on every board */
+    if (mem_type & MEMF_CHIP) {
+        return ASM_COPY_LONG;
+    }
+
+    switch (hw_info.cpu_type) {
+        case CPU_68040:
+        case CPU_68EC040:
+        case CPU_68LC040:
+        case CPU_68060:
+        case CPU_68EC060:
+        case CPU_68LC060:
+        case CPU_68080:
+            return ASM_COPY_MOVE16;
+        default:
+            return ASM_COPY_LONG;
+    }
 }
 
 /*
  * Helper to test RAM speed by allocating a buffer
  */
-static ULONG test_ram_speed(ULONG mem_flags, ULONG buffer_size, ULONG iterations)
+static void test_ram_speed(ULONG mem_flags, ULONG buffer_size, ULONG iterations,
+                           ULONG *read_speed, ULONG *write_speed, ULONG *copy_speed)
 {
     APTR buffer;
-    ULONG speed = 0;
+
+    *read_speed = 0;
+    *write_speed = 0;
+    *copy_speed = 0;
 
     buffer = AllocMem(buffer_size, mem_flags | MEMF_CLEAR);
     if (buffer) {
-        speed = measure_mem_read_speed(
+        *read_speed = measure_mem_read_speed(
             (volatile ULONG *)buffer, buffer_size, iterations);
+        *write_speed = measure_mem_write_speed(
+            (volatile ULONG *)buffer, buffer_size, iterations);
+        *copy_speed = measure_mem_copy_speed(
+            (volatile ULONG *)buffer, buffer_size, iterations,
+            select_copy_kernel((UWORD)mem_flags));
         FreeMem(buffer, buffer_size);
     }
-    return speed;
+}
+
+static void rom_call_run(APTR data, ULONG iterations, BenchWork *work)
+{
+    ULONG i;
+
+    for (i = 0; i < iterations; i++) {
+        FindTask(NULL);
+    }
+    work->work = iterations;
+    work->counter_loops = iterations;
+}
+
+/* FindTask() calls per second */
+static BenchKernel rom_call_kernel = {
+    "FindTask()", NULL, rom_call_run, NULL, 1000000,
+    ROM_CALL_MIN_LOOPS, ROM_CALL_MAX_LOOPS, ROM_CALL_MIN_US, BENCH_KERNEL_FORBID
+};
+
+/*
+ * Time a tight loop of exec calls. FindTask() is short and rarely
+ * patched, so it mostly shows how fast the CPU fetches ROM code
+ * Returns ns per call scaled by 100
+ */
+static ULONG measure_rom_call(void)
+{
+    BenchWork work;
+    uint64_t elapsed_ns;
+
+    if (!harness_calibrate(&rom_call_kernel, &work, &elapsed_ns) || work.work == 0) {
+        return 0;
+    }
+
+    return (ULONG)((elapsed_ns * 100ULL) / work.work);
+}
+
+/*
+ * Find out whether Kickstart runs from the ROM chips or from a RAM
+ * copy, through the mmu.library mappings or else by comparing ROM and
+ * FAST read speed, and whether shadowing it would pay off
+ */
+static void detect_rom_shadow(void)
+{
+    /* JMP <address> in the library vector */
+    ULONG target = *(volatile ULONG *)((UBYTE *)SysBase + LVO_FINDTASK + 2);
+    ULONG rom = bench_results.rom_speed;
+    ULONG fast = bench_results.fast_speed;
+
+    bench_results.rom_call_in_rom = target >= KICK_ROM_START && target <= KICK_ROM_END;
+    bench_results.rom_call_ns_x100 = benchmark_timer_available() ? measure_rom_call() : 0;
+
+    if (rom == 0) {
+        bench_results.rom_shadow = ROM_SHADOW_UNKNOWN;
+    } else if (mmu_rom_remapped()) {
+        bench_results.rom_shadow = ROM_SHADOW_MMU;
+    } else if (fast > 0 && (uint64_t)rom * 100 >= (uint64_t)fast * ROM_SHADOW_PERCENT) {
+        bench_results.rom_shadow = ROM_SHADOW_FAST;
+    } else {
+        bench_results.rom_shadow = ROM_NOT_SHADOWED;
+    }
+
+    bench_results.maprom_hint = bench_results.rom_shadow == ROM_NOT_SHADOWED &&
+                                fast >= rom * ROM_MAPROM_FACTOR;
+
+    debug("  bench: rom %lu fast %lu B/s, shadow %ld, call %lu ns/100\n",
+          rom, fast, (LONG)bench_results.rom_shadow, bench_results.rom_call_ns_x100);
 }
 
 /*
@@ -792,55 +1418,344 @@ void run_memory_speed_tests(void)
     ULONG iterations = 128;
 
     /* Test CHIP RAM speed */
-    bench_results.chip_speed = test_ram_speed(MEMF_CHIP, buffer_size, iterations);
+    test_ram_speed(MEMF_CHIP, buffer_size, iterations,
+                   &bench_results.chip_speed,
+                   &bench_results.chip_write_speed,
+                   &bench_results.chip_copy_speed);
 
     /* Test FAST RAM speed (if available) */
-    bench_results.fast_speed = test_ram_speed(MEMF_FAST, buffer_size, iterations);
+    test_ram_speed(MEMF_FAST, buffer_size, iterations,
+                   &bench_results.fast_speed,
+                   &bench_results.fast_write_speed,
+                   &bench_results.fast_copy_speed);
 
     /* Test ROM read speed (Kickstart ROM at $F80000) */
     bench_results.rom_speed = measure_mem_read_speed(
         (volatile ULONG *)0xF80000, buffer_size, iterations);
+
+    detect_rom_shadow();
+}
+
+static void cache_flush_run(APTR data, ULONG iterations, BenchWork *work)
+{
+    ULONG i;
+
+    for (i = 0; i < iterations; i++) {
+        CacheClearU();
+    }
+    work->work = iterations;
+    work->counter_loops = iterations;
 }
 
 /*
- * Run all benchmarks
+ * Time JIT_FLUSH_LOOPS CacheClearU() calls, returns microseconds
+ * per call scaled by 100
  */
-void run_benchmarks(void)
+static ULONG measure_cache_flush(void)
+{
+    BenchKernel kernel;
+    BenchWork work;
+    uint64_t elapsed_ns;
+
+    memset(&kernel, 0, sizeof(kernel));
+    kernel.name = "CacheClearU()";
+    kernel.run = cache_flush_run;
+    kernel.flags = BENCH_KERNEL_FORBID;
+
+    if (!harness_time(&kernel, JIT_FLUSH_LOOPS, &work, &elapsed_ns)) return 0;
+
+    return (ULONG)(elapsed_ns / (10ULL * JIT_FLUSH_LOOPS));
+}
+
+/*
+ * Emu68 translates 68k code the first time it runs, so a short
+ * calibrate-then-measure loop mostly times the translator. Time
+ * Dhrystone, DoFlops() and the memory read kernel once right after
+ * flushing the translation cache (cold), again after JIT_WARMUP_PASSES
+ * untimed runs with the same loop counts (warm), and what a flush and
+ * the retranslation after it cost. Run before the regular benchmarks,
+ * which then see translated code
+ */
+void run_jit_benchmarks(JitResults *jit)
+{
+    BenchKernel *dhry = &dhry_kernels[DHRY_BUILD_68000];
+    BenchWork work;
+    APTR buffer;
+    uint64_t dhry_elapsed = 0, retranslated = 0;
+    ULONG pass;
+
+    memset(jit, 0, sizeof(JitResults));
+
+    if (!benchmark_timer_available()) return;
+
+    buffer = AllocMem(JIT_MEM_BUFFER, MEMF_FAST);
+    if (!buffer) buffer = AllocMem(JIT_MEM_BUFFER, MEMF_ANY);
+    if (!buffer) return;
+
+    flops_fpu_kernel = hw_info.fpu_enabled ? get_flops_kernel() : 0;
+
+    /* Cold: every kernel runs for the first time since the flush */
+    CacheClearU();
+    if (!harness_time(dhry, JIT_DHRY_LOOPS, &work, &dhry_elapsed)) goto cleanup;
+    jit->dhry_cold = harness_rate(dhry, &work, dhry_elapsed);
+
+    if (flops_fpu_kernel) {
+        CacheClearU();
+        jit->mflops_cold = harness_measure(&flops_kernel, JIT_FLOPS_LOOPS);
+    }
+
+    CacheClearU();
+    jit->mem_cold = measure_mem_read_speed((volatile ULONG *)buffer, JIT_MEM_BUFFER,
+                                           JIT_MEM_ITERATIONS);
+
+    /* Warm-up, results are dropped */
+    for (pass = 0; pass < JIT_WARMUP_PASSES; pass++) {
+        if (benchmark_cancelled()) goto cleanup;
+        harness_time(dhry, JIT_DHRY_LOOPS, &work, &dhry_elapsed);
+        if (flops_fpu_kernel) harness_measure(&flops_kernel, JIT_FLOPS_LOOPS);
+        measure_mem_read_speed((volatile ULONG *)buffer, JIT_MEM_BUFFER, JIT_MEM_ITERATIONS);
+    }
+
+    /* Warm */
+    if (!harness_time(dhry, JIT_DHRY_LOOPS, &work, &dhry_elapsed)) goto cleanup;
+    jit->dhry_warm = harness_rate(dhry, &work, dhry_elapsed);
+
+    if (flops_fpu_kernel) {
+        jit->mflops_warm = harness_measure(&flops_kernel, JIT_FLOPS_LOOPS);
+    }
+
+    jit->mem_warm = measure_mem_read_speed((volatile ULONG *)buffer, JIT_MEM_BUFFER,
+                                           JIT_MEM_ITERATIONS);
+
+    /* Flush cost, then what bringing Dhrystone back costs */
+    jit->flush_us_x100 = measure_cache_flush();
+    CacheClearU();
+    if (harness_time(dhry, JIT_DHRY_LOOPS, &work, &retranslated) && retranslated > dhry_elapsed) {
+        jit->retranslate_us = (ULONG)((retranslated - dhry_elapsed) / 1000ULL);
+    }
+
+    jit->valid = TRUE;
+    debug("  bench: jit dhry %lu/%lu, mflops %lu/%lu, mem %lu/%lu (cold/warm)\n",
+          jit->dhry_cold, jit->dhry_warm, jit->mflops_cold, jit->mflops_warm,
+          jit->mem_cold, jit->mem_warm);
+    debug("  bench: jit flush %lu us/100, retranslate %lu us\n",
+          jit->flush_us_x100, jit->retranslate_us);
+
+cleanup:
+    FreeMem(buffer, JIT_MEM_BUFFER);
+}
+
+/* Background benchmark process */
+static struct Process *bench_process = NULL;
+static struct MsgPort *bench_progress_port = NULL;
+static BenchProgressMsg bench_progress_msg;
+
+/*
+ * Report a finished phase to the main loop and wait until it has drawn
+ * the new results. Returns FALSE if the run should be cancelled
+ */
+static BOOL report_phase(struct MsgPort *reply_port, BenchPhase phase)
+{
+    if (reply_port) {
+        bench_progress_msg.msg.mn_ReplyPort = reply_port;
+        bench_progress_msg.msg.mn_Length = sizeof(BenchProgressMsg);
+        bench_progress_msg.phase = phase;
+        bench_progress_msg.cancelled = FALSE;
+        PutMsg(bench_progress_port, &bench_progress_msg.msg);
+        WaitPort(reply_port);
+        GetMsg(reply_port);
+    }
+
+    return !benchmark_cancelled();
+}
+
+/*
+ * Run the benchmark suite, reporting each phase if reply_port is set.
+ * Returns FALSE if cancelled
+ */
+static BOOL run_benchmark_phases(struct MsgPort *reply_port)
 {
     //clear last results
     memset(&bench_results, 0, sizeof(bench_results));
 
+    /* The cold JIT runs must come before anything else is translated */
+    if (hw_info.cpu_type == CPU_EMU) {
+        debug("  bench: run emu68 jit passes...\n");
+        run_jit_benchmarks(&bench_results.jit);
+        if (benchmark_cancelled()) return FALSE;
+    }
+
     debug("  bench: run dhrystone...\n");
-    /* Run Dhrystone */
-    bench_results.dhrystones = run_dhrystone();
+    /* Run Dhrystone, the 68000 build stays comparable to the references */
+    bench_results.dhrystones = run_dhrystone_build(DHRY_BUILD_68000, &bench_results.dhry_stats);
 
     /* Calculate MIPS */
     debug("  bench: run mips...\n");
     bench_results.mips = calculate_mips(bench_results.dhrystones);
 
+    /* Same again, compiled for this CPU */
+    bench_results.dhry_build = select_dhry_build();
+    if (bench_results.dhry_build != DHRY_BUILD_68000) {
+        if (benchmark_cancelled()) return FALSE;
+        debug("  bench: run native dhrystone...\n");
+        bench_results.dhrystones_native = run_dhrystone(NULL);
+    } else {
+        bench_results.dhrystones_native = bench_results.dhrystones;
+    }
+    bench_results.mips_native = calculate_mips(bench_results.dhrystones_native);
+
+    /* Results are shown as soon as the first one is in */
+    bench_results.benchmarks_valid = TRUE;
+    if (!report_phase(reply_port, BENCH_PHASE_DHRYSTONE)) return FALSE;
+
     /* Run MFLOPS if FPU available */
     if (hw_info.fpu_type != FPU_NONE) {
         debug("  bench: run mflops...\n");
         //attention! an unpatched 68040 crashes here!
         if (hw_info.fpu_enabled) {
-            bench_results.mflops = run_mflops_benchmark();
+            bench_results.mflops = run_mflops_benchmark(&bench_results.mflops_stats);
+            debug("  bench: run fpu suite...\n");
+            run_fpu_suite(&bench_results.fpu_suite);
         }
         else {
             debug("  bench: 68040/060: missing 68040/060.library. Cannot compute flops!\n");
         }
+        if (!report_phase(reply_port, BENCH_PHASE_MFLOPS)) return FALSE;
     }
 
     /* Run memory speed tests (CHIP, FAST, ROM) */
     debug("  bench: run ram/rom speed...\n");
     run_memory_speed_tests();
+    if (!report_phase(reply_port, BENCH_PHASE_MEMORY)) return FALSE;
 
     debug("  bench: calc cpu frequency...\n");
     hw_info.cpu_mhz = get_mhz_cpu();
     debug("  bench: calc fpu frequency...\n");
     hw_info.fpu_mhz = get_mhz_fpu();
 
-    bench_results.benchmarks_valid = TRUE;
     generate_comment();
+    report_phase(reply_port, BENCH_PHASE_MHZ);
+
+    return TRUE;
+}
+
+/*
+ * Run all benchmarks
+ */
+void run_benchmarks(void)
+{
+    run_benchmark_phases(NULL);
+}
+
+#ifndef __KICK13__
+/*
+ * Background benchmark process entry
+ */
+static void benchmark_task_entry(void)
+{
+    struct MsgPort *reply_port;
+    BOOL completed = FALSE;
+
+    reply_port = CreateMsgPort();
+    if (reply_port) {
+        completed = run_benchmark_phases(reply_port);
+        DeleteMsgPort(reply_port);
+    }
+    debug("  bench: background run %s\n",
+          (LONG)(completed ? "completed" : "cancelled"));
+
+    /*
+     * Stay in Forbid() until the process is gone, so the main task
+     * cannot unload us before we are done
+     */
+    Forbid();
+    bench_progress_msg.msg.mn_ReplyPort = NULL;
+    bench_progress_msg.phase = BENCH_PHASE_DONE;
+    bench_progress_msg.cancelled = !completed;
+    PutMsg(bench_progress_port, &bench_progress_msg.msg);
+}
+#endif
+
+/*
+ * Start the benchmark suite on a background process. Progress messages
+ * arrive at progress_port, each but the last (BENCH_PHASE_DONE) must
+ * be replied. Returns FALSE if the process could not be started
+ */
+BOOL start_benchmark_task(struct MsgPort *progress_port)
+{
+#ifdef __KICK13__
+    (void)progress_port;
+    return FALSE;
+#else
+    if (bench_process || !progress_port) return FALSE;
+    if (DOSBase->dl_lib.lib_Version < 36) return FALSE;
+
+    bench_progress_port = progress_port;
+
+    /* Output is shared with us for debug() */
+    bench_process = CreateNewProcTags(NP_Entry, (ULONG)benchmark_task_entry,
+                                      NP_Name, (ULONG)XSYSINFO_NAME " benchmark",
+                                      NP_StackSize, BENCH_TASK_STACK,
+                                      NP_Priority, FindTask(NULL)->tc_Node.ln_Pri,
+                                      NP_Output, (ULONG)Output(),
+                                      NP_CloseOutput, FALSE,
+                                      TAG_DONE);
+
+    return bench_process != NULL;
+#endif
+}
+
+/*
+ * Background benchmark process still running?
+ */
+BOOL benchmark_task_running(void)
+{
+    return bench_process != NULL;
+}
+
+/*
+ * Ask the background benchmark to stop after the current measurement
+ */
+void cancel_benchmark_task(void)
+{
+    if (bench_process) {
+        Signal(&bench_process->pr_Task, SIGBREAKF_CTRL_C);
+    }
+}
+
+/*
+ * Handle a message from the background benchmark. Returns TRUE for the
+ * final one, after which the process is gone
+ */
+BOOL benchmark_task_finished(BenchProgressMsg *progress)
+{
+    if (progress->phase != BENCH_PHASE_DONE) {
+        return FALSE;
+    }
+
+    bench_process = NULL;
+    return TRUE;
+}
+
+/*
+ * Cancel the background benchmark and wait until it has finished,
+ * dropping any progress messages
+ */
+void stop_benchmark_task(void)
+{
+    struct Message *msg;
+
+    if (!bench_process) return;
+
+    cancel_benchmark_task();
+    while (bench_process) {
+        WaitPort(bench_progress_port);
+        while ((msg = GetMsg(bench_progress_port)) != NULL) {
+            if (!benchmark_task_finished((BenchProgressMsg *)msg)) {
+                ReplyMsg(msg);
+            }
+        }
+    }
 }
 
 /*
@@ -10,6 +10,7 @@
 
 #include "xsysinfo.h"
 #include "hardware.h"
+#include "cache.h"
 #include <devices/timer.h>
 #include <proto/timer.h>
 
@@ -43,20 +44,191 @@ typedef struct {
 #define FLOP_LOOP_INSTRUCTIONS 8
 #define FLOP_INIT_INSTRUCTIONS 3
 
+/* Dhrystone calibration */
+#define DHRY_START_LOOPS    1000
+#define DHRY_MAX_LOOPS      5000000UL   /* Upper bound from the original sources */
+#define DHRY_MIN_RUNTIME_US 2000000     /* ~2 seconds to reduce timer noise */
+
+/* Cache-size sweep: 256 bytes .. 1 MB, doubling each step */
+#define CACHE_SWEEP_SIZES       13
+#define CACHE_SWEEP_MIN_SIZE    256
+#define CACHE_SWEEP_MAX_SIZE    (CACHE_SWEEP_MIN_SIZE << (CACHE_SWEEP_SIZES - 1))
+#define CACHE_SWEEP_BYTES       (1024 * 1024)   /* Bytes read per step */
+
+/* Cache-size sweep results */
+typedef struct {
+    ULONG bytes_sec[CACHE_SWEEP_SIZES]; /* Read speed per working-set size (0 = not run) */
+    BOOL icache;            /* Cache state during the sweep */
+    BOOL dcache;
+    BOOL iburst;
+    BOOL dburst;
+    BOOL copyback;
+    BOOL valid;             /* TRUE if the sweep has been run */
+} CacheSweep;
+
+/* Cache configuration matrix */
+#define CACHE_MATRIX_MAX        32
+#define CACHE_MATRIX_DHRY_US    250000      /* Dhrystone runtime per configuration */
+#define CACHE_MATRIX_BUFFER     (64 * 1024) /* Read kernel working set */
+#define CACHE_MATRIX_ITERATIONS 32
+
+/* One cache configuration and its speed */
+typedef struct {
+    CacheConfig config;     /* Settings as read back from the CPU */
+    ULONG dhrystones;
+    ULONG read_speed;       /* Bytes/sec */
+} CacheMatrixEntry;
+
+typedef struct {
+    CacheMatrixEntry entries[CACHE_MATRIX_MAX];
+    ULONG count;
+    ULONG best_dhrystones;  /* Index of the fastest entry */
+    ULONG best_read;
+    BOOL valid;
+} CacheMatrix;
+
+extern CacheMatrix cache_matrix;
+
+/* FPU suite operations */
+typedef enum {
+    FPU_OP_FADD,            /* Throughput, 8 independent ops per loop */
+    FPU_OP_FMUL,
+    FPU_OP_FDIV,            /* Latency, dependent chain */
+    FPU_OP_FSQRT,
+    FPU_OP_FSIN,            /* Transcendentals, FPSP emulated on 68040/68060 */
+    FPU_OP_FLOGN,
+    FPU_OP_FETOX,
+    FPU_OP_DAXPY,           /* y = a * x + y over FPU_DAXPY_LENGTH doubles */
+    FPU_OPS
+} FpuOp;
+
+#define FPU_DAXPY_LENGTH        256
+#define FPU_SUITE_MIN_LOOPS     16
+#define FPU_SUITE_MAX_LOOPS     (1UL << 22)
+#define FPU_SUITE_MIN_US        20000   /* Minimum runtime per operation */
+
+/* FPU suite results */
+typedef struct {
+    ULONG mops[FPU_OPS];        /* Million operations/sec * 100 (0 = not run) */
+    ULONG ns_per_op[FPU_OPS];   /* Time per operation in ns */
+    BOOL emulated;              /* Transcendentals went through the FPSP */
+    BOOL valid;                 /* TRUE if the suite has been run */
+} FpuSuite;
+
+/* Repeat mode */
+#define BENCH_MAX_REPEAT        15      /* Timed runs after calibration (at most) */
+#define BENCH_DEFAULT_REPEAT    5
+#define BENCH_SPREAD_THRESHOLD  2       /* Flag if (max - min) > 2% of the median */
+
+/* Distribution of repeated runs */
+typedef struct {
+    ULONG median;           /* Reported value */
+    ULONG min;
+    ULONG max;
+    ULONG stddev;
+    ULONG runs;             /* Timed runs kept (1 = repeat mode off) */
+    ULONG outliers;         /* Runs dropped as outliers */
+    BOOL unstable;          /* Spread above BENCH_SPREAD_THRESHOLD */
+} BenchStats;
+
+/* Dhrystone builds (see Makefile), the baseline is plain 68000 code */
+typedef enum {
+    DHRY_BUILD_68000,
+    DHRY_BUILD_68020,       /* 68020/030 with 68881 */
+    DHRY_BUILD_68040,
+    DHRY_BUILD_68060,
+    DHRY_BUILDS
+} DhryBuild;
+
+/* Where Kickstart is served from */
+typedef enum {
+    ROM_SHADOW_UNKNOWN,     /* Not measured */
+    ROM_NOT_SHADOWED,       /* ROM chips */
+    ROM_SHADOW_MMU,         /* mmu.library maps it to a RAM copy */
+    ROM_SHADOW_FAST         /* Reads as fast as FAST RAM (MAPROM or MMU) */
+} RomShadow;
+
+/* ROM reads at this percentage of FAST RAM count as shadowed */
+#define ROM_SHADOW_PERCENT  75
+/* FAST RAM this many times faster than ROM makes MAPROM worth it */
+#define ROM_MAPROM_FACTOR   2
+
+/* Kickstart address range and the exec call timed in it */
+#define KICK_ROM_START      0x00F80000
+#define KICK_ROM_END        0x00FFFFFF
+#define LVO_FINDTASK        (-294)
+#define ROM_CALL_MIN_LOOPS  1024
+#define ROM_CALL_MAX_LOOPS  (1UL << 22)
+#define ROM_CALL_MIN_US     20000
+
+/* Emu68 JIT passes: cold (translated on the fly) vs. warm runs */
+#define JIT_WARMUP_PASSES   3       /* Untimed runs between cold and warm */
+#define JIT_DHRY_LOOPS      100000UL
+#define JIT_FLOPS_LOOPS     (FLOPS_BASE_LOOPS * 4)
+#define JIT_MEM_BUFFER      65536
+#define JIT_MEM_ITERATIONS  16
+#define JIT_FLUSH_LOOPS     64
+
+/* Emu68 JIT results */
+typedef struct {
+    ULONG dhry_cold;        /* Dhrystones per second, first run after a flush */
+    ULONG dhry_warm;        /* Same loop count after the warm-up passes */
+    ULONG mflops_cold;      /* MFLOPS * 100 (0 = no FPU) */
+    ULONG mflops_warm;
+    ULONG mem_cold;         /* Read kernel, bytes/sec */
+    ULONG mem_warm;
+    ULONG flush_us_x100;    /* One CacheClearU() * 100 */
+    ULONG retranslate_us;   /* Extra time of the first Dhrystone run after it */
+    BOOL valid;             /* TRUE if the passes have been run */
+} JitResults;
+
 /* Benchmark results */
 typedef struct {
     ULONG dhrystones;       /* Dhrystones per second */
     ULONG mips;             /* MIPS rating * 100 */
+    ULONG dhrystones_native; /* Dhrystones per second, build tuned for this CPU */
+    ULONG mips_native;      /* MIPS rating * 100 of that build */
+    DhryBuild dhry_build;   /* Build behind dhrystones_native */
     ULONG mflops;           /* MFLOPS rating * 100 */
     ULONG chip_speed;       /* Chip RAM speed in bytes/sec */
     ULONG fast_speed;       /* Fast RAM speed in bytes/sec (0 if no fast RAM) */
     ULONG rom_speed;        /* ROM read speed in bytes/sec */
+    ULONG chip_write_speed; /* Chip RAM write speed in bytes/sec */
+    ULONG fast_write_speed; /* Fast RAM write speed in bytes/sec */
+    ULONG chip_copy_speed;  /* Chip RAM copy speed in bytes/sec */
+    ULONG fast_copy_speed;  /* Fast RAM copy speed in bytes/sec */
+    BenchStats dhry_stats;  /* Spread of the Dhrystone runs */
+    BenchStats mflops_stats; /* Spread of the MFLOPS runs (* 100) */
+    FpuSuite fpu_suite;     /* Per-operation FPU breakdown */
+    RomShadow rom_shadow;   /* Kickstart ROM shadowing */
+    ULONG rom_call_ns_x100; /* exec FindTask() call * 100 */
+    BOOL rom_call_in_rom;   /* Its vector points into ROM, not a patch */
+    BOOL maprom_hint;       /* Shadowing the ROM would speed up the OS */
+    JitResults jit;         /* Emu68 cold/warm runs */
     BOOL benchmarks_valid;  /* TRUE if benchmarks have been run */
 } BenchmarkResults;
 
 /* Global benchmark results */
 extern BenchmarkResults bench_results;
 
+/* Benchmark suite phases, reported by the background benchmark task */
+typedef enum {
+    BENCH_PHASE_DHRYSTONE,
+    BENCH_PHASE_MFLOPS,
+    BENCH_PHASE_MEMORY,
+    BENCH_PHASE_MHZ,
+    BENCH_PHASE_DONE        /* Last message, not to be replied */
+} BenchPhase;
+
+/* Progress message sent to the main loop after each phase */
+typedef struct {
+    struct Message msg;
+    BenchPhase phase;       /* Phase that just finished */
+    BOOL cancelled;         /* Only with BENCH_PHASE_DONE */
+} BenchProgressMsg;
+
+#define BENCH_TASK_STACK    16384
+
 /* Global reference data */
 extern const ReferenceSystem reference_systems[NUM_REFERENCE_SYSTEMS];
 
@@ -68,11 +240,32 @@ void format_reference_label(char *buffer, size_t buffer_size, const ReferenceSys
 /* Run all benchmarks */
 void run_benchmarks(void);
 
+/* Run all benchmarks on a background process reporting to progress_port */
+BOOL start_benchmark_task(struct MsgPort *progress_port);
+BOOL benchmark_task_running(void);
+void cancel_benchmark_task(void);
+BOOL benchmark_task_finished(BenchProgressMsg *progress);
+void stop_benchmark_task(void);     /* Cancel and wait until it has finished */
+
 /* Individual benchmarks */
-ULONG run_dhrystone(void);
-ULONG run_mflops_benchmark(void);
+ULONG run_dhrystone(BenchStats *stats);     /* Build picked for this CPU */
+ULONG run_dhrystone_build(DhryBuild build, BenchStats *stats);
+DhryBuild select_dhry_build(void);
+const char *get_dhry_build_name(DhryBuild build);
+ULONG run_mflops_benchmark(BenchStats *stats);
+void set_benchmark_repeat(ULONG runs);  /* Timed runs per benchmark, 0 = off */
+BOOL benchmark_cancelled(void);         /* Ctrl-C sent to the running task */
+void run_fpu_suite(FpuSuite *suite);
+void run_cache_matrix(CacheMatrix *matrix);
+const char *get_fpu_op_name(FpuOp op);
 void run_memory_speed_tests(void);
+void run_jit_benchmarks(JitResults *jit);  /* Emu68 cold/warm passes */
 ULONG measure_mem_read_speed(volatile ULONG *src, ULONG buffer_size, ULONG iterations);
+ULONG measure_mem_write_speed(volatile ULONG *dst, ULONG buffer_size, ULONG iterations);
+ULONG measure_mem_copy_speed(volatile ULONG *buffer, ULONG buffer_size, ULONG iterations, ULONG kernel);
+ULONG select_copy_kernel(UWORD mem_type);  /* Best ASM_COPY_* kernel for this CPU */
+ULONG measure_mem_latency(volatile ULONG *buffer, ULONG working_set, ULONG accesses);
+void run_cache_sweep(volatile ULONG *buffer, ULONG buffer_size, CacheSweep *sweep);
 ULONG get_mhz_cpu();
 ULONG get_mhz_fpu();
 
@@ -0,0 +1,230 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Blitter throughput benchmark
+ *
+ * Times blitter copies, fills and lines through graphics.library on
+ * single-plane CHIP blocks of growing size, and a CPU copy of the same
+ * blocks with the kernel the memory benchmarks use for CHIP RAM.
+ * Small blits are dominated by the setup in BltBitMap(), large ones by
+ * the DMA slots the blitter gets, so on a fast CPU the copy loop wins
+ * up to some block size. That size is reported as the crossover.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <exec/memory.h>
+#include <graphics/gfx.h>
+#include <graphics/rastport.h>
+
+#include <proto/exec.h>
+#include <proto/graphics.h>
+
+#include "xsysinfo.h"
+#include "blitbench.h"
+#include "benchmark.h"
+#include "hardware.h"
+#include "cpu.h"
+#include "gui.h"
+#include "locale_str.h"
+#include "debug.h"
+
+extern HardwareInfo hw_info;
+
+/* Global results */
+BlitBenchResults blit_results;
+
+static const char *blit_op_names[BLIT_OPS] = {
+    "copy", "fill", "line", "cpu copy"
+};
+
+/*
+ * Side in pixels of a block size
+ */
+ULONG get_blit_side(ULONG size_index)
+{
+    return BLIT_MIN_SIDE << size_index;
+}
+
+/*
+ * Run one operation loops times on side x side blocks
+ * Returns elapsed microseconds
+ */
+static uint64_t time_blit_op(ULONG op, ULONG side, UBYTE *src, UBYTE *dst, ULONG loops)
+{
+    struct BitMap src_bm, dst_bm;
+    struct RastPort rp;
+    struct EClockVal start, end;
+    ULONG E_Freq;
+    ULONG bytes = side * side / 8;
+    ULONG kernel = select_copy_kernel(MEMF_CHIP);
+    ULONG i;
+
+    /* BytesPerRow is side / 8, so every block is contiguous like the CPU copy */
+    InitBitMap(&src_bm, 1, side, side);
+    src_bm.Planes[0] = (PLANEPTR)src;
+    InitBitMap(&dst_bm, 1, side, side);
+    dst_bm.Planes[0] = (PLANEPTR)dst;
+
+    InitRastPort(&rp);
+    rp.BitMap = &dst_bm;
+    SetAPen(&rp, 1);
+    SetDrMd(&rp, JAM1);
+
+    Forbid();
+    E_Freq = read_benchmark_clock(&start);
+
+    switch (op) {
+        case BLIT_OP_COPY:
+            for (i = 0; i < loops; i++) {
+                BltBitMap(&src_bm, 0, 0, &dst_bm, 0, 0, side, side, 0xC0, 0x01, NULL);
+            }
+            break;
+
+        case BLIT_OP_FILL:
+            for (i = 0; i < loops; i++) {
+                /* Rows in the upper word, bytes per row in the lower */
+                BltClear(dst, (side << 16) | (side / 8), 2);
+            }
+            break;
+
+        case BLIT_OP_LINE:
+            for (i = 0; i < loops; i++) {
+                Move(&rp, 0, (i & 1) ? side - 1 : 0);
+                Draw(&rp, side - 1, (i & 1) ? 0 : side - 1);
+            }
+            break;
+
+        case BLIT_OP_CPU_COPY:
+            for (i = 0; i < loops; i++) {
+                DoMemCopy((APTR)src, (APTR)dst, bytes / 128, kernel);
+            }
+            break;
+    }
+
+    /* The last blit may still be running */
+    WaitBlit();
+
+    E_Freq = read_benchmark_clock(&end);
+    Permit();
+
+    return EClock_Diff_in_ms(&start, &end, E_Freq);
+}
+
+/*
+ * Time every operation at every block size and find the crossover
+ */
+void run_blitter_benchmarks(void)
+{
+    UBYTE *planes;
+    ULONG op, s;
+
+    memset(&blit_results, 0, sizeof(blit_results));
+
+    if (!benchmark_timer_available()) return;
+
+    planes = AllocMem(BLIT_PLANE_SIZE * 2, MEMF_CHIP | MEMF_CLEAR);
+    if (!planes) return;
+
+    for (op = 0; op < BLIT_OPS; op++) {
+        for (s = 0; s < BLIT_SIZES; s++) {
+            ULONG side = get_blit_side(s);
+            ULONG loops = BLIT_MIN_LOOPS;
+            uint64_t elapsed, work;
+
+            for (;;) {
+                elapsed = time_blit_op(op, side, planes, planes + BLIT_PLANE_SIZE, loops);
+                if (elapsed >= BLIT_MIN_US || loops >= BLIT_MAX_LOOPS) break;
+                loops *= 2;
+            }
+
+            /* Same loop counter compensation as the memory copy benchmark */
+            if (op == BLIT_OP_CPU_COPY) {
+                ULONG overhead = measure_loop_overhead(loops * (side * side / 8 / 128));
+                elapsed = elapsed > overhead ? elapsed - overhead : 1;
+            }
+
+            work = (uint64_t)loops * (op == BLIT_OP_LINE ? side : side * side / 8);
+            if (elapsed > 0) {
+                blit_results.speed[op][s] = (ULONG)((work * 1000000ULL) / elapsed);
+            }
+
+            debug("  blit: %s %lux%lu: %lu loops, %lu us\n",
+                  (LONG)blit_op_names[op], side, side, loops, (ULONG)elapsed);
+        }
+    }
+
+    FreeMem(planes, BLIT_PLANE_SIZE * 2);
+
+    /* Setup cost favours the CPU at small sizes, DMA the blitter at large ones */
+    for (s = 0; s < BLIT_SIZES; s++) {
+        if (blit_results.speed[BLIT_OP_CPU_COPY][s] <= blit_results.speed[BLIT_OP_COPY][s]) break;
+        blit_results.cpu_faster_up_to = get_blit_side(s);
+    }
+
+    blit_results.valid = TRUE;
+}
+
+/*
+ * Draw blitter throughput table
+ */
+void draw_blitter_bench(void)
+{
+    static const WORD columns[BLIT_OPS] = { 120, 220, 320, 420 };
+    static const LocaleStringID headers[BLIT_OPS] = {
+        MSG_BLIT_COPY, MSG_BLIT_FILL, MSG_BLIT_LINE, MSG_BLIT_CPU_COPY
+    };
+    char buffer[64];
+    WORD y;
+    ULONG op, s;
+
+    /* Column headers */
+    y = 40;
+    draw_text(28, y, get_string(MSG_BLIT_SIZE), COLOR_TEXT);
+    for (op = 0; op < BLIT_OPS; op++) {
+        draw_text_right(columns[op], y, 88, get_string(headers[op]), COLOR_TEXT);
+    }
+
+    SetAPen(app->rp, COLOR_BUTTON_DARK);
+    Move(app->rp, 24, y + 4);
+    Draw(app->rp, 614, y + 4);
+
+    y = 56;
+    for (s = 0; s < BLIT_SIZES; s++) {
+        ULONG side = get_blit_side(s);
+
+        snprintf(buffer, sizeof(buffer), "%lux%lu", (unsigned long)side, (unsigned long)side);
+        draw_text(28, y, buffer, COLOR_TEXT);
+
+        for (op = 0; op < BLIT_OPS; op++) {
+            if (blit_results.valid) {
+                format_scaled(buffer, sizeof(buffer), blit_results.speed[op][s] / 10000, FALSE);
+            } else {
+                snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_NA));
+            }
+            draw_text_right(columns[op], y, 88, buffer, COLOR_HIGHLIGHT);
+        }
+        y += 10;
+    }
+
+    if (!blit_results.valid) return;
+
+    /* Crossover */
+    y += 10;
+    if (blit_results.cpu_faster_up_to == 0) {
+        snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_BLIT_WINS_ALL));
+    } else if (blit_results.cpu_faster_up_to == BLIT_MAX_SIDE) {
+        snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_BLIT_CPU_WINS_ALL));
+    } else {
+        snprintf(buffer, sizeof(buffer), "%s %lux%lu", get_string(MSG_BLIT_CPU_WINS_UP_TO),
+                 (unsigned long)blit_results.cpu_faster_up_to,
+                 (unsigned long)blit_results.cpu_faster_up_to);
+    }
+    draw_text(28, y, buffer, COLOR_HIGHLIGHT);
+
+    snprintf(buffer, sizeof(buffer), "%s, %s", hw_info.cpu_string,
+             get_agnus_string(hw_info.agnus_type));
+    draw_text(28, y + 10, buffer, COLOR_TEXT);
+}
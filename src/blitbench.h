@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Blitter throughput benchmark header
+ */
+
+#ifndef BLITBENCH_H
+#define BLITBENCH_H
+
+#include "xsysinfo.h"
+
+/* Square single-plane blocks from 32x32 (128 bytes) to 512x512 (32K) */
+#define BLIT_SIZES          5
+#define BLIT_MIN_SIDE       32
+#define BLIT_MAX_SIDE       512
+#define BLIT_PLANE_SIZE     (BLIT_MAX_SIDE * BLIT_MAX_SIDE / 8)
+
+#define BLIT_MIN_LOOPS      4
+#define BLIT_MAX_LOOPS      (1UL << 16)
+#define BLIT_MIN_US         20000   /* Minimum runtime per operation and size */
+
+/* Operations timed per size */
+#define BLIT_OP_COPY        0       /* BltBitMap A->D */
+#define BLIT_OP_FILL        1       /* BltClear */
+#define BLIT_OP_LINE        2       /* Draw, one diagonal per block */
+#define BLIT_OP_CPU_COPY    3       /* CPU copy CHIP to CHIP */
+#define BLIT_OPS            4
+
+/* Blitter benchmark results */
+typedef struct {
+    ULONG speed[BLIT_OPS][BLIT_SIZES];  /* Bytes/s, pixels/s for lines */
+    ULONG cpu_faster_up_to; /* Largest side the CPU copy still wins, 0 if never */
+    BOOL valid;
+} BlitBenchResults;
+
+extern BlitBenchResults blit_results;
+
+/* Function prototypes */
+void run_blitter_benchmarks(void);
+ULONG get_blit_side(ULONG size_index);
+void draw_blitter_bench(void);
+
+#endif /* BLITBENCH_H */
@@ -8,6 +8,7 @@
 #include <string.h>
 #include <stdio.h>
 
+#include <exec/memory.h>
 #include <libraries/configvars.h>
 #include <libraries/identify.h>
 
@@ -19,6 +20,8 @@
 
 #include "xsysinfo.h"
 #include "boards.h"
+#include "memory.h"
+#include "benchmark.h"
 #include "gui.h"
 #include "locale_str.h"
 #include "debug.h"
@@ -29,6 +32,10 @@
 /* Global board list */
 BoardList board_list;
 
+/* Board rows end above the selected board's results */
+#define BOARD_LIST_BOTTOM   150
+#define BOARD_LIST_ROWS     ((BOARD_LIST_BOTTOM - 56 + 9) / 10)
+
 /* External references */
 extern AppContext *app;
 extern struct Library *IdentifyBase;
@@ -92,6 +99,7 @@ void enumerate_boards(void)
         board->manufacturer_id = cd->cd_Rom.er_Manufacturer;
         board->product_id = cd->cd_Rom.er_Product;
         board->serial_number = cd->cd_Rom.er_SerialNumber;
+        board->is_memory = (cd->cd_Rom.er_Type & ERTF_MEMLIST) != 0;
 
         debug("  boards: Found board at $%08X\n", (ULONG)board->board_address);
 
@@ -131,6 +139,113 @@ void enumerate_boards(void)
     debug("  boards: Enumeration complete, found %d boards\n", (LONG)board_list.count);
 }
 
+/*
+ * Memory region that lies in a board's address space, -1 if none
+ */
+static LONG find_board_region(const BoardInfo *board)
+{
+    ULONG i;
+
+    for (i = 0; i < memory_regions.count; i++) {
+        ULONG start = (ULONG)memory_regions.regions[i].start_address;
+
+        if (start >= board->board_address &&
+            start - board->board_address < board->board_size) {
+            return (LONG)i;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Measure a memory board through its free memory, like the memory view
+ * Returns FALSE if the board's memory is not in the system free list
+ */
+static BOOL measure_board_memory(BoardInfo *board)
+{
+    LONG index = find_board_region(board);
+    MemoryRegion *region;
+    int i;
+
+    if (index < 0) return FALSE;
+
+    measure_memory_speed(index);
+    measure_memory_latency(index);
+
+    region = &memory_regions.regions[index];
+    board->read_bytes_sec = region->speed_bytes_sec;
+    board->write_bytes_sec = region->write_bytes_sec;
+
+    /* Largest working set measured, the one least helped by the caches */
+    for (i = MEM_LATENCY_SIZES - 1; i >= 0; i--) {
+        if (region->latency_ns_x100[i] > 0) {
+            board->latency_ns_x100 = region->latency_ns_x100[i];
+            break;
+        }
+    }
+
+    return TRUE;
+}
+
+/*
+ * Measure the start of a board's address space directly. Reading is
+ * timed with multitasking off. The latency chain and the write test
+ * overwrite the window, so the contents are saved and put back with
+ * interrupts off, the board's own interrupt handlers must not see the
+ * test patterns. Those runs are a single pass each, short enough that
+ * the EClock does not wrap unnoticed without its interrupt
+ */
+static void measure_board_window(BoardInfo *board)
+{
+    volatile ULONG *window = (volatile ULONG *)board->board_address;
+    ULONG size = board->board_size < BOARD_TEST_SIZE ? board->board_size : BOARD_TEST_SIZE;
+    APTR saved;
+
+    saved = AllocMem(size, MEMF_ANY);
+    if (!saved) return;
+
+    board->read_bytes_sec = measure_mem_read_speed(window, size, 16);
+
+    Disable();
+    CopyMem((APTR)window, saved, size);
+
+    board->write_bytes_sec = measure_mem_write_speed(window, size, 1);
+    board->latency_ns_x100 = measure_mem_latency(window, size, BOARD_LATENCY_ACCESSES);
+
+    CopyMem(saved, (APTR)window, size);
+    Enable();
+
+    FreeMem(saved, size);
+}
+
+/*
+ * Measure read/write bandwidth and latency of a board. Memory boards
+ * are tested through their free memory, any other board only if the
+ * user marked its address space as safe
+ */
+void measure_board_speed(ULONG index)
+{
+    BoardInfo *board;
+
+    if (index >= board_list.count) return;
+
+    board = &board_list.boards[index];
+    board->read_bytes_sec = 0;
+    board->write_bytes_sec = 0;
+    board->latency_ns_x100 = 0;
+
+    if (!benchmark_timer_available()) return;
+
+    if (!(board->is_memory && measure_board_memory(board)) && board->safe_io) {
+        measure_board_window(board);
+    }
+
+    board->speed_measured = TRUE;
+
+    debug("  boards: $%08lx read %lu write %lu B/s\n", board->board_address,
+          board->read_bytes_sec, board->write_bytes_sec);
+}
+
 /*
  * Draw text field at position
  */
@@ -140,6 +255,48 @@ static void draw_board_field(struct RastPort *rp, WORD x, WORD y, const char *te
     Text(rp, (CONST_STRPTR)text, strlen(text));
 }
 
+/*
+ * Draw the results of the selected board below the list
+ */
+static void draw_board_speed(void)
+{
+    struct RastPort *rp = app->rp;
+    BoardInfo *board;
+    char read_str[16], write_str[16], lat_str[16];
+    char buffer[96];
+    const char *note = NULL;
+
+    if (app->selected_board < 0 || app->selected_board >= (LONG)board_list.count) return;
+    board = &board_list.boards[app->selected_board];
+
+    SetAPen(rp, COLOR_BUTTON_DARK);
+    Move(rp, 20, BOARD_LIST_BOTTOM + 2);
+    Draw(rp, 628, BOARD_LIST_BOTTOM + 2);
+
+    if (board->speed_measured && board->read_bytes_sec > 0) {
+        format_scaled(read_str, sizeof(read_str), board->read_bytes_sec / 10000, FALSE);
+        format_scaled(write_str, sizeof(write_str), board->write_bytes_sec / 10000, FALSE);
+        format_scaled(lat_str, sizeof(lat_str), board->latency_ns_x100, FALSE);
+        snprintf(buffer, sizeof(buffer), "%s %s MB/S  %s %s MB/S  %s %s %s",
+                 get_string(MSG_MEM_READ), read_str, get_string(MSG_MEM_WRITE), write_str,
+                 get_string(MSG_BOARD_LATENCY), lat_str, get_string(MSG_NS));
+        draw_text(25, BOARD_LIST_BOTTOM + 14, buffer, COLOR_HIGHLIGHT);
+
+        if (board->board_type == BOARD_ZORRO_III &&
+            board->read_bytes_sec < BOARD_Z2_PEAK_BYTES_SEC) {
+            note = get_string(MSG_BOARD_Z2_SPEED);
+        }
+    } else if (board->speed_measured || (!board->is_memory && !board->safe_io)) {
+        note = get_string(MSG_BOARD_NOT_TESTABLE);
+    } else {
+        note = get_string(MSG_BOARD_NOT_MEASURED);
+    }
+
+    if (note) {
+        draw_text(25, BOARD_LIST_BOTTOM + 24, note, COLOR_TEXT);
+    }
+}
+
 /*
  * Draw boards view
  */
@@ -174,12 +331,12 @@ void draw_boards_view(void)
     /* Draw board entries */
     y = 56;
     for (i = app->board_scroll;
-         i < board_list.count && y < app->screen_height - 50;
+         i < board_list.count && y < BOARD_LIST_BOTTOM;
          i++) {
 
         BoardInfo *board = &board_list.boards[i];
 
-        SetAPen(rp, COLOR_HIGHLIGHT);
+        SetAPen(rp, (LONG)i == app->selected_board ? COLOR_HIGHLIGHT : COLOR_TEXT);
         SetBPen(rp, COLOR_BACKGROUND);
 
         /* Address */
@@ -189,8 +346,10 @@ void draw_boards_view(void)
         /* Size */
         draw_board_field(rp, 136, y, board->size_string);
 
-        /* Type */
-        draw_board_field(rp, 214, y, get_board_type_string(board->board_type));
+        /* Type, marked if the user cleared it for testing */
+        snprintf(buffer, sizeof(buffer), "%s%s", get_board_type_string(board->board_type),
+                 board->safe_io ? " *" : "");
+        draw_board_field(rp, 214, y, buffer);
 
         /* Product */
         snprintf(buffer, sizeof(buffer), "%.16s", board->product_name);
@@ -214,9 +373,19 @@ void draw_boards_view(void)
         Text(rp, (CONST_STRPTR)get_string(MSG_BOARDS_NO_BOARDS_FOUND), strlen(get_string(MSG_BOARDS_NO_BOARDS_FOUND)));
     }
 
-    /* Draw exit button */
+    draw_board_speed();
+
+    /* Draw buttons */
     Button *btn = find_button(BTN_BOARD_EXIT);
     if (btn) draw_button(btn);
+    btn = find_button(BTN_BOARD_PREV);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_BOARD_NEXT);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_BOARD_SPEED);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_BOARD_SAFE);
+    if (btn) draw_button(btn);
 }
 
 /*
@@ -224,8 +393,36 @@ void draw_boards_view(void)
  */
 void boards_view_update_buttons(void)
 {
+    BOOL selected = app->selected_board >= 0 &&
+                    app->selected_board < (LONG)board_list.count;
+    BOOL safe = selected && board_list.boards[app->selected_board].safe_io;
+
     add_button(20, 188, 60, 12,
                get_string(MSG_BTN_EXIT), BTN_BOARD_EXIT, TRUE);
+    add_button(84, 188, 60, 12,
+               get_string(MSG_BTN_PREV), BTN_BOARD_PREV, app->selected_board > 0);
+    add_button(148, 188, 60, 12,
+               get_string(MSG_BTN_NEXT), BTN_BOARD_NEXT,
+               selected && app->selected_board < (LONG)board_list.count - 1);
+    add_button(212, 188, 60, 12,
+               get_string(MSG_BTN_SPEED), BTN_BOARD_SPEED, selected);
+    add_button(276, 188, 60, 12,
+               safe ? get_string(MSG_BTN_UNSAFE) : get_string(MSG_BTN_SAFE),
+               BTN_BOARD_SAFE, selected);
+}
+
+/*
+ * Select a board and scroll it into the list
+ */
+static void select_board(LONG index)
+{
+    app->selected_board = index;
+    if (index < app->board_scroll) {
+        app->board_scroll = index;
+    } else if (index >= app->board_scroll + BOARD_LIST_ROWS) {
+        app->board_scroll = index - BOARD_LIST_ROWS + 1;
+    }
+    redraw_current_view();
 }
 
 /*
@@ -233,7 +430,47 @@ void boards_view_update_buttons(void)
  */
 void boards_view_handle_button(ButtonID id)
 {
-    if (id == BTN_BOARD_EXIT) {
-        switch_to_view(VIEW_MAIN);
+    BoardInfo *board = NULL;
+
+    if (app->selected_board >= 0 && app->selected_board < (LONG)board_list.count) {
+        board = &board_list.boards[app->selected_board];
+    }
+
+    switch (id) {
+        case BTN_BOARD_EXIT:
+            switch_to_view(VIEW_MAIN);
+            break;
+
+        case BTN_BOARD_PREV:
+            if (app->selected_board > 0) {
+                select_board(app->selected_board - 1);
+            }
+            break;
+
+        case BTN_BOARD_NEXT:
+            if (board && app->selected_board < (LONG)board_list.count - 1) {
+                select_board(app->selected_board + 1);
+            }
+            break;
+
+        case BTN_BOARD_SPEED:
+            /* The background suite would compete for the bus */
+            if (benchmark_task_running()) break;
+            if (board) {
+                show_status_overlay(get_string(MSG_MEASURING_SPEED));
+                measure_board_speed(app->selected_board);
+                hide_status_overlay();
+            }
+            break;
+
+        case BTN_BOARD_SAFE:
+            if (board) {
+                board->safe_io = !board->safe_io;
+                redraw_current_view();
+            }
+            break;
+
+        default:
+            break;
     }
 }
@@ -13,6 +13,13 @@
 /* Maximum boards we'll track */
 #define MAX_BOARDS  32
 
+/* Bandwidth test window at the start of a board's address space */
+#define BOARD_TEST_SIZE         (64 * 1024)
+#define BOARD_LATENCY_ACCESSES  16384       /* Chain links timed with interrupts off */
+
+/* Best a Zorro II slot delivers, a Zorro III board below it is throttled */
+#define BOARD_Z2_PEAK_BYTES_SEC 3580000UL
+
 /* Board type */
 typedef enum {
     BOARD_ZORRO_II,
@@ -31,6 +38,12 @@ typedef struct {
     char product_name[64];
     char manufacturer_name[64];
     char size_string[16];       /* Human-readable size */
+    BOOL is_memory;             /* Adds its space to the free memory pool */
+    BOOL safe_io;               /* User marked the address space safe to test */
+    BOOL speed_measured;
+    ULONG read_bytes_sec;       /* 0 = not measured or not testable */
+    ULONG write_bytes_sec;
+    ULONG latency_ns_x100;      /* Dependent-load latency * 100 */
 } BoardInfo;
 
 /* Board list */
@@ -44,6 +57,7 @@ extern BoardList board_list;
 
 /* Function prototypes */
 void enumerate_boards(void);
+void measure_board_speed(ULONG index);
 
 /* Helper functions */
 const char *get_board_type_string(BoardType type);
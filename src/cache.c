@@ -193,6 +193,66 @@ void toggle_super_scalar(void)
     }
 }
 
+/*
+ * Read current cache state (any pointer may be NULL)
+ */
+void read_cache_state(BOOL *icache, BOOL *dcache,
+                      BOOL *iburst, BOOL *dburst, BOOL *copyback)
+{
+    refresh_cache_status();
+
+    if (icache) *icache = hw_info.icache_enabled;
+    if (dcache) *dcache = hw_info.dcache_enabled;
+    if (iburst) *iburst = hw_info.iburst_enabled;
+    if (dburst) *dburst = hw_info.dburst_enabled;
+    if (copyback) *copyback = hw_info.copyback_enabled;
+}
+
+/*
+ * Read all cache settings
+ */
+void get_cache_config(CacheConfig *config)
+{
+    read_cache_state(&config->icache, &config->dcache, &config->iburst,
+                     &config->dburst, &config->copyback);
+    config->super_scalar = hw_info.super_scalar_enabled;
+}
+
+/*
+ * Apply all cache settings by toggling the ones that differ.
+ * The state is read back after each toggle, since on the 68040/060
+ * one toggle switches a whole group of flags
+ */
+void set_cache_config(const CacheConfig *config)
+{
+    CacheConfig current;
+
+    get_cache_config(&current);
+    if (cpu_has_icache() && current.icache != config->icache) {
+        toggle_icache();
+        get_cache_config(&current);
+    }
+    if (cpu_has_dcache() && current.dcache != config->dcache) {
+        toggle_dcache();
+        get_cache_config(&current);
+    }
+    if (cpu_has_iburst() && current.iburst != config->iburst) {
+        toggle_iburst();
+        get_cache_config(&current);
+    }
+    if (cpu_has_dburst() && current.dburst != config->dburst) {
+        toggle_dburst();
+        get_cache_config(&current);
+    }
+    if (cpu_has_copyback() && current.copyback != config->copyback) {
+        toggle_copyback();
+        get_cache_config(&current);
+    }
+    if (cpu_has_super_scalar() && current.super_scalar != config->super_scalar) {
+        toggle_super_scalar();
+    }
+}
+
 /*
  * Check if CPU has instruction cache
  */
@@ -15,6 +15,16 @@
 #define CACRF_EBC060	(1 << 29)
 #define CACRF_ESB060	(1 << 23)
 
+/* Cache settings that can be switched */
+typedef struct {
+    BOOL icache;
+    BOOL dcache;
+    BOOL iburst;
+    BOOL dburst;
+    BOOL copyback;
+    BOOL super_scalar;
+} CacheConfig;
+
 /* CACR bit format conversion between 68030 and 68040/060 */
 ULONG convert68030to68040(ULONG input);
 ULONG convert68040to68030(ULONG input);
@@ -32,6 +42,10 @@ void toggle_super_scalar(void);
 void read_cache_state(BOOL *icache, BOOL *dcache,
                       BOOL *iburst, BOOL *dburst, BOOL *copyback);
 
+/* Read/apply all cache settings at once (unavailable ones are ignored) */
+void get_cache_config(CacheConfig *config);
+void set_cache_config(const CacheConfig *config);
+
 /* Check what cache features are available on this CPU */
 BOOL cpu_has_icache(void);
 BOOL cpu_has_dcache(void);
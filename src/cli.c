@@ -0,0 +1,338 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Headless benchmark runs for scripts
+ *
+ * CPU, FPU, MEM, DRIVE=<dev> and SCSI on the command line run only
+ * those tests and print one key=value line per result, so a nightly
+ * job can collect them. Keys and units do not change between
+ * versions: speeds are bytes/sec, ratings with _x100 are scaled by 100.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <dos/dos.h>
+
+#include <proto/exec.h>
+#include <proto/dos.h>
+
+#include "xsysinfo.h"
+#include "cli.h"
+#include "hardware.h"
+#include "benchmark.h"
+#include "drives.h"
+#include "scsi.h"
+#include "debug.h"
+
+/* External references */
+extern HardwareInfo hw_info;
+extern BenchmarkResults bench_results;
+extern DriveList drive_list;
+
+/* Options and return code of the current run */
+static const CliOptions *cli_options;
+static int cli_result;
+
+/*
+ * Print a result line unless QUIET is set
+ */
+static void put_string(const char *key, const char *value)
+{
+    if (!cli_options->quiet) {
+        printf("%s=%s\n", key, value);
+    }
+}
+
+static void put_value(const char *key, ULONG value)
+{
+    if (!cli_options->quiet) {
+        printf("%s=%lu\n", key, (unsigned long)value);
+    }
+}
+
+/*
+ * Fail the run with RETURN_WARN if value is below a set threshold
+ */
+static void check_threshold(const char *key, ULONG value, ULONG min)
+{
+    if (min == 0 || value >= min) return;
+
+    put_string("below", key);
+    if (cli_result < RETURN_WARN) cli_result = RETURN_WARN;
+}
+
+/*
+ * A selected test could not be run
+ */
+static void test_failed(const char *test)
+{
+    put_string("error", test);
+    cli_result = RETURN_ERROR;
+}
+
+/*
+ * Ctrl-C pressed since the last check?
+ */
+static BOOL cli_break(void)
+{
+    if (SetSignal(0, SIGBREAKF_CTRL_C) & SIGBREAKF_CTRL_C) {
+        put_string("error", "break");
+        cli_result = RETURN_ERROR;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/*
+ * Compare a DOS device name case-insensitively, "DH0" matches "DH0:"
+ */
+static BOOL device_name_matches(const char *name, const char *wanted)
+{
+    while (*name && *wanted) {
+        char a = *name++, b = *wanted++;
+        if (a >= 'a' && a <= 'z') a -= 0x20;
+        if (b >= 'a' && b <= 'z') b -= 0x20;
+        if (a != b) return FALSE;
+    }
+
+    return (*name == *wanted) ||
+           (*name == ':' && name[1] == '\0' && *wanted == '\0') ||
+           (*wanted == ':' && wanted[1] == '\0' && *name == '\0');
+}
+
+static void run_cpu_test(void)
+{
+    char buffer[16];
+
+    bench_results.dhrystones = run_dhrystone_build(DHRY_BUILD_68000, &bench_results.dhry_stats);
+    if (bench_results.dhrystones == 0) {
+        test_failed("cpu");
+        return;
+    }
+    bench_results.mips = calculate_mips(bench_results.dhrystones);
+
+    bench_results.dhry_build = select_dhry_build();
+    if (bench_results.dhry_build != DHRY_BUILD_68000) {
+        bench_results.dhrystones_native = run_dhrystone(NULL);
+    } else {
+        bench_results.dhrystones_native = bench_results.dhrystones;
+    }
+    bench_results.mips_native = calculate_mips(bench_results.dhrystones_native);
+    hw_info.cpu_mhz = get_mhz_cpu();
+
+    put_string("cpu", hw_info.cpu_string);
+    put_value("cpu_mhz_x100", hw_info.cpu_mhz);
+    put_value("dhrystones", bench_results.dhrystones);
+    if (bench_results.dhry_stats.runs > 1) {
+        put_value("dhrystones_runs", bench_results.dhry_stats.runs);
+        put_value("dhrystones_min", bench_results.dhry_stats.min);
+        put_value("dhrystones_max", bench_results.dhry_stats.max);
+        put_value("dhrystones_stddev", bench_results.dhry_stats.stddev);
+        put_value("dhrystones_outliers", bench_results.dhry_stats.outliers);
+    }
+    put_value("mips_x100", bench_results.mips);
+    snprintf(buffer, sizeof(buffer), "%s", get_dhry_build_name(bench_results.dhry_build));
+    put_string("dhry_build", buffer);
+    put_value("dhrystones_native", bench_results.dhrystones_native);
+    put_value("mips_native_x100", bench_results.mips_native);
+
+    check_threshold("dhrystones", bench_results.dhrystones, cli_options->min_dhrystones);
+}
+
+static void run_fpu_test(void)
+{
+    put_string("fpu", hw_info.fpu_string);
+
+    if (hw_info.fpu_type == FPU_NONE || !hw_info.fpu_enabled) {
+        put_value("mflops_x100", 0);
+        check_threshold("mflops", 0, cli_options->min_mflops);
+        return;
+    }
+
+    bench_results.mflops = run_mflops_benchmark(&bench_results.mflops_stats);
+    if (bench_results.mflops == 0) {
+        test_failed("fpu");
+        return;
+    }
+    hw_info.fpu_mhz = get_mhz_fpu();
+
+    put_value("fpu_mhz_x100", hw_info.fpu_mhz);
+    put_value("mflops_x100", bench_results.mflops);
+    if (bench_results.mflops_stats.runs > 1) {
+        put_value("mflops_runs", bench_results.mflops_stats.runs);
+        put_value("mflops_min_x100", bench_results.mflops_stats.min);
+        put_value("mflops_max_x100", bench_results.mflops_stats.max);
+        put_value("mflops_stddev_x100", bench_results.mflops_stats.stddev);
+        put_value("mflops_outliers", bench_results.mflops_stats.outliers);
+    }
+
+    check_threshold("mflops", bench_results.mflops, cli_options->min_mflops);
+}
+
+static void run_mem_test(void)
+{
+    run_memory_speed_tests();
+    if (bench_results.chip_speed == 0) {
+        test_failed("mem");
+        return;
+    }
+
+    put_value("chip_read", bench_results.chip_speed);
+    put_value("chip_write", bench_results.chip_write_speed);
+    put_value("chip_copy", bench_results.chip_copy_speed);
+    put_value("fast_read", bench_results.fast_speed);
+    put_value("fast_write", bench_results.fast_write_speed);
+    put_value("fast_copy", bench_results.fast_copy_speed);
+    put_value("rom_read", bench_results.rom_speed);
+
+    check_threshold("chip_read", bench_results.chip_speed, cli_options->min_chip);
+    check_threshold("fast_read", bench_results.fast_speed, cli_options->min_fast);
+}
+
+static void run_drive_test(void)
+{
+    ULONG i;
+
+    for (i = 0; i < drive_list.count; i++) {
+        if (device_name_matches(drive_list.drives[i].device_name, cli_options->drive)) {
+            break;
+        }
+    }
+    if (i == drive_list.count || !check_disk_present(i)) {
+        test_failed("drive");
+        return;
+    }
+
+    put_string("drive", drive_list.drives[i].device_name);
+    put_value("drive_read", measure_drive_speed(i));
+    if (drive_list.drives[i].speed_bytes_sec == 0) {
+        test_failed("drive");
+        return;
+    }
+
+    check_threshold("drive_read", drive_list.drives[i].speed_bytes_sec,
+                    cli_options->min_drive);
+}
+
+/*
+ * Scan the SCSI bus behind one drive
+ */
+static void scan_drive_bus(const DriveInfo *drive)
+{
+    char key[24];
+    char value[48];
+    ULONG i;
+
+    scan_scsi_devices(drive->handler_name, drive->unit_number, TRUE);
+
+    put_string("scsi_controller", drive->handler_name);
+    put_value("scsi_devices", scsi_device_list.count);
+    for (i = 0; i < scsi_device_list.count; i++) {
+        const ScsiDeviceInfo *dev = &scsi_device_list.devices[i];
+        snprintf(key, sizeof(key), "scsi_%u_%u", (unsigned)dev->target_id, (unsigned)dev->lun);
+        snprintf(value, sizeof(value), "%s %s %s", get_scsi_type_string(dev->device_type),
+                 dev->manufacturer, dev->model);
+        put_string(key, value);
+
+        /* Drive caches, the usual suspect for a slow disk */
+        if (dev->cache_flags & SCSI_CACHE_KNOWN) {
+            snprintf(key, sizeof(key), "scsi_%u_%u_cache", (unsigned)dev->target_id, (unsigned)dev->lun);
+            snprintf(value, sizeof(value), "read=%s ahead=%s write=%s",
+                     (dev->cache_flags & SCSI_CACHE_READ) ? "on" : "off",
+                     (dev->cache_flags & SCSI_CACHE_READ_AHEAD) ? "on" : "off",
+                     (dev->cache_flags & SCSI_CACHE_WRITE) ? "on" : "off");
+            put_string(key, value);
+        }
+    }
+}
+
+/*
+ * SCSI bus of DRIVE=, or of every controller with a drive that
+ * takes direct SCSI commands
+ */
+static void run_scsi_test(void)
+{
+    ULONG scanned = 0;
+    ULONG i, j;
+
+    for (i = 0; i < drive_list.count; i++) {
+        const DriveInfo *drive = &drive_list.drives[i];
+        BOOL seen = FALSE;
+
+        if (!drive->scsi_supported) continue;
+        if (cli_options->drive[0]) {
+            if (!device_name_matches(drive->device_name, cli_options->drive)) continue;
+        } else {
+            for (j = 0; j < i; j++) {
+                if (drive_list.drives[j].scsi_supported &&
+                    strcmp(drive_list.drives[j].handler_name, drive->handler_name) == 0) {
+                    seen = TRUE;
+                    break;
+                }
+            }
+            if (seen) continue;
+        }
+
+        scan_drive_bus(drive);
+        scanned++;
+        if (cli_break()) return;
+    }
+
+    if (scanned == 0) {
+        test_failed("scsi");
+    }
+}
+
+/*
+ * Run the tests in a fixed order, stopping on Ctrl-C
+ */
+static void run_selected_tests(ULONG tests)
+{
+    if (!benchmark_timer_available() &&
+        (tests & (CLI_TEST_CPU | CLI_TEST_FPU | CLI_TEST_MEM | CLI_TEST_DRIVE))) {
+        test_failed("timer");
+        return;
+    }
+
+    if (tests & CLI_TEST_CPU) {
+        run_cpu_test();
+        if (cli_break()) return;
+    }
+    if (tests & CLI_TEST_FPU) {
+        run_fpu_test();
+        if (cli_break()) return;
+    }
+    if (tests & CLI_TEST_MEM) {
+        run_mem_test();
+        if (cli_break()) return;
+    }
+    if (tests & (CLI_TEST_DRIVE | CLI_TEST_SCSI)) {
+        ensure_enumerated(ENUM_DRIVES);
+    }
+    if (tests & CLI_TEST_DRIVE) {
+        run_drive_test();
+        if (cli_break()) return;
+    }
+    if (tests & CLI_TEST_SCSI) {
+        run_scsi_test();
+    }
+}
+
+/*
+ * Run the selected tests and print key=value lines
+ */
+int run_cli_tests(const CliOptions *options)
+{
+    cli_options = options;
+    cli_result = RETURN_OK;
+    memset(&bench_results, 0, sizeof(bench_results));
+
+    put_string("version", XSYSINFO_VERSION);
+    run_selected_tests(options->tests);
+    put_value("result", (ULONG)cli_result);
+
+    debug("  cli: finished with return code %ld\n", (LONG)cli_result);
+    return cli_result;
+}
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Headless benchmark runs for scripts header
+ */
+
+#ifndef CLI_H
+#define CLI_H
+
+#include "xsysinfo.h"
+
+/* Tests selected on the command line */
+#define CLI_TEST_CPU        0x01
+#define CLI_TEST_FPU        0x02
+#define CLI_TEST_MEM        0x04
+#define CLI_TEST_DRIVE      0x08
+#define CLI_TEST_SCSI       0x10
+
+/* Command line options of a headless run */
+typedef struct {
+    ULONG tests;            /* CLI_TEST_*, 0 = normal start */
+    char drive[32];         /* DRIVE=, e.g. "DH0:" (empty = all SCSI drives) */
+    BOOL quiet;             /* Only set the return code */
+    ULONG min_dhrystones;   /* Thresholds, 0 = not checked */
+    ULONG min_mflops;       /* MFLOPS * 100 */
+    ULONG min_chip;         /* CHIP read, bytes/sec */
+    ULONG min_fast;         /* FAST read, bytes/sec */
+    ULONG min_drive;        /* Drive read, bytes/sec */
+} CliOptions;
+
+/* Run the selected tests and print key=value lines.
+ * Returns RETURN_OK, RETURN_WARN if a threshold was missed, or
+ * RETURN_ERROR if a selected test could not be run */
+int run_cli_tests(const CliOptions *options);
+
+#endif /* CLI_H */
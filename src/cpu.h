@@ -33,6 +33,18 @@
 #define ASM_FPU_68080 5
 #define ASM_FPU_UNKNOWN 6
 
+#define ASM_COPY_BYTE 0
+#define ASM_COPY_LONG 1
+#define ASM_COPY_MOVE16 2
+
+#define ASM_FPK_FADD 0
+#define ASM_FPK_FMUL 1
+#define ASM_FPK_FDIV 2
+#define ASM_FPK_FSQRT 3
+#define ASM_FPK_FSIN 4
+#define ASM_FPK_FLOGN 5
+#define ASM_FPK_FETOX 6
+
 
 ULONG GetCPUReg(void);
 ULONG SetCPUReg( ULONG value __asm("d0"));
@@ -44,5 +56,9 @@ ULONG GetMMU( ULONG cpuType __asm("d0"));
 UBYTE GetRamseyRev(void);
 UBYTE GetRamseyCtrl(void);
 double DoFlops( ULONG loops __asm("d0"), ULONG fpuType __asm("d1"));
+void DoMemWrite( APTR dst __asm("a0"), ULONG blocks __asm("d0"));
+void DoMemCopy( APTR src __asm("a0"), APTR dst __asm("a1"), ULONG blocks __asm("d0"), ULONG kernel __asm("d1"));
+void DoFpuKernel( ULONG loops __asm("d0"), ULONG kernel __asm("d1"));
+void DoDaxpy( APTR x __asm("a0"), APTR y __asm("a1"), ULONG n __asm("d0"), ULONG loops __asm("d1"));
 
 #endif /* CPU_H */
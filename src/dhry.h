@@ -1,6 +1,37 @@
 #ifndef DHRY_H
 #define DHRY_H
 
+/*
+ * xSysInfo builds Dhrystone once per CPU family (see the Makefile).
+ * Each extra build sets DHRY_PREFIX so all of them can be linked
+ * into the same binary, e.g. Dhry_Run becomes Dhry060_Dhry_Run
+ */
+#ifdef DHRY_PREFIX
+#define DHRY_CONCAT2(a, b)      a##b
+#define DHRY_CONCAT(a, b)       DHRY_CONCAT2(a, b)
+#define Ptr_Glob                DHRY_CONCAT(DHRY_PREFIX, Ptr_Glob)
+#define Next_Ptr_Glob           DHRY_CONCAT(DHRY_PREFIX, Next_Ptr_Glob)
+#define Int_Glob                DHRY_CONCAT(DHRY_PREFIX, Int_Glob)
+#define Bool_Glob               DHRY_CONCAT(DHRY_PREFIX, Bool_Glob)
+#define Ch_1_Glob               DHRY_CONCAT(DHRY_PREFIX, Ch_1_Glob)
+#define Ch_2_Glob               DHRY_CONCAT(DHRY_PREFIX, Ch_2_Glob)
+#define Arr_1_Glob              DHRY_CONCAT(DHRY_PREFIX, Arr_1_Glob)
+#define Arr_2_Glob              DHRY_CONCAT(DHRY_PREFIX, Arr_2_Glob)
+#define Proc_1                  DHRY_CONCAT(DHRY_PREFIX, Proc_1)
+#define Proc_2                  DHRY_CONCAT(DHRY_PREFIX, Proc_2)
+#define Proc_3                  DHRY_CONCAT(DHRY_PREFIX, Proc_3)
+#define Proc_4                  DHRY_CONCAT(DHRY_PREFIX, Proc_4)
+#define Proc_5                  DHRY_CONCAT(DHRY_PREFIX, Proc_5)
+#define Proc_6                  DHRY_CONCAT(DHRY_PREFIX, Proc_6)
+#define Proc_7                  DHRY_CONCAT(DHRY_PREFIX, Proc_7)
+#define Proc_8                  DHRY_CONCAT(DHRY_PREFIX, Proc_8)
+#define Func_1                  DHRY_CONCAT(DHRY_PREFIX, Func_1)
+#define Func_2                  DHRY_CONCAT(DHRY_PREFIX, Func_2)
+#define Func_3                  DHRY_CONCAT(DHRY_PREFIX, Func_3)
+#define Dhry_Initialize         DHRY_CONCAT(DHRY_PREFIX, Dhry_Initialize)
+#define Dhry_Run                DHRY_CONCAT(DHRY_PREFIX, Dhry_Run)
+#endif
+
 /*
  ****************************************************************************
  *
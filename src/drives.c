@@ -9,9 +9,14 @@
 #include <stdio.h>
 #include <stdint.h>
 
+#include <exec/execbase.h>
+#include <exec/memory.h>
 #include <dos/dos.h>
 #include <dos/dosextens.h>
 #include <dos/filehandler.h>
+#ifndef __KICK13__
+#include <dos/exall.h>
+#endif
 #include <devices/timer.h>
 #include <devices/trackdisk.h>
 
@@ -24,8 +29,11 @@
 #include "xsysinfo.h"
 #include "drives.h"
 #include "scsi.h"
+#include "inventory.h"
+#include "history.h"
 #include "gui.h"
 #include "benchmark.h"
+#include "pool.h"
 #include "locale_str.h"
 #include "debug.h"
 #include "hardware.h"
@@ -34,11 +42,18 @@
 /* Global drive list */
 DriveList drive_list;
 
+/* Requests kept in flight for each queue_bytes_sec entry */
+const ULONG drive_queue_depths[DRIVE_QUEUE_DEPTHS] = { 2, 4, 8 };
+
+/* Read size for each random_* entry */
+const ULONG drive_random_sizes[DRIVE_RANDOM_SIZES] = { 512, 4096 };
+
 /* External references */
 extern AppContext *app;
 extern Button buttons[];
 extern int num_buttons;
 extern struct DosLibrary *DOSBase;
+extern struct ExecBase *SysBase;
 
 /* DOS type identifiers */
 /* ID_DOS_DISK and ID_FFS_DISK are defined in dos/dos.h */
@@ -107,6 +122,19 @@ const char *get_disk_state_string(DiskState state)
     }
 }
 
+/*
+ * Get drive buffer memory type string
+ */
+const char *get_drive_buffer_type_string(ULONG type)
+{
+    switch (type) {
+        case DRIVE_BUF_CHIP:    return get_string(MSG_CHIP_RAM);
+        case DRIVE_BUF_FAST24:  return get_string(MSG_FAST24_RAM);
+        case DRIVE_BUF_FAST32:  return get_string(MSG_FAST32_RAM);
+        default:                return get_string(MSG_UNKNOWN);
+    }
+}
+
 /*
  * Get block size to display (adjusts for OFS overhead)
  */
@@ -206,22 +234,30 @@ static struct DosList *MyNextDosEntry(struct DosList *list, ULONG flags)
 static void scan_dos_list(void)
 {
     struct DosList *dol;
+    DriveInfo *drives;
     char buffer[32];
+    char name[64];
 
     debug("  drives: Locking DosList...\n");
     dol = MyLockDosList(LDF_DEVICES | LDF_READ);
     debug("  drives: DosList locked\n");
 
     while ((dol = MyNextDosEntry(dol, LDF_DEVICES)) != NULL) {
-        if (drive_list.count >= MAX_DRIVES) break;
-        buffer[0] = '\0';
+        drives = pool_grow(drive_list.drives, &drive_list.capacity,
+                           drive_list.count + 1, sizeof(DriveInfo));
+        if (!drives) break;
+        drive_list.drives = drives;
+
         DriveInfo *drive = &drive_list.drives[drive_list.count];
-        drive->is_valid = FALSE;
+        memset(drive, 0, sizeof(DriveInfo));
+        drive->volume_name = "";
+        drive->handler_name = "";
 
         /* Get device name */
+        buffer[0] = '\0';
         bstr_to_cstr(dol->dol_Name, buffer, sizeof(buffer) - 2);
-        snprintf(drive->device_name, sizeof(drive->device_name), "%s:",
-                     buffer);
+        snprintf(name, sizeof(name), "%s:", buffer);
+        drive->device_name = pool_string(name);
 
         debug("  drives: Found device '%s'\n", (LONG)drive->device_name);
 
@@ -235,8 +271,9 @@ static void scan_dos_list(void)
                 struct DosEnvec *de;
 
                 /* Get handler name */
-                bstr_to_cstr(fssm->fssm_Device, drive->handler_name,
-                             sizeof(drive->handler_name));
+                name[0] = '\0';
+                bstr_to_cstr(fssm->fssm_Device, name, sizeof(name));
+                drive->handler_name = pool_string(name);
                 drive->unit_number = fssm->fssm_Unit;
 
                 de = BADDR(fssm->fssm_Environ);
@@ -249,6 +286,12 @@ static void scan_dos_list(void)
                     drive->bytes_per_block = de->de_SizeBlock << 2;
                     drive->num_buffers = de->de_NumBuffers;
 
+                    /* Mountlist transfer limits, defaults per dos/filehandler.h */
+                    drive->max_transfer = (de->de_TableSize >= DE_MAXTRANSFER) ?
+                                          de->de_MaxTransfer : 0x7FFFFFFF;
+                    drive->dma_mask = (de->de_TableSize >= DE_MASK) ?
+                                      de->de_Mask : 0x00FFFFFE;
+
                     /* Get DOS type if available (de_DosType is at index 16) */
                     if (de->de_TableSize >= 16) {
                         drive->dos_type = de->de_DosType;
@@ -283,13 +326,18 @@ static void scan_dos_list(void)
  */
 static void match_volumes_to_drives(void)
 {
-    struct MsgPort *dev_tasks[MAX_DRIVES];
+    struct MsgPort **dev_tasks;
     struct DosList *dev_dol;
     struct DosList *dol;
+    char vol_name[64];
     ULONG i;
 
+    if (drive_list.count == 0) return;
+
+    dev_tasks = pool_alloc(drive_list.count * sizeof(struct MsgPort *));
+    if (!dev_tasks) return;
+
     /* First, collect task pointers for each device */
-    memset(dev_tasks, 0, sizeof(dev_tasks));
     dev_dol = MyLockDosList(LDF_DEVICES | LDF_READ);
     while ((dev_dol = MyNextDosEntry(dev_dol, LDF_DEVICES)) != NULL) {
         char buffer[32];
@@ -319,8 +367,9 @@ static void match_volumes_to_drives(void)
         /* Find device with matching task */
         for (i = 0; i < drive_list.count; i++) {
             if (dev_tasks[i] == vol_task && !drive_list.drives[i].volume_name[0]) {
-                bstr_to_cstr(dol->dol_Name, drive_list.drives[i].volume_name,
-                             sizeof(drive_list.drives[i].volume_name));
+                vol_name[0] = '\0';
+                bstr_to_cstr(dol->dol_Name, vol_name, sizeof(vol_name));
+                drive_list.drives[i].volume_name = pool_string(vol_name);
                 drive_list.drives[i].disk_state = DISK_OK;
                 debug("  drives: Matched volume '%s' to device '%s'\n",
                       (LONG)drive_list.drives[i].volume_name,
@@ -330,6 +379,8 @@ static void match_volumes_to_drives(void)
         }
     }
     MyUnLockDosList(LDF_VOLUMES | LDF_READ);
+
+    pool_free(dev_tasks);
 }
 
 /*
@@ -338,6 +389,7 @@ static void match_volumes_to_drives(void)
 static void query_drive_details(void)
 {
     struct InfoData *info;
+    char vol_name[64];
     ULONG i;
 
     info = AllocMem(sizeof(struct InfoData), MEMF_PUBLIC | MEMF_CLEAR);
@@ -396,8 +448,9 @@ static void query_drive_details(void)
             if (info->id_VolumeNode && !drive->volume_name[0]) {
                 struct DosList *vol = BADDR(info->id_VolumeNode);
                 if (vol) {
-                    bstr_to_cstr(vol->dol_Name, drive->volume_name,
-                                 sizeof(drive->volume_name));
+                    vol_name[0] = '\0';
+                    bstr_to_cstr(vol->dol_Name, vol_name, sizeof(vol_name));
+                    drive->volume_name = pool_string(vol_name);
                 }
             }
 
@@ -424,8 +477,13 @@ static void check_scsi_support_all(void)
 
         if (!drive->handler_name[0]) continue;
 
-        drive->scsi_supported = check_scsi_direct_support(
-            drive->handler_name, drive->unit_number);
+        if (!inventory_get_scsi_support(drive->handler_name, drive->unit_number,
+                                        &drive->scsi_supported)) {
+            drive->scsi_supported = check_scsi_direct_support(
+                drive->handler_name, drive->unit_number);
+            inventory_set_scsi_support(drive->handler_name, drive->unit_number,
+                                       drive->scsi_supported);
+        }
         debug("  drives: SCSI support for %s: %s\n",
               (LONG)drive->handler_name,
               (LONG)(drive->scsi_supported ? get_string(MSG_YES) : get_string(MSG_NO)));
@@ -439,7 +497,7 @@ void enumerate_drives(void)
 {
     debug("  drives: Starting enumeration...\n");
 
-    memset(&drive_list, 0, sizeof(drive_list));
+    drive_list.count = 0;
     debug("  drives: Scan DosList...\n");
 
     /* First pass: Scan DosList for devices */
@@ -454,12 +512,22 @@ void enumerate_drives(void)
     query_drive_details();
 
     debug("  drives: Check SCSI-support...\n");
-    /* Fourth pass: Check SCSI support */
+    /* Fourth pass: Check SCSI support (cached across runs) */
     check_scsi_support_all();
+    inventory_save();
 
     debug("  drives: Enumeration complete, found %ld drives\n", (LONG)drive_list.count);
 }
 
+/*
+ * Enumerate all drives, ignoring cached probe results
+ */
+void reprobe_drives(void)
+{
+    inventory_invalidate();
+    enumerate_drives();
+}
+
 /*
  * Refresh drive info for a specific drive
  */
@@ -542,7 +610,7 @@ BOOL check_disk_present(ULONG index)
     /* Update drive state based on result */
     if (!disk_present) {
         drive->disk_state = DISK_NO_DISK;
-        drive->volume_name[0] = '\0';
+        drive->volume_name = "";
     }
 
     /* Clean up */
@@ -558,6 +626,35 @@ BOOL check_disk_present(ULONG index)
     return disk_present;
 }
 
+/*
+ * Byte offset of the partition start (low cylinder), clamped so that
+ * span bytes from there still fit into the 32-bit io_Offset
+ */
+static ULONG get_drive_read_offset(const DriveInfo *drive, ULONG block_size, ULONG span)
+{
+    uint64_t read_offset_bytes = 0;
+
+    if (drive->surfaces && drive->sectors_per_track) {
+        read_offset_bytes = (uint64_t)drive->low_cylinder *
+                            (uint64_t)drive->surfaces *
+                            (uint64_t)drive->sectors_per_track *
+                            (uint64_t)block_size;
+        if (block_size > 1 && read_offset_bytes > 0) {
+            read_offset_bytes -= read_offset_bytes % block_size;
+        }
+    } else {
+        debug("  drives: Missing geometry, defaulting read offset to 0\n");
+    }
+
+    if (read_offset_bytes > (uint64_t)(ULONG_MAX - span)) {
+        uint64_t limit = (uint64_t)(ULONG_MAX - span);
+        if (block_size > 1) limit -= limit % block_size;
+        read_offset_bytes = limit;
+    }
+
+    return (ULONG)read_offset_bytes;
+}
+
 /*
  * Measure drive speed (bytes/second)
  */
@@ -577,7 +674,6 @@ ULONG measure_drive_speed(ULONG index)
     ULONG bytes_per_sec = 0;
     ULONG num_reads;
     ULONG read_offset;
-    uint64_t read_offset_bytes = 0;
     ULONG i;
     BYTE error;
     BOOL is_floppy;
@@ -656,25 +752,7 @@ ULONG measure_drive_speed(ULONG index)
     }
 
     /* Calculate read offset - start from low cylinder, clamp to 32-bit */
-    if (drive->surfaces && drive->sectors_per_track) {
-        read_offset_bytes = (uint64_t)drive->low_cylinder *
-                            (uint64_t)drive->surfaces *
-                            (uint64_t)drive->sectors_per_track *
-                            (uint64_t)block_size;
-        if (block_size > 1 && read_offset_bytes > 0) {
-            read_offset_bytes -= read_offset_bytes % block_size;
-        }
-    } else {
-        debug("  drives: Missing geometry, defaulting read offset to 0\n");
-    }
-
-    if (read_offset_bytes > (uint64_t)(ULONG_MAX - buffer_size)) {
-        uint64_t limit = (uint64_t)(ULONG_MAX - buffer_size);
-        if (block_size > 1) limit -= limit % block_size;
-        read_offset_bytes = limit;
-    }
-
-    read_offset = (ULONG)read_offset_bytes;
+    read_offset = get_drive_read_offset(drive, block_size, buffer_size);
 
     debug("  drives: Speed test on %s unit %ld, %ld reads of %ld bytes at offset %ld\n",
           (LONG)drive->handler_name, (LONG)drive->unit_number,
@@ -751,249 +829,1410 @@ cleanup:
 }
 
 /*
- * Draw drives data area (buttons, info panel, action buttons - no title)
+ * Time one pipelined read run: keep up to depth requests in flight,
+ * reissuing each slot (and its buffer) as soon as it completes.
+ * Returns bytes/second, 0 on error
  */
-static void draw_drives_data(BOOL full_redraw)
+static ULONG run_queued_reads(struct IOStdReq **ios, APTR *buffers, ULONG depth,
+                              ULONG chunk_size, ULONG offset, ULONG total)
 {
-    struct RastPort *rp = app->rp;
-    WORD y;
-    DriveInfo *drive;
-    char buffer[64];
-    Button *btn;
-    int i;
+    ULONG E_Freq;
+    struct EClockVal start, end;
+    uint64_t elapsed;
+    ULONG issued = 0, total_read = 0;
+    ULONG in_flight = 0;
+    ULONG slot;
+    BOOL failed = FALSE;
 
-    /* Draw drive selection buttons on left */
-    for (i = 0; i < num_buttons; i++) {
-        if (buttons[i].id >= BTN_DRV_DRIVE_BASE &&
-            buttons[i].id < BTN_DRV_DRIVE_BASE + MAX_DRIVES) {
-            buttons[i].pressed = (app->selected_drive ==
-                                  (LONG)(buttons[i].id - BTN_DRV_DRIVE_BASE));
-            draw_button(&buttons[i]);
-        }
-    }
+    E_Freq = read_benchmark_clock(&start);
 
-    if (full_redraw) {
-        /* Draw drive info panel with 3D border */
-        draw_panel(100, 28, 520, 152, NULL);
-    } else {
-        /* Clear panel interior only (preserve 3D border) */
-        SetAPen(rp, COLOR_PANEL_BG);
-        RectFill(rp, 101, 29, 618, 178);
+    /* Fill the queue */
+    for (slot = 0; slot < depth && issued < total; slot++) {
+        ios[slot]->io_Command = CMD_READ;
+        ios[slot]->io_Data = buffers[slot];
+        ios[slot]->io_Length = chunk_size;
+        ios[slot]->io_Offset = offset + issued;
+        SendIO((struct IORequest *)ios[slot]);
+        issued += chunk_size;
+        in_flight++;
     }
 
-    if (app->selected_drive < 0 || app->selected_drive >= (LONG)drive_list.count) {
-        SetAPen(rp, COLOR_TEXT);
-        Move(rp, 250, 12);
-        Text(rp, (CONST_STRPTR)get_string(MSG_DRIVES_NO_DRIVES_FOUND), strlen(get_string(MSG_DRIVES_NO_DRIVES_FOUND)));
-    } else {
-        drive = &drive_list.drives[app->selected_drive];
-        y = 40;
-
-        /* Number of disk errors */
-        snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->disk_errors);
-        draw_label_value(120, y, get_string(MSG_DISK_ERRORS), buffer, 224);
-        y += 9;
-
-        /* Unit number */
-        snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->unit_number);
-        draw_label_value(120, y, get_string(MSG_UNIT_NUMBER), buffer, 224);
-        y += 9;
-
-        /* Disk state */
-        if (drive->disk_state == DISK_NO_DISK) {
-            draw_label_value(120, y, get_string(MSG_DISK_STATE), get_string(MSG_DASH_PLACEHOLDER), 224);
+    /* Requests were issued in slot order, so wait for them in that order */
+    slot = 0;
+    while (in_flight > 0) {
+        if (WaitIO((struct IORequest *)ios[slot]) != 0) {
+            debug("  drives: Queued read error %ld\n", (LONG)ios[slot]->io_Error);
+            failed = TRUE;
         } else {
-            draw_label_value(120, y, get_string(MSG_DISK_STATE),
-                             get_disk_state_string(drive->disk_state), 224);
+            total_read += ios[slot]->io_Actual;
         }
-        y += 9;
+        in_flight--;
+
+        if (!failed && issued < total) {
+            ios[slot]->io_Command = CMD_READ;
+            ios[slot]->io_Data = buffers[slot];
+            ios[slot]->io_Length = chunk_size;
+            ios[slot]->io_Offset = offset + issued;
+            SendIO((struct IORequest *)ios[slot]);
+            issued += chunk_size;
+            in_flight++;
+        }
+        slot = (slot + 1) % depth;
+    }
 
-        /* Total blocks - always show since it's a drive geometry property */
-        snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->total_blocks);
-        draw_label_value(120, y, get_string(MSG_TOTAL_BLOCKS), buffer, 224);
-        y += 9;
+    E_Freq = read_benchmark_clock(&end);
+    elapsed = EClock_Diff_in_ms(&start, &end, E_Freq);
 
-        /* Blocks used */
-        if (drive->disk_state == DISK_NO_DISK) {
-            snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_DASH_PLACEHOLDER));
-        } else {
-            snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->blocks_used);
-        }
-        draw_label_value(120, y, get_string(MSG_BLOCKS_USED), buffer, 224);
-        y += 9;
+    if (failed || elapsed == 0 || total_read == 0) return 0;
 
-        /* Bytes per block */
-        if (drive->disk_state == DISK_NO_DISK) {
-            snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_DASH_PLACEHOLDER));
-        } else {
-            ULONG display_block_size = get_display_block_size(drive);
-            snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)display_block_size);
-        }
-        draw_label_value(120, y, get_string(MSG_BYTES_PER_BLOCK), buffer, 224);
-        y += 9;
+    return (ULONG)(((uint64_t)total_read * 1000000ULL) / elapsed);
+}
 
-        /* Filesystem type */
-        if (drive->disk_state == DISK_NO_DISK) {
-            draw_label_value(120, y, get_string(MSG_DISK_TYPE), get_string(MSG_DISK_NO_DISK_INSERTED), 224);
-        } else {
-            draw_label_value(120, y, get_string(MSG_DISK_TYPE),
-                             get_filesystem_string(drive->fs_type), 224);
-        }
-        y += 9;
+/*
+ * Measure pipelined drive throughput at each queue depth in
+ * drive_queue_depths[], using SendIO()/WaitIO() over rotating buffers.
+ * Unlike measure_drive_speed() this does not hold Forbid().
+ */
+BOOL measure_drive_queued_speed(ULONG index)
+{
+    DriveInfo *drive;
+    struct MsgPort *port = NULL;
+    struct IOStdReq *ios[DRIVE_MAX_QUEUE_DEPTH];
+    APTR buffers[DRIVE_MAX_QUEUE_DEPTH];
+    BOOL device_opened = FALSE;
+    ULONG block_size;
+    ULONG chunk_size = DRIVE_QUEUE_CHUNK_SIZE;
+    ULONG read_offset;
+    ULONG total;
+    ULONG i;
+    BYTE error;
+    BOOL result = FALSE;
 
-        /* Volume name */
-        draw_label_value(120, y, get_string(MSG_VOLUME_NAME),
-                         (drive->disk_state == DISK_NO_DISK || !drive->volume_name[0]) ? get_string(MSG_DASH_PLACEHOLDER) : drive->volume_name, 224);
-        y += 9;
+    if (!benchmark_timer_available()) return FALSE;
+    if (index >= (ULONG)drive_list.count) return FALSE;
 
-        /* Device name */
-        draw_label_value(120, y, get_string(MSG_DEVICE_NAME),
-                         drive->handler_name[0] ? drive->handler_name : get_string(MSG_DASH_PLACEHOLDER), 224);
-        y += 9;
+    drive = &drive_list.drives[index];
 
-        /* Surfaces */
-        snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->surfaces);
-        draw_label_value(120, y, get_string(MSG_SURFACES), buffer, 224);
-        y += 9;
+    for (i = 0; i < DRIVE_QUEUE_DEPTHS; i++) {
+        drive->queue_bytes_sec[i] = 0;
+    }
+    drive->queue_measured = FALSE;
 
-        /* Sectors per side */
-        snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->sectors_per_track);
-        draw_label_value(120, y, get_string(MSG_SECTORS_PER_SIDE), buffer, 224);
-        y += 9;
+    /* trackdisk serializes everything, nothing to learn from floppies */
+    if (!drive->handler_name[0] || is_floppy_device(drive->total_blocks)) {
+        return FALSE;
+    }
 
-        /* Reserved blocks */
-        snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->reserved_blocks);
-        draw_label_value(120, y, get_string(MSG_RESERVED_BLOCKS), buffer, 224);
-        y += 9;
+    for (i = 0; i < DRIVE_MAX_QUEUE_DEPTH; i++) {
+        ios[i] = NULL;
+        buffers[i] = NULL;
+    }
 
-        /* Lowest cylinder */
-        snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->low_cylinder);
-        draw_label_value(120, y, get_string(MSG_LOWEST_CYLINDER), buffer, 224);
-        y += 9;
+    block_size = drive->bytes_per_block ? drive->bytes_per_block : 512;
+    if (block_size > 1) chunk_size -= chunk_size % block_size;
+    if (chunk_size < block_size) chunk_size = block_size;
 
-        /* Highest cylinder */
-        snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->high_cylinder);
-        draw_label_value(120, y, get_string(MSG_HIGHEST_CYLINDER), buffer, 224);
-        y += 9;
+    port = CreateMsgPort();
+    if (!port) {
+        debug("  drives: Failed to create message port\n");
+        goto cleanup;
+    }
 
-        /* Number of buffers */
-        snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->num_buffers);
-        draw_label_value(120, y, get_string(MSG_NUM_BUFFERS), buffer, 224);
-        y += 9;
+    for (i = 0; i < DRIVE_MAX_QUEUE_DEPTH; i++) {
+        ios[i] = (struct IOStdReq *)CreateIORequest(port, sizeof(struct IOStdReq));
+        if (!ios[i]) {
+            debug("  drives: Failed to create IO request\n");
+            goto cleanup;
+        }
+    }
 
-        /* Speed - display in appropriate units */
-        if (drive->speed_measured) {
-            ULONG speed = drive->speed_bytes_sec;
-            if (speed >= 1000000) {
-                /* MB/s for very fast drives */
-                snprintf(buffer, sizeof(buffer), "%lu.%lu MB/s",
-                         (unsigned long)(speed / 1000000),
-                         (unsigned long)((speed % 1000000) / 100000));
-            } else if (speed >= 10000) {
-                /* KB/s for typical drives */
-                snprintf(buffer, sizeof(buffer), "%lu KB/s",
-                         (unsigned long)(speed / 1000));
-            } else {
-                /* Bytes/s for very slow devices */
-                snprintf(buffer, sizeof(buffer), "%lu B/s", (unsigned long)speed);
-            }
-        } else {
-            snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_DASH_PLACEHOLDER));
+    error = OpenDevice((CONST_STRPTR)drive->handler_name, drive->unit_number,
+                       (struct IORequest *)ios[0], 0);
+    if (error != 0) {
+        debug("  drives: Failed to open device %s unit %ld (error %ld)\n",
+              (LONG)drive->handler_name, (LONG)drive->unit_number, (LONG)error);
+        goto cleanup;
+    }
+    device_opened = TRUE;
+
+    /* The other requests share the opened device and unit */
+    for (i = 1; i < DRIVE_MAX_QUEUE_DEPTH; i++) {
+        ios[i]->io_Device = ios[0]->io_Device;
+        ios[i]->io_Unit = ios[0]->io_Unit;
+    }
+
+    /* One buffer per slot - try fast memory first, fall back to any */
+    for (i = 0; i < DRIVE_MAX_QUEUE_DEPTH; i++) {
+        buffers[i] = AllocMem(chunk_size, MEMF_FAST | MEMF_CLEAR);
+        if (!buffers[i]) {
+            buffers[i] = AllocMem(chunk_size, MEMF_ANY | MEMF_CLEAR);
+        }
+        if (!buffers[i]) {
+            debug("  drives: Failed to allocate buffer\n");
+            goto cleanup;
         }
-        draw_label_value(120, y, get_string(MSG_SPEED), buffer, 224);
     }
 
-    /* Draw bottom buttons */
-    btn = find_button(BTN_DRV_EXIT);
-    if (btn) draw_button(btn);
-    btn = find_button(BTN_DRV_SCSI);
-    if (btn) draw_button(btn);
-    btn = find_button(BTN_DRV_SPEED);
-    if (btn) draw_button(btn);
-}
+    /* Stay inside the partition */
+    total = chunk_size * DRIVE_QUEUE_CHUNKS;
+    if (drive->total_blocks > 0 && (uint64_t)drive->total_blocks * block_size < total) {
+        total = drive->total_blocks * block_size;
+        total -= total % chunk_size;
+    }
+    if (total == 0) {
+        debug("  drives: Partition too small for queued reads\n");
+        goto cleanup;
+    }
 
-/*
- * Draw drives view
- */
-void draw_drives_view(void)
-{
-    /* Draw title panel */
-    draw_panel(100, 0, 520, 24, NULL);
+    read_offset = get_drive_read_offset(drive, block_size, total);
 
-    draw_text_centered(100, 14, 520, get_string(MSG_DRIVES_INFO), COLOR_TEXT);
+    for (i = 0; i < DRIVE_QUEUE_DEPTHS; i++) {
+        drive->queue_bytes_sec[i] = run_queued_reads(ios, buffers, drive_queue_depths[i],
+                                                     chunk_size, read_offset, total);
+        debug("  drives: Queue depth %ld: %ld bytes/sec\n",
+              (LONG)drive_queue_depths[i], (LONG)drive->queue_bytes_sec[i]);
+    }
 
-    /* Draw data area with full panel borders */
-    draw_drives_data(TRUE);
+    drive->queue_measured = TRUE;
+    result = TRUE;
+
+cleanup:
+    for (i = 0; i < DRIVE_MAX_QUEUE_DEPTH; i++) {
+        if (buffers[i]) FreeMem(buffers[i], chunk_size);
+    }
+    if (device_opened) {
+        CloseDevice((struct IORequest *)ios[0]);
+        WaitTOF();
+    }
+    for (i = 0; i < DRIVE_MAX_QUEUE_DEPTH; i++) {
+        if (ios[i]) DeleteIORequest((struct IORequest *)ios[i]);
+    }
+    if (port) DeleteMsgPort(port);
+
+    return result;
 }
 
 /*
- * Update buttons for Drives view
+ * Measure random read access across the partition (low..high cylinder)
+ * for each size in drive_random_sizes[]: IOPS, average and worst-case
+ * access time per read
  */
-void drives_view_update_buttons(void)
+BOOL measure_drive_random_speed(ULONG index)
 {
-    BOOL scsi_enabled = FALSE;
-    BOOL speed_enabled = FALSE;
-    ULONG i;
-    WORD y = 28;
+    DriveInfo *drive;
+    struct MsgPort *port = NULL;
+    struct IOStdReq *io = NULL;
+    APTR buffer = NULL;
+    BOOL device_opened = FALSE;
+    ULONG buffer_size = 0;
+    ULONG block_size;
+    ULONG start_offset;
+    ULONG span_blocks;
+    uint64_t span_bytes;
+    ULONG seed = 0x2545F491;
+    ULONG E_Freq;
+    struct EClockVal start, end;
+    ULONG elapsed;
+    uint64_t total_us;
+    ULONG max_us;
+    ULONG s, i;
+    BYTE error;
+    BOOL result = FALSE;
 
-    /* Drive selection buttons */
-    for (i = 0; i < drive_list.count && i < 10; i++) {
-        add_button(10, y, 70, 12,
-                   drive_list.drives[i].device_name,
-                   (ButtonID)(BTN_DRV_DRIVE_BASE + i), TRUE);
-        y += 14;
+    if (!benchmark_timer_available()) return FALSE;
+    if (index >= (ULONG)drive_list.count) return FALSE;
+
+    drive = &drive_list.drives[index];
+
+    for (s = 0; s < DRIVE_RANDOM_SIZES; s++) {
+        drive->random_iops[s] = 0;
+        drive->random_avg_us[s] = 0;
+        drive->random_max_us[s] = 0;
     }
+    drive->random_measured = FALSE;
 
-    /* Check capabilities of selected drive */
-    if (app->selected_drive >= 0 &&
-        app->selected_drive < (LONG)drive_list.count) {
-        DriveInfo *drive = &drive_list.drives[app->selected_drive];
-        scsi_enabled = drive->scsi_supported;
-        speed_enabled = (drive->disk_state != DISK_NO_DISK);
+    /* Floppy seeks are in the 100 ms range and trackdisk reads whole tracks */
+    if (!drive->handler_name[0] || is_floppy_device(drive->total_blocks)) {
+        return FALSE;
     }
 
-    /* Action buttons */
-    add_button(100, 188, 52, 12,
-               get_string(MSG_BTN_SCSI), BTN_DRV_SCSI, scsi_enabled);
-    add_button(160, 188, 52, 12,
-               get_string(MSG_BTN_SPEED), BTN_DRV_SPEED, speed_enabled);
-    add_button(220, 188, 52, 12,
-               get_string(MSG_BTN_EXIT), BTN_DRV_EXIT, TRUE);
-}
+    block_size = drive->bytes_per_block ? drive->bytes_per_block : 512;
 
-/*
- * Handle button press for Drives view
- */
-void drives_view_handle_button(ButtonID id)
-{
-    switch (id) {
-        case BTN_DRV_EXIT:
-            switch_to_view(VIEW_MAIN);
-            break;
+    /* Partition size in blocks, from geometry if we have it */
+    if (drive->surfaces && drive->sectors_per_track &&
+        drive->high_cylinder >= drive->low_cylinder) {
+        span_bytes = (uint64_t)(drive->high_cylinder - drive->low_cylinder + 1) *
+                     (uint64_t)drive->surfaces *
+                     (uint64_t)drive->sectors_per_track *
+                     (uint64_t)block_size;
+    } else {
+        span_bytes = (uint64_t)drive->total_blocks * (uint64_t)block_size;
+    }
 
-        case BTN_DRV_SCSI:
-            if (app->selected_drive >= 0 &&
-                app->selected_drive < (LONG)drive_list.count) {
-                DriveInfo *drive = &drive_list.drives[app->selected_drive];
-                scan_scsi_devices(drive->handler_name, drive->unit_number);
-                switch_to_view(VIEW_SCSI);
-            }
-            break;
+    for (s = 0; s < DRIVE_RANDOM_SIZES; s++) {
+        if (drive_random_sizes[s] > buffer_size) buffer_size = drive_random_sizes[s];
+    }
+    if (buffer_size < block_size) buffer_size = block_size;
 
-        case BTN_DRV_SPEED:
-            if (app->selected_drive >= 0 &&
+    /* Keep the whole range addressable by the 32-bit io_Offset */
+    start_offset = get_drive_read_offset(drive, block_size, 0);
+    if (span_bytes > (uint64_t)(ULONG_MAX - start_offset)) {
+        span_bytes = (uint64_t)(ULONG_MAX - start_offset);
+    }
+    if (span_bytes <= buffer_size) {
+        debug("  drives: Partition too small for random test\n");
+        return FALSE;
+    }
+    span_blocks = (ULONG)((span_bytes - buffer_size) / block_size);
+
+    port = CreateMsgPort();
+    if (!port) {
+        debug("  drives: Failed to create message port\n");
+        goto cleanup;
+    }
+
+    io = (struct IOStdReq *)CreateIORequest(port, sizeof(struct IOStdReq));
+    if (!io) {
+        debug("  drives: Failed to create IO request\n");
+        goto cleanup;
+    }
+
+    error = OpenDevice((CONST_STRPTR)drive->handler_name, drive->unit_number,
+                       (struct IORequest *)io, 0);
+    if (error != 0) {
+        debug("  drives: Failed to open device %s unit %ld (error %ld)\n",
+              (LONG)drive->handler_name, (LONG)drive->unit_number, (LONG)error);
+        goto cleanup;
+    }
+    device_opened = TRUE;
+
+    buffer = AllocMem(buffer_size, MEMF_FAST | MEMF_CLEAR);
+    if (!buffer) {
+        buffer = AllocMem(buffer_size, MEMF_ANY | MEMF_CLEAR);
+    }
+    if (!buffer) {
+        debug("  drives: Failed to allocate buffer\n");
+        goto cleanup;
+    }
+
+    for (s = 0; s < DRIVE_RANDOM_SIZES; s++) {
+        ULONG length = drive_random_sizes[s];
+
+        if (length < block_size) length = block_size;
+        total_us = 0;
+        max_us = 0;
+
+        for (i = 0; i < DRIVE_RANDOM_READS; i++) {
+            seed = seed * 1103515245UL + 12345UL;
+
+            io->io_Command = CMD_READ;
+            io->io_Data = buffer;
+            io->io_Length = length;
+            io->io_Offset = start_offset +
+                            ((seed >> 4) % (span_blocks + 1)) * block_size;
+
+            E_Freq = read_benchmark_clock(&start);
+            error = DoIO((struct IORequest *)io);
+            E_Freq = read_benchmark_clock(&end);
+
+            if (error != 0) {
+                debug("  drives: Random read error %ld at offset %lu\n",
+                      (LONG)error, (unsigned long)io->io_Offset);
+                goto cleanup;
+            }
+
+            elapsed = EClock_Diff_in_ms(&start, &end, E_Freq);
+            total_us += elapsed;
+            if (elapsed > max_us) max_us = elapsed;
+
+            if (((i + 1) % DRIVE_RANDOM_REPORT) == 0) {
+                debug("  drives: %lu x %lu bytes, avg %lu us, max %lu us\n",
+                      (unsigned long)(i + 1), (unsigned long)length,
+                      (unsigned long)(total_us / (i + 1)), (unsigned long)max_us);
+            }
+        }
+
+        if (total_us == 0) total_us = 1;
+        drive->random_iops[s] = (ULONG)(((uint64_t)DRIVE_RANDOM_READS * 1000000ULL) / total_us);
+        drive->random_avg_us[s] = (ULONG)(total_us / DRIVE_RANDOM_READS);
+        drive->random_max_us[s] = max_us;
+    }
+
+    drive->random_measured = TRUE;
+    result = TRUE;
+
+cleanup:
+    if (buffer) FreeMem(buffer, buffer_size);
+    if (device_opened) {
+        CloseDevice((struct IORequest *)io);
+        WaitTOF();
+    }
+    if (io) DeleteIORequest((struct IORequest *)io);
+    if (port) DeleteMsgPort(port);
+
+    return result;
+}
+
+/*
+ * Allocate a transfer buffer of the given DriveBufferType.
+ * Walks the system memory list under Forbid() and carves the buffer out
+ * of the first matching MemHeader, so 24- and 32-bit Fast RAM can be
+ * told apart (AllocMem(MEMF_FAST) hands out whichever comes first).
+ * Free with FreeMem()
+ */
+static APTR alloc_drive_buffer(ULONG type, ULONG size)
+{
+    struct MemHeader *mh;
+    APTR buffer = NULL;
+
+    Forbid();
+    for (mh = (struct MemHeader *)SysBase->MemList.lh_Head;
+         mh->mh_Node.ln_Succ && !buffer;
+         mh = (struct MemHeader *)mh->mh_Node.ln_Succ) {
+        BOOL match;
+
+        switch (type) {
+            case DRIVE_BUF_CHIP:
+                match = (mh->mh_Attributes & MEMF_CHIP) != 0;
+                break;
+            case DRIVE_BUF_FAST24:
+                match = (mh->mh_Attributes & MEMF_FAST) &&
+                        (ULONG)mh->mh_Upper <= 0x01000000;
+                break;
+            case DRIVE_BUF_FAST32:
+                match = (mh->mh_Attributes & MEMF_FAST) &&
+                        (ULONG)mh->mh_Lower >= 0x01000000;
+                break;
+            default:
+                match = FALSE;
+                break;
+        }
+        if (match && mh->mh_Free >= size) {
+            buffer = Allocate(mh, size);
+        }
+    }
+    Permit();
+
+    return buffer;
+}
+
+/*
+ * Measure read speed for every transfer size x buffer memory type.
+ * Buffers the partition's Mask says the controller cannot reach are
+ * skipped (DMA there would corrupt memory), those cells stay 0
+ */
+BOOL measure_drive_matrix(ULONG index)
+{
+    DriveInfo *drive;
+    struct MsgPort *port = NULL;
+    struct IOStdReq *io = NULL;
+    APTR buffer = NULL;
+    ULONG buffer_size = 0;
+    BOOL device_opened = FALSE;
+    ULONG block_size;
+    ULONG read_offset;
+    uint64_t partition_bytes;
+    ULONG E_Freq;
+    struct EClockVal start, end;
+    uint64_t elapsed;
+    ULONG type, s, i;
+    BYTE error;
+    BOOL result = FALSE;
+
+    if (!benchmark_timer_available()) return FALSE;
+    if (index >= (ULONG)drive_list.count) return FALSE;
+
+    drive = &drive_list.drives[index];
+
+    for (type = 0; type < DRIVE_BUFFER_TYPES; type++) {
+        for (s = 0; s < DRIVE_MATRIX_SIZES; s++) {
+            drive->matrix_bytes_sec[type][s] = 0;
+        }
+    }
+    drive->matrix_measured = FALSE;
+
+    if (!drive->handler_name[0] || is_floppy_device(drive->total_blocks)) {
+        return FALSE;
+    }
+
+    block_size = drive->bytes_per_block ? drive->bytes_per_block : 512;
+
+    port = CreateMsgPort();
+    if (!port) {
+        debug("  drives: Failed to create message port\n");
+        goto cleanup;
+    }
+
+    io = (struct IOStdReq *)CreateIORequest(port, sizeof(struct IOStdReq));
+    if (!io) {
+        debug("  drives: Failed to create IO request\n");
+        goto cleanup;
+    }
+
+    error = OpenDevice((CONST_STRPTR)drive->handler_name, drive->unit_number,
+                       (struct IORequest *)io, 0);
+    if (error != 0) {
+        debug("  drives: Failed to open device %s unit %ld (error %ld)\n",
+              (LONG)drive->handler_name, (LONG)drive->unit_number, (LONG)error);
+        goto cleanup;
+    }
+    device_opened = TRUE;
+
+    read_offset = get_drive_read_offset(drive, block_size,
+                                        DRIVE_MATRIX_MAX_SIZE * DRIVE_MATRIX_MIN_READS);
+    partition_bytes = (uint64_t)drive->total_blocks * block_size;
+
+    for (type = 0; type < DRIVE_BUFFER_TYPES; type++) {
+        /* Small machines may not have 1 MB of a type, test the sizes that fit */
+        for (buffer_size = DRIVE_MATRIX_MAX_SIZE; buffer_size >= DRIVE_MATRIX_MIN_SIZE;
+             buffer_size >>= 1) {
+            buffer = alloc_drive_buffer(type, buffer_size);
+            if (buffer) break;
+        }
+        if (!buffer) {
+            debug("  drives: No %lu-type buffer available\n", (unsigned long)type);
+            continue;
+        }
+
+        if (((ULONG)buffer & ~drive->dma_mask) ||
+            (((ULONG)buffer + buffer_size - 1) & ~drive->dma_mask)) {
+            debug("  drives: Buffer 0x%08lx outside Mask 0x%08lx, skipped\n",
+                  (ULONG)buffer, drive->dma_mask);
+            FreeMem(buffer, buffer_size);
+            buffer = NULL;
+            continue;
+        }
+
+        for (s = 0; s < DRIVE_MATRIX_SIZES; s++) {
+            ULONG length = DRIVE_MATRIX_MIN_SIZE << s;
+            ULONG num_reads = DRIVE_MATRIX_BYTES / length;
+            ULONG total_read = 0;
+
+            if (length < block_size || length > buffer_size) continue;
+            if (num_reads < DRIVE_MATRIX_MIN_READS) num_reads = DRIVE_MATRIX_MIN_READS;
+
+            /* Stay inside the partition, cells that do not fit stay 0 */
+            if (drive->total_blocks > 0 && (uint64_t)num_reads * length > partition_bytes) {
+                num_reads = (ULONG)(partition_bytes / length);
+                if (num_reads < DRIVE_MATRIX_MIN_READS) continue;
+            }
+
+            E_Freq = read_benchmark_clock(&start);
+            for (i = 0; i < num_reads; i++) {
+                io->io_Command = CMD_READ;
+                io->io_Data = buffer;
+                io->io_Length = length;
+                io->io_Offset = read_offset + i * length;
+
+                error = DoIO((struct IORequest *)io);
+                if (error != 0) {
+                    debug("  drives: Read error %ld at %lu bytes\n",
+                          (LONG)error, (unsigned long)length);
+                    break;
+                }
+                total_read += io->io_Actual;
+            }
+            E_Freq = read_benchmark_clock(&end);
+            elapsed = EClock_Diff_in_ms(&start, &end, E_Freq);
+
+            if (i == num_reads && elapsed > 0) {
+                drive->matrix_bytes_sec[type][s] =
+                    (ULONG)(((uint64_t)total_read * 1000000ULL) / elapsed);
+            }
+        }
+
+        FreeMem(buffer, buffer_size);
+        buffer = NULL;
+    }
+
+    drive->matrix_measured = TRUE;
+    result = TRUE;
+
+cleanup:
+    if (buffer) FreeMem(buffer, buffer_size);
+    if (device_opened) {
+        CloseDevice((struct IORequest *)io);
+        WaitTOF();
+    }
+    if (io) DeleteIORequest((struct IORequest *)io);
+    if (port) DeleteMsgPort(port);
+
+    return result;
+}
+
+/*
+ * Microseconds since start. Runs with multitasking on, the filesystem
+ * task does the work
+ */
+static ULONG fs_elapsed_us(struct EClockVal *start)
+{
+    struct EClockVal end;
+    ULONG E_Freq = read_benchmark_clock(&end);
+    ULONG elapsed = (ULONG)EClock_Diff_in_ms(start, &end, E_Freq);
+
+    return elapsed ? elapsed : 1;
+}
+
+static ULONG fs_rate(ULONG count, ULONG elapsed_us)
+{
+    return (ULONG)(((uint64_t)count * 1000000ULL) / elapsed_us);
+}
+
+/*
+ * Write size bytes to a new file in chunk-sized Write() calls.
+ * Close() is timed too, the handler may flush its buffers there
+ */
+static ULONG fs_write_file(const char *path, APTR buffer, ULONG chunk, ULONG size)
+{
+    struct EClockVal start;
+    BPTR fh;
+    ULONG done;
+
+    read_benchmark_clock(&start);
+    fh = Open((CONST_STRPTR)path, MODE_NEWFILE);
+    if (!fh) return 0;
+
+    for (done = 0; done < size; done += chunk) {
+        if (Write(fh, buffer, chunk) != (LONG)chunk) {
+            debug("  drives: Write failed (error %ld)\n", (LONG)IoErr());
+            Close(fh);
+            return 0;
+        }
+    }
+    Close(fh);
+
+    return fs_rate(size, fs_elapsed_us(&start));
+}
+
+static ULONG fs_read_file(const char *path, APTR buffer, ULONG chunk, ULONG size)
+{
+    struct EClockVal start;
+    BPTR fh;
+    ULONG done;
+
+    read_benchmark_clock(&start);
+    fh = Open((CONST_STRPTR)path, MODE_OLDFILE);
+    if (!fh) return 0;
+
+    for (done = 0; done < size; done += chunk) {
+        if (Read(fh, buffer, chunk) != (LONG)chunk) {
+            debug("  drives: Read failed (error %ld)\n", (LONG)IoErr());
+            Close(fh);
+            return 0;
+        }
+    }
+    Close(fh);
+
+    return fs_rate(size, fs_elapsed_us(&start));
+}
+
+/*
+ * Entries per second of ExNext() over the test directory
+ */
+static ULONG fs_scan_exnext(const char *dir)
+{
+    struct FileInfoBlock *fib;
+    struct EClockVal start;
+    BPTR lock;
+    ULONG entries = 0;
+    ULONG pass;
+
+    /* AllocMem keeps the FileInfoBlock longword aligned */
+    fib = (struct FileInfoBlock *)AllocMem(sizeof(struct FileInfoBlock), MEMF_PUBLIC | MEMF_CLEAR);
+    if (!fib) return 0;
+
+    lock = Lock((CONST_STRPTR)dir, ACCESS_READ);
+    if (!lock) {
+        FreeMem(fib, sizeof(struct FileInfoBlock));
+        return 0;
+    }
+
+    read_benchmark_clock(&start);
+    for (pass = 0; pass < DRIVE_FS_SCAN_PASSES; pass++) {
+        if (!Examine(lock, fib)) break;
+        while (ExNext(lock, fib)) {
+            entries++;
+        }
+    }
+    entries = fs_rate(entries, fs_elapsed_us(&start));
+
+    UnLock(lock);
+    FreeMem(fib, sizeof(struct FileInfoBlock));
+
+    return entries;
+}
+
+/*
+ * Entries per second of ExAll() over the test directory, 0 before V36
+ */
+static ULONG fs_scan_exall(const char *dir)
+{
+#ifdef __KICK13__
+    (void)dir;
+    return 0;
+#else
+    struct ExAllControl *eac;
+    struct EClockVal start;
+    APTR buffer;
+    BPTR lock;
+    BOOL more;
+    ULONG entries = 0;
+    ULONG pass;
+
+    if (DOSBase->dl_lib.lib_Version < 36) return 0;
+
+    eac = (struct ExAllControl *)AllocDosObject(DOS_EXALLCONTROL, NULL);
+    if (!eac) return 0;
+    buffer = AllocMem(DRIVE_FS_EXALL_BUFFER, MEMF_PUBLIC);
+    lock = Lock((CONST_STRPTR)dir, ACCESS_READ);
+    if (!buffer || !lock) goto cleanup;
+
+    read_benchmark_clock(&start);
+    for (pass = 0; pass < DRIVE_FS_SCAN_PASSES; pass++) {
+        eac->eac_LastKey = 0;
+        do {
+            more = ExAll(lock, (struct ExAllData *)buffer, DRIVE_FS_EXALL_BUFFER,
+                         ED_NAME, eac);
+            if (!more && IoErr() != ERROR_NO_MORE_ENTRIES) {
+                debug("  drives: ExAll failed (error %ld)\n", (LONG)IoErr());
+                entries = 0;
+                goto cleanup;
+            }
+            entries += eac->eac_Entries;
+        } while (more);
+    }
+    entries = fs_rate(entries, fs_elapsed_us(&start));
+
+cleanup:
+    if (lock) UnLock(lock);
+    if (buffer) FreeMem(buffer, DRIVE_FS_EXALL_BUFFER);
+    FreeDosObject(DOS_EXALLCONTROL, eac);
+
+    return entries;
+#endif
+}
+
+/*
+ * Measure the volume through its filesystem: sequential Write()/Read()
+ * of a temp file per buffer size, small file create/delete rate and
+ * directory scan rate. Unlike the raw CMD_READ tests this includes the
+ * handler's buffers (num_buffers), caching and directory overhead.
+ * Everything is written to a temp directory that is removed afterwards
+ */
+BOOL measure_drive_filesystem(ULONG index)
+{
+    DriveInfo *drive;
+    APTR buffer = NULL;
+    BPTR lock;
+    char dir[64];
+    char path[80];
+    ULONG file_size;
+    ULONG free_bytes;
+    ULONG created = 0;
+    ULONG deleted;
+    struct EClockVal start;
+    ULONG s, i;
+    BOOL dir_created = FALSE;
+    BOOL result = FALSE;
+
+    if (!benchmark_timer_available()) return FALSE;
+    if (index >= (ULONG)drive_list.count) return FALSE;
+
+    drive = &drive_list.drives[index];
+
+    for (s = 0; s < DRIVE_FS_BUFFER_SIZES; s++) {
+        drive->fs_write_bytes_sec[s] = 0;
+        drive->fs_read_bytes_sec[s] = 0;
+    }
+    drive->fs_creates_sec = 0;
+    drive->fs_deletes_sec = 0;
+    drive->fs_exnext_sec = 0;
+    drive->fs_exall_sec = 0;
+    drive->fs_measured = FALSE;
+
+    /* Needs a mounted, writable volume */
+    if (drive->disk_state != DISK_OK || !drive->volume_name[0]) {
+        return FALSE;
+    }
+
+    file_size = is_floppy_device(drive->total_blocks) ? DRIVE_FS_FLOPPY_SIZE
+                                                      : DRIVE_FS_FILE_SIZE;
+
+    /* Leave room for the small files and the filesystem's own blocks */
+    free_bytes = 0;
+    if (drive->total_blocks > drive->blocks_used) {
+        uint64_t bytes = (uint64_t)(drive->total_blocks - drive->blocks_used) *
+                         get_display_block_size(drive);
+        free_bytes = bytes > 0xFFFFFFFFULL ? 0xFFFFFFFFUL : (ULONG)bytes;
+    }
+    if (free_bytes / 2 < file_size + DRIVE_FS_SMALL_FILES * DRIVE_FS_SMALL_SIZE) {
+        debug("  drives: Only %lu bytes free on %s, filesystem test skipped\n",
+              (unsigned long)free_bytes, (LONG)drive->device_name);
+        return FALSE;
+    }
+
+    buffer = AllocMem(DRIVE_FS_MAX_BUFFER, MEMF_PUBLIC | MEMF_CLEAR);
+    if (!buffer) {
+        debug("  drives: Failed to allocate filesystem test buffer\n");
+        return FALSE;
+    }
+
+    snprintf(dir, sizeof(dir), "%s%s", drive->device_name, DRIVE_FS_DIR);
+    lock = CreateDir((CONST_STRPTR)dir);
+    if (!lock) {
+        debug("  drives: Cannot create %s (error %ld)\n", (LONG)dir, (LONG)IoErr());
+        goto cleanup;
+    }
+    UnLock(lock);
+    dir_created = TRUE;
+
+    /* Sequential write and read of one file per buffer size */
+    snprintf(path, sizeof(path), "%s/seq", dir);
+    for (s = 0; s < DRIVE_FS_BUFFER_SIZES; s++) {
+        ULONG chunk = DRIVE_FS_MIN_BUFFER << (3 * s);
+
+        if (chunk > file_size) chunk = file_size;
+
+        drive->fs_write_bytes_sec[s] = fs_write_file(path, buffer, chunk, file_size);
+        if (drive->fs_write_bytes_sec[s] == 0) goto cleanup;
+        drive->fs_read_bytes_sec[s] = fs_read_file(path, buffer, chunk, file_size);
+        DeleteFile((CONST_STRPTR)path);
+
+        debug("  drives: %s FS buffer %lu: write %lu, read %lu bytes/sec\n",
+              (LONG)drive->device_name, (unsigned long)chunk,
+              (unsigned long)drive->fs_write_bytes_sec[s],
+              (unsigned long)drive->fs_read_bytes_sec[s]);
+    }
+
+    /* Small files: create, scan the directory, delete */
+    read_benchmark_clock(&start);
+    for (created = 0; created < DRIVE_FS_SMALL_FILES; created++) {
+        BPTR fh;
+
+        snprintf(path, sizeof(path), "%s/f%02lu", dir, (unsigned long)created);
+        fh = Open((CONST_STRPTR)path, MODE_NEWFILE);
+        if (!fh) break;
+        Write(fh, buffer, DRIVE_FS_SMALL_SIZE);
+        Close(fh);
+    }
+    drive->fs_creates_sec = fs_rate(created, fs_elapsed_us(&start));
+
+    drive->fs_exnext_sec = fs_scan_exnext(dir);
+    drive->fs_exall_sec = fs_scan_exall(dir);
+
+    read_benchmark_clock(&start);
+    for (deleted = 0; deleted < created; deleted++) {
+        snprintf(path, sizeof(path), "%s/f%02lu", dir, (unsigned long)deleted);
+        if (!DeleteFile((CONST_STRPTR)path)) break;
+    }
+    drive->fs_deletes_sec = fs_rate(deleted, fs_elapsed_us(&start));
+
+    debug("  drives: %s FS create %lu/s, delete %lu/s, ExNext %lu/s, ExAll %lu/s\n",
+          (LONG)drive->device_name, (unsigned long)drive->fs_creates_sec,
+          (unsigned long)drive->fs_deletes_sec, (unsigned long)drive->fs_exnext_sec,
+          (unsigned long)drive->fs_exall_sec);
+
+    drive->fs_measured = TRUE;
+    result = TRUE;
+
+cleanup:
+    if (dir_created) {
+        /* Remove whatever a failed or partial run left behind */
+        snprintf(path, sizeof(path), "%s/seq", dir);
+        DeleteFile((CONST_STRPTR)path);
+        for (i = 0; i < created; i++) {
+            snprintf(path, sizeof(path), "%s/f%02lu", dir, (unsigned long)i);
+            DeleteFile((CONST_STRPTR)path);
+        }
+        DeleteFile((CONST_STRPTR)dir);
+    }
+    FreeMem(buffer, DRIVE_FS_MAX_BUFFER);
+
+    return result;
+}
+
+/*
+ * Format a drive speed in appropriate units
+ */
+static void format_drive_speed(char *buffer, size_t size, ULONG speed)
+{
+    if (speed >= 1000000) {
+        /* MB/s for very fast drives */
+        snprintf(buffer, size, "%lu.%lu MB/s",
+                 (unsigned long)(speed / 1000000),
+                 (unsigned long)((speed % 1000000) / 100000));
+    } else if (speed >= 10000) {
+        /* KB/s for typical drives */
+        snprintf(buffer, size, "%lu KB/s",
+                 (unsigned long)(speed / 1000));
+    } else {
+        /* Bytes/s for very slow devices */
+        snprintf(buffer, size, "%lu B/s", (unsigned long)speed);
+    }
+}
+
+/*
+ * Format average/maximum access time as "avg/max" in ms with one decimal
+ */
+static void format_access_time(char *buffer, size_t size, ULONG avg_us, ULONG max_us)
+{
+    snprintf(buffer, size, "%lu.%lu/%lu.%lu",
+             (unsigned long)(avg_us / 1000), (unsigned long)((avg_us % 1000) / 100),
+             (unsigned long)(max_us / 1000), (unsigned long)((max_us % 1000) / 100));
+}
+
+/*
+ * Draw drive details (left column) and measured results (right column)
+ */
+static void draw_drive_info(const DriveInfo *drive)
+{
+    WORD y = 40;
+    char buffer[64];
+    int i;
+
+    /* Number of disk errors */
+    snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->disk_errors);
+    draw_label_value(120, y, get_string(MSG_DISK_ERRORS), buffer, 224);
+    y += 9;
+
+    /* Unit number */
+    snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->unit_number);
+    draw_label_value(120, y, get_string(MSG_UNIT_NUMBER), buffer, 224);
+    y += 9;
+
+    /* Disk state */
+    if (drive->disk_state == DISK_NO_DISK) {
+        draw_label_value(120, y, get_string(MSG_DISK_STATE), get_string(MSG_DASH_PLACEHOLDER), 224);
+    } else {
+        draw_label_value(120, y, get_string(MSG_DISK_STATE),
+                         get_disk_state_string(drive->disk_state), 224);
+    }
+    y += 9;
+
+    /* Total blocks - always show since it's a drive geometry property */
+    snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->total_blocks);
+    draw_label_value(120, y, get_string(MSG_TOTAL_BLOCKS), buffer, 224);
+    y += 9;
+
+    /* Blocks used */
+    if (drive->disk_state == DISK_NO_DISK) {
+        snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_DASH_PLACEHOLDER));
+    } else {
+        snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->blocks_used);
+    }
+    draw_label_value(120, y, get_string(MSG_BLOCKS_USED), buffer, 224);
+    y += 9;
+
+    /* Bytes per block */
+    if (drive->disk_state == DISK_NO_DISK) {
+        snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_DASH_PLACEHOLDER));
+    } else {
+        ULONG display_block_size = get_display_block_size(drive);
+        snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)display_block_size);
+    }
+    draw_label_value(120, y, get_string(MSG_BYTES_PER_BLOCK), buffer, 224);
+    y += 9;
+
+    /* Filesystem type */
+    if (drive->disk_state == DISK_NO_DISK) {
+        draw_label_value(120, y, get_string(MSG_DISK_TYPE), get_string(MSG_DISK_NO_DISK_INSERTED), 224);
+    } else {
+        draw_label_value(120, y, get_string(MSG_DISK_TYPE),
+                         get_filesystem_string(drive->fs_type), 224);
+    }
+    y += 9;
+
+    /* Volume name */
+    draw_label_value(120, y, get_string(MSG_VOLUME_NAME),
+                     (drive->disk_state == DISK_NO_DISK || !drive->volume_name[0]) ? get_string(MSG_DASH_PLACEHOLDER) : drive->volume_name, 224);
+    y += 9;
+
+    /* Device name */
+    draw_label_value(120, y, get_string(MSG_DEVICE_NAME),
+                     drive->handler_name[0] ? drive->handler_name : get_string(MSG_DASH_PLACEHOLDER), 224);
+    y += 9;
+
+    /* Surfaces */
+    snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->surfaces);
+    draw_label_value(120, y, get_string(MSG_SURFACES), buffer, 224);
+    y += 9;
+
+    /* Sectors per side */
+    snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->sectors_per_track);
+    draw_label_value(120, y, get_string(MSG_SECTORS_PER_SIDE), buffer, 224);
+    y += 9;
+
+    /* Reserved blocks */
+    snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->reserved_blocks);
+    draw_label_value(120, y, get_string(MSG_RESERVED_BLOCKS), buffer, 224);
+    y += 9;
+
+    /* Lowest cylinder */
+    snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->low_cylinder);
+    draw_label_value(120, y, get_string(MSG_LOWEST_CYLINDER), buffer, 224);
+    y += 9;
+
+    /* Highest cylinder */
+    snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->high_cylinder);
+    draw_label_value(120, y, get_string(MSG_HIGHEST_CYLINDER), buffer, 224);
+    y += 9;
+
+    /* Number of buffers */
+    snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->num_buffers);
+    draw_label_value(120, y, get_string(MSG_NUM_BUFFERS), buffer, 224);
+    y += 9;
+
+    /* Speed - display in appropriate units */
+    if (drive->speed_measured) {
+        format_drive_speed(buffer, sizeof(buffer), drive->speed_bytes_sec);
+    } else {
+        snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_DASH_PLACEHOLDER));
+    }
+    draw_label_value(120, y, get_string(MSG_SPEED), buffer, 224);
+
+    /* Queued throughput in the right column (short-value rows only) */
+    y = 40 + 9 * 9;
+    for (i = 0; i < DRIVE_QUEUE_DEPTHS; i++) {
+        char label[16];
+        snprintf(label, sizeof(label), "%s %lu", get_string(MSG_QUEUE_DEPTH),
+                 (unsigned long)drive_queue_depths[i]);
+        if (drive->queue_measured && drive->queue_bytes_sec[i] > 0) {
+            format_drive_speed(buffer, sizeof(buffer), drive->queue_bytes_sec[i]);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_DASH_PLACEHOLDER));
+        }
+        draw_label_value(440, y, label, buffer, 80);
+        y += 9;
+    }
+
+    /* Random access results below: IOPS and avg/max access time */
+    for (i = 0; i < DRIVE_RANDOM_SIZES; i++) {
+        char label[16];
+        char size_str[8];
+
+        if (drive_random_sizes[i] >= 1024) {
+            snprintf(size_str, sizeof(size_str), "%luK",
+                     (unsigned long)(drive_random_sizes[i] / 1024));
+        } else {
+            snprintf(size_str, sizeof(size_str), "%lu",
+                     (unsigned long)drive_random_sizes[i]);
+        }
+
+        snprintf(label, sizeof(label), "%s %s", get_string(MSG_IOPS), size_str);
+        if (drive->random_measured) {
+            snprintf(buffer, sizeof(buffer), "%lu",
+                     (unsigned long)drive->random_iops[i]);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_DASH_PLACEHOLDER));
+        }
+        draw_label_value(440, y, label, buffer, 80);
+        y += 9;
+
+        snprintf(label, sizeof(label), "%s %s", get_string(MSG_ACCESS_TIME), size_str);
+        if (drive->random_measured) {
+            format_access_time(buffer, sizeof(buffer),
+                               drive->random_avg_us[i], drive->random_max_us[i]);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_DASH_PLACEHOLDER));
+        }
+        draw_label_value(440, y, label, buffer, 80);
+        y += 9;
+    }
+}
+
+/*
+ * Draw transfer size x buffer type matrix
+ */
+static void draw_drive_matrix(const DriveInfo *drive)
+{
+    char buffer[64];
+    char label[16];
+    ULONG size;
+    WORD y;
+    int s, type;
+
+    y = 40;
+    draw_text(120, y, get_string(MSG_TRANSFER_SIZE), COLOR_TEXT);
+    for (type = 0; type < DRIVE_BUFFER_TYPES; type++) {
+        draw_text_right(232 + type * 120, y, 104,
+                        get_drive_buffer_type_string(type), COLOR_TEXT);
+    }
+    y += 10;
+
+    for (s = 0; s < DRIVE_MATRIX_SIZES; s++) {
+        size = DRIVE_MATRIX_MIN_SIZE << s;
+        if (size >= 1024 * 1024) {
+            snprintf(label, sizeof(label), "%luM", (unsigned long)(size / (1024 * 1024)));
+        } else if (size >= 1024) {
+            snprintf(label, sizeof(label), "%luK", (unsigned long)(size / 1024));
+        } else {
+            snprintf(label, sizeof(label), "%luB", (unsigned long)size);
+        }
+        draw_text(120, y, label, COLOR_TEXT);
+
+        for (type = 0; type < DRIVE_BUFFER_TYPES; type++) {
+            if (drive->matrix_measured && drive->matrix_bytes_sec[type][s] > 0) {
+                format_drive_speed(buffer, sizeof(buffer), drive->matrix_bytes_sec[type][s]);
+            } else {
+                snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_DASH_PLACEHOLDER));
+            }
+            draw_text_right(232 + type * 120, y, 104, buffer, COLOR_HIGHLIGHT);
+        }
+        y += 9;
+    }
+
+    /* Mountlist values the matrix helps to tune */
+    y = 166;
+    snprintf(buffer, sizeof(buffer), "0x%08lX", (unsigned long)drive->max_transfer);
+    draw_label_value(120, y, get_string(MSG_MAX_TRANSFER), buffer, 104);
+    snprintf(buffer, sizeof(buffer), "0x%08lX", (unsigned long)drive->dma_mask);
+    draw_label_value(352, y, get_string(MSG_DMA_MASK), buffer, 56);
+}
+
+/*
+ * Draw filesystem results next to the raw device values they compare to
+ */
+static void draw_drive_fs(const DriveInfo *drive)
+{
+    static const LocaleStringID fs_rate_messages[4] = {
+        MSG_FS_CREATE, MSG_FS_DELETE, MSG_FS_EXNEXT, MSG_FS_EXALL
+    };
+    ULONG rates[4];
+    char buffer[64];
+    char label[16];
+    ULONG size;
+    WORD y;
+    int s, i;
+
+    y = 40;
+    draw_text(120, y, get_string(MSG_FS_BUFFER), COLOR_TEXT);
+    draw_text_right(232, y, 104, get_string(MSG_MEM_WRITE), COLOR_TEXT);
+    draw_text_right(352, y, 104, get_string(MSG_MEM_READ), COLOR_TEXT);
+    y += 10;
+
+    for (s = 0; s < DRIVE_FS_BUFFER_SIZES; s++) {
+        size = DRIVE_FS_MIN_BUFFER << (3 * s);
+        if (size >= 1024) {
+            snprintf(label, sizeof(label), "%luK", (unsigned long)(size / 1024));
+        } else {
+            snprintf(label, sizeof(label), "%luB", (unsigned long)size);
+        }
+        draw_text(120, y, label, COLOR_TEXT);
+
+        if (drive->fs_measured && drive->fs_write_bytes_sec[s] > 0) {
+            format_drive_speed(buffer, sizeof(buffer), drive->fs_write_bytes_sec[s]);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_DASH_PLACEHOLDER));
+        }
+        draw_text_right(232, y, 104, buffer, COLOR_HIGHLIGHT);
+
+        if (drive->fs_measured && drive->fs_read_bytes_sec[s] > 0) {
+            format_drive_speed(buffer, sizeof(buffer), drive->fs_read_bytes_sec[s]);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_DASH_PLACEHOLDER));
+        }
+        draw_text_right(352, y, 104, buffer, COLOR_HIGHLIGHT);
+        y += 9;
+    }
+
+    /* Small file and directory rates */
+    y += 6;
+    rates[0] = drive->fs_creates_sec;
+    rates[1] = drive->fs_deletes_sec;
+    rates[2] = drive->fs_exnext_sec;
+    rates[3] = drive->fs_exall_sec;
+    for (i = 0; i < 4; i++) {
+        if (drive->fs_measured && rates[i] > 0) {
+            snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)rates[i]);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_DASH_PLACEHOLDER));
+        }
+        draw_label_value(120, y, get_string(fs_rate_messages[i]), buffer, 224);
+        y += 9;
+    }
+
+    /* What the handler runs on: filesystem, buffers, raw CMD_READ speed */
+    y += 6;
+    draw_label_value(120, y, get_string(MSG_DISK_TYPE),
+                     get_filesystem_string(drive->fs_type), 224);
+    y += 9;
+    snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)drive->num_buffers);
+    draw_label_value(120, y, get_string(MSG_NUM_BUFFERS), buffer, 224);
+    y += 9;
+    if (drive->speed_measured) {
+        format_drive_speed(buffer, sizeof(buffer), drive->speed_bytes_sec);
+    } else {
+        snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_DASH_PLACEHOLDER));
+    }
+    draw_label_value(120, y, get_string(MSG_SPEED), buffer, 224);
+}
+
+/*
+ * Index of the drive on the first selection button, the page follows
+ * the selected drive
+ */
+static ULONG first_drive_button(void)
+{
+    if (app->selected_drive < 0) return 0;
+    return ((ULONG)app->selected_drive / DRIVE_BUTTONS) * DRIVE_BUTTONS;
+}
+
+/*
+ * Draw drives data area (buttons, info panel, action buttons - no title)
+ */
+static void draw_drives_data(BOOL full_redraw)
+{
+    struct RastPort *rp = app->rp;
+    DriveInfo *drive;
+    Button *btn;
+    int i;
+
+    /* Draw drive selection buttons on left */
+    for (i = 0; i < num_buttons; i++) {
+        if (buttons[i].id >= BTN_DRV_DRIVE_BASE &&
+            buttons[i].id < BTN_DRV_DRIVE_BASE + DRIVE_BUTTONS) {
+            buttons[i].pressed = (app->selected_drive ==
+                                  (LONG)(first_drive_button() +
+                                         buttons[i].id - BTN_DRV_DRIVE_BASE));
+            draw_button(&buttons[i]);
+        }
+    }
+    btn = find_button(BTN_DRV_NEXT);
+    if (btn) draw_button(btn);
+
+    if (full_redraw) {
+        /* Draw drive info panel with 3D border */
+        draw_panel(100, 28, 520, 152, NULL);
+    } else {
+        /* Clear panel interior only (preserve 3D border) */
+        SetAPen(rp, COLOR_PANEL_BG);
+        RectFill(rp, 101, 29, 618, 178);
+    }
+
+    if (app->selected_drive < 0 || app->selected_drive >= (LONG)drive_list.count) {
+        SetAPen(rp, COLOR_TEXT);
+        Move(rp, 250, 12);
+        Text(rp, (CONST_STRPTR)get_string(MSG_DRIVES_NO_DRIVES_FOUND), strlen(get_string(MSG_DRIVES_NO_DRIVES_FOUND)));
+    } else {
+        drive = &drive_list.drives[app->selected_drive];
+        if (app->drives_show_matrix) {
+            draw_drive_matrix(drive);
+        } else if (app->drives_show_fs) {
+            draw_drive_fs(drive);
+        } else {
+            draw_drive_info(drive);
+        }
+    }
+
+    /* Draw bottom buttons */
+    btn = find_button(BTN_DRV_EXIT);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_DRV_SCSI);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_DRV_SPEED);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_DRV_QUEUE);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_DRV_SEEK);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_DRV_MATRIX);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_DRV_FS);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_DRV_REFRESH);
+    if (btn) draw_button(btn);
+}
+
+/*
+ * Draw drives view
+ */
+void draw_drives_view(void)
+{
+    /* Draw title panel */
+    draw_panel(100, 0, 520, 24, NULL);
+
+    draw_text_centered(100, 14, 520, get_string(MSG_DRIVES_INFO), COLOR_TEXT);
+
+    /* Draw data area with full panel borders */
+    draw_drives_data(TRUE);
+}
+
+/*
+ * Update buttons for Drives view
+ */
+void drives_view_update_buttons(void)
+{
+    BOOL scsi_enabled = FALSE;
+    BOOL speed_enabled = FALSE;
+    BOOL queue_enabled = FALSE;
+    BOOL fs_enabled = FALSE;
+    ULONG first = first_drive_button();
+    ULONG i;
+    WORD y = 28;
+
+    /* Drive selection buttons */
+    for (i = 0; first + i < drive_list.count && i < DRIVE_BUTTONS; i++) {
+        add_button(10, y, 70, 12,
+                   drive_list.drives[first + i].device_name,
+                   (ButtonID)(BTN_DRV_DRIVE_BASE + i), TRUE);
+        y += 14;
+    }
+
+    /* More drives than buttons */
+    if (drive_list.count > DRIVE_BUTTONS) {
+        add_button(10, 28 + DRIVE_BUTTONS * 14, 70, 12,
+                   get_string(MSG_BTN_NEXT), BTN_DRV_NEXT, TRUE);
+    }
+
+    /* Check capabilities of selected drive */
+    if (app->selected_drive >= 0 &&
+        app->selected_drive < (LONG)drive_list.count) {
+        DriveInfo *drive = &drive_list.drives[app->selected_drive];
+        scsi_enabled = drive->scsi_supported;
+        speed_enabled = (drive->disk_state != DISK_NO_DISK);
+        queue_enabled = speed_enabled && !is_floppy_device(drive->total_blocks);
+        fs_enabled = (drive->disk_state == DISK_OK && drive->volume_name[0]);
+    }
+
+    /* Action buttons */
+    add_button(100, 188, 52, 12,
+               get_string(MSG_BTN_SCSI), BTN_DRV_SCSI, scsi_enabled);
+    add_button(160, 188, 52, 12,
+               get_string(MSG_BTN_SPEED), BTN_DRV_SPEED, speed_enabled);
+    add_button(220, 188, 52, 12,
+               get_string(MSG_BTN_EXIT), BTN_DRV_EXIT, TRUE);
+    add_button(280, 188, 52, 12,
+               get_string(MSG_BTN_QUEUE), BTN_DRV_QUEUE, queue_enabled);
+    add_button(340, 188, 52, 12,
+               get_string(MSG_BTN_SEEK), BTN_DRV_SEEK, queue_enabled);
+    add_button(400, 188, 52, 12,
+               app->drives_show_matrix ? get_string(MSG_BTN_INFO) : get_string(MSG_BTN_MATRIX),
+               BTN_DRV_MATRIX, queue_enabled || app->drives_show_matrix);
+    add_button(528, 188, 52, 12,
+               app->drives_show_fs ? get_string(MSG_BTN_INFO) : get_string(MSG_BTN_FS),
+               BTN_DRV_FS, fs_enabled || app->drives_show_fs);
+    add_button(460, 188, 60, 12,
+               get_string(MSG_BTN_REFRESH), BTN_DRV_REFRESH, TRUE);
+}
+
+/*
+ * Handle button press for Drives view
+ */
+void drives_view_handle_button(ButtonID id)
+{
+    switch (id) {
+        case BTN_DRV_EXIT:
+            switch_to_view(VIEW_MAIN);
+            break;
+
+        case BTN_DRV_SCSI:
+            if (app->selected_drive >= 0 &&
+                app->selected_drive < (LONG)drive_list.count) {
+                DriveInfo *drive = &drive_list.drives[app->selected_drive];
+                scan_scsi_devices(drive->handler_name, drive->unit_number, FALSE);
+                switch_to_view(VIEW_SCSI);
+            }
+            break;
+
+        case BTN_DRV_SPEED:
+            /* The background suite would compete for the bus */
+            if (benchmark_task_running()) break;
+            if (app->selected_drive >= 0 &&
                 app->selected_drive < (LONG)drive_list.count) {
                 show_status_overlay(get_string(MSG_MEASURING_SPEED));
                 measure_drive_speed(app->selected_drive);
                 hide_status_overlay();
+                history_update_drives();
+            }
+            break;
+
+        case BTN_DRV_QUEUE:
+            if (benchmark_task_running()) break;
+            if (app->selected_drive >= 0 &&
+                app->selected_drive < (LONG)drive_list.count) {
+                show_status_overlay(get_string(MSG_MEASURING_SPEED));
+                /* Requests in flight need other tasks running, keep the
+                 * overlay up but lift its Forbid() */
+                Permit();
+                measure_drive_queued_speed(app->selected_drive);
+                Forbid();
+                hide_status_overlay();
+            }
+            break;
+
+        case BTN_DRV_SEEK:
+            if (benchmark_task_running()) break;
+            if (app->selected_drive >= 0 &&
+                app->selected_drive < (LONG)drive_list.count) {
+                show_status_overlay(get_string(MSG_MEASURING_SPEED));
+                /* The device task has to run, lift the overlay's Forbid() */
+                Permit();
+                measure_drive_random_speed(app->selected_drive);
+                Forbid();
+                hide_status_overlay();
+            }
+            break;
+
+        case BTN_DRV_REFRESH:
+            show_status_overlay(get_string(MSG_PROBING_DRIVES));
+            reprobe_drives();
+            if (app->selected_drive >= (LONG)drive_list.count) {
+                app->selected_drive = drive_list.count > 0 ? 0 : -1;
+            }
+            hide_status_overlay();
+            break;
+
+        case BTN_DRV_MATRIX:
+            if (benchmark_task_running()) break;
+            if (app->drives_show_matrix) {
+                app->drives_show_matrix = FALSE;
+                redraw_current_view();
+            } else if (app->selected_drive >= 0 &&
+                       app->selected_drive < (LONG)drive_list.count) {
+                app->drives_show_matrix = TRUE;
+                app->drives_show_fs = FALSE;
+                show_status_overlay(get_string(MSG_MEASURING_SPEED));
+                /* The device task has to run, lift the overlay's Forbid() */
+                Permit();
+                measure_drive_matrix(app->selected_drive);
+                Forbid();
+                hide_status_overlay();
+            }
+            break;
+
+        case BTN_DRV_FS:
+            if (benchmark_task_running()) break;
+            if (app->drives_show_fs) {
+                app->drives_show_fs = FALSE;
+                redraw_current_view();
+            } else if (app->selected_drive >= 0 &&
+                       app->selected_drive < (LONG)drive_list.count) {
+                app->drives_show_fs = TRUE;
+                app->drives_show_matrix = FALSE;
+                show_status_overlay(get_string(MSG_MEASURING_SPEED));
+                /* The filesystem task does the work, lift the overlay's Forbid() */
+                Permit();
+                measure_drive_filesystem(app->selected_drive);
+                Forbid();
+                hide_status_overlay();
+            }
+            break;
+
+        case BTN_DRV_NEXT:
+            /* First drive of the next page, wrapping around */
+            if (drive_list.count > 0) {
+                ULONG next = first_drive_button() + DRIVE_BUTTONS;
+                app->selected_drive = next < drive_list.count ? (LONG)next : 0;
+                check_disk_present(app->selected_drive);
+                redraw_current_view();
             }
             break;
 
         default:
             /* Check for drive selection buttons */
             if (id >= BTN_DRV_DRIVE_BASE &&
-                id < BTN_DRV_DRIVE_BASE + MAX_DRIVES) {
-                ULONG drive_index = id - BTN_DRV_DRIVE_BASE;
+                id < BTN_DRV_DRIVE_BASE + DRIVE_BUTTONS) {
+                ULONG drive_index = first_drive_button() + id - BTN_DRV_DRIVE_BASE;
                 app->selected_drive = drive_index;
                 /* Check if disk is present when selecting a drive */
                 check_disk_present(drive_index);
@@ -10,8 +10,46 @@
 
 #include "xsysinfo.h"
 
-/* Maximum drives we'll track */
-#define MAX_DRIVES  32
+/* Drive selection buttons per page */
+#define DRIVE_BUTTONS   10
+
+/* Pipelined (SendIO) throughput test */
+#define DRIVE_QUEUE_DEPTHS      3           /* Depths 2, 4 and 8 */
+#define DRIVE_MAX_QUEUE_DEPTH   8
+#define DRIVE_QUEUE_CHUNK_SIZE  (64 * 1024) /* Bytes per request */
+#define DRIVE_QUEUE_CHUNKS      32          /* Requests per depth (2 MB) */
+
+/* Random access (seek) test */
+#define DRIVE_RANDOM_SIZES      2           /* 512 bytes and 4 KB */
+#define DRIVE_RANDOM_READS      256         /* Reads per size */
+#define DRIVE_RANDOM_REPORT     64          /* Debug progress interval */
+
+/* Transfer size x buffer type matrix */
+#define DRIVE_MATRIX_SIZES      12          /* 512 bytes .. 1 MB, powers of two */
+#define DRIVE_MATRIX_MIN_SIZE   512
+#define DRIVE_MATRIX_MAX_SIZE   (DRIVE_MATRIX_MIN_SIZE << (DRIVE_MATRIX_SIZES - 1))
+#define DRIVE_MATRIX_BYTES      (128 * 1024) /* Bytes read per cell (at least) */
+#define DRIVE_MATRIX_MIN_READS  2           /* Reads per cell (at least) */
+
+/* Filesystem (DOS level) test in a temp directory on the volume */
+#define DRIVE_FS_BUFFER_SIZES   4           /* 512 bytes .. 256 KB, x8 per step */
+#define DRIVE_FS_MIN_BUFFER     512
+#define DRIVE_FS_MAX_BUFFER     (DRIVE_FS_MIN_BUFFER << (3 * (DRIVE_FS_BUFFER_SIZES - 1)))
+#define DRIVE_FS_FILE_SIZE      (1024 * 1024) /* Sequential test file */
+#define DRIVE_FS_FLOPPY_SIZE    (128 * 1024)  /* ... on floppies */
+#define DRIVE_FS_SMALL_FILES    32          /* Files created, scanned, deleted */
+#define DRIVE_FS_SMALL_SIZE     512
+#define DRIVE_FS_SCAN_PASSES    8           /* Directory scans per method */
+#define DRIVE_FS_EXALL_BUFFER   1024
+#define DRIVE_FS_DIR            "xSysInfo.fstest"
+
+/* Buffer memory types for the matrix */
+typedef enum {
+    DRIVE_BUF_CHIP,
+    DRIVE_BUF_FAST24,           /* Fast RAM below 16 MB */
+    DRIVE_BUF_FAST32,           /* Fast RAM above 16 MB */
+    DRIVE_BUFFER_TYPES
+} DriveBufferType;
 
 /* Disk state */
 typedef enum {
@@ -37,9 +75,9 @@ typedef enum {
 
 /* Drive information */
 typedef struct {
-    char device_name[32];       /* e.g., "DF0:" */
-    char volume_name[64];       /* Volume label */
-    char handler_name[64];      /* e.g., "trackdisk.device" */
+    const char *device_name;    /* e.g., "DF0:" (pooled strings, never NULL) */
+    const char *volume_name;    /* Volume label */
+    const char *handler_name;   /* e.g., "trackdisk.device" */
     ULONG unit_number;
     DiskState disk_state;
     ULONG total_blocks;
@@ -53,32 +91,62 @@ typedef struct {
     ULONG low_cylinder;
     ULONG high_cylinder;
     ULONG num_buffers;
+    ULONG max_transfer;         /* de_MaxTransfer */
+    ULONG dma_mask;             /* de_Mask */
     ULONG speed_bytes_sec;      /* 0 = not measured */
     ULONG disk_errors;
     BOOL speed_measured;
+    ULONG queue_bytes_sec[DRIVE_QUEUE_DEPTHS]; /* Pipelined speed per queue depth */
+    BOOL queue_measured;
+    ULONG random_iops[DRIVE_RANDOM_SIZES];    /* Random reads per second */
+    ULONG random_avg_us[DRIVE_RANDOM_SIZES];  /* Average access time */
+    ULONG random_max_us[DRIVE_RANDOM_SIZES];  /* Worst access time */
+    BOOL random_measured;
+    ULONG matrix_bytes_sec[DRIVE_BUFFER_TYPES][DRIVE_MATRIX_SIZES]; /* 0 = not tested */
+    BOOL matrix_measured;
+    ULONG fs_write_bytes_sec[DRIVE_FS_BUFFER_SIZES]; /* DOS Write() per buffer size */
+    ULONG fs_read_bytes_sec[DRIVE_FS_BUFFER_SIZES];  /* DOS Read() per buffer size */
+    ULONG fs_creates_sec;       /* Small files created per second */
+    ULONG fs_deletes_sec;       /* Small files deleted per second */
+    ULONG fs_exnext_sec;        /* Directory entries per second, ExNext() */
+    ULONG fs_exall_sec;         /* ... ExAll(), 0 = needs V36 */
+    BOOL fs_measured;
     BOOL scsi_supported;        /* TRUE if device supports SCSI direct commands */
     BOOL is_valid;              /* Entry contains valid data */
 } DriveInfo;
 
-/* Drive list */
+/* Drive list, drives allocated from the pool */
 typedef struct {
-    DriveInfo drives[MAX_DRIVES];
+    DriveInfo *drives;
     ULONG count;
+    ULONG capacity;
 } DriveList;
 
 /* Global drive list */
 extern DriveList drive_list;
 
+/* Queue depth for each queue_bytes_sec entry */
+extern const ULONG drive_queue_depths[DRIVE_QUEUE_DEPTHS];
+
+/* Read size for each random_* entry */
+extern const ULONG drive_random_sizes[DRIVE_RANDOM_SIZES];
+
 /* Function prototypes */
 void enumerate_drives(void);
+void reprobe_drives(void);
 void refresh_drive_info(ULONG index);
 ULONG measure_drive_speed(ULONG index);
+BOOL measure_drive_queued_speed(ULONG index);
+BOOL measure_drive_random_speed(ULONG index);
+BOOL measure_drive_matrix(ULONG index);
+BOOL measure_drive_filesystem(ULONG index);
 BOOL check_disk_present(ULONG index);
 ULONG get_display_block_size(const DriveInfo *drive);
 
 /* Helper functions */
 const char *get_disk_state_string(DiskState state);
 const char *get_filesystem_string(FilesystemType fs);
+const char *get_drive_buffer_type_string(ULONG type);
 FilesystemType identify_filesystem(ULONG dos_type);
 
 #endif /* DRIVES_H */
@@ -0,0 +1,355 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - graphics.library rendering benchmark
+ *
+ * Times the calls applications actually render with on the screen
+ * xSysInfo runs on and on a second screen in a chosen (RTG) mode.
+ * Everything goes through graphics.library, so on a graphics card the
+ * numbers include the P96/CGX driver and the bus the board sits on:
+ * the same card in Zorro II, Zorro III or on a local bus, or two driver
+ * versions, give different results here.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <exec/memory.h>
+#include <graphics/gfx.h>
+#include <graphics/gfxbase.h>
+#include <graphics/rastport.h>
+#include <graphics/displayinfo.h>
+#include <graphics/modeid.h>
+#include <intuition/intuitionbase.h>
+#include <intuition/screens.h>
+
+#include <proto/exec.h>
+#include <proto/graphics.h>
+#include <proto/intuition.h>
+
+#include "xsysinfo.h"
+#include "gfxbench.h"
+#include "benchmark.h"
+#include "gui.h"
+#include "debug.h"
+
+extern struct GfxBase *GfxBase;
+extern struct IntuitionBase *IntuitionBase;
+
+/* Global results */
+GfxBenchResults gfx_results;
+
+/* Mode from the GFXMODE tooltype/argument */
+static ULONG gfx_mode_id = INVALID_ID;
+
+static const char *gfx_op_names[GFX_OPS] = {
+    "RectFill", "Blit", "Pixels", "Text", "Scroll"
+};
+
+static const char gfx_text[] = "xSysInfo graphics benchmark";
+
+/* Sources for the pixel array operation */
+typedef struct {
+    UBYTE *chunky;              /* GFX_BLOCK_W x GFX_BLOCK_H pens */
+    struct RastPort temp_rp;    /* One line temporary for WritePixelArray8 */
+    struct BitMap temp_bm;
+    BOOL have_temp;
+} GfxPixels;
+
+/*
+ * Select the mode of the second screen
+ */
+void set_gfx_bench_mode(ULONG mode_id)
+{
+    gfx_mode_id = mode_id;
+}
+
+/*
+ * Name of an operation
+ */
+const char *get_gfx_op_name(ULONG op)
+{
+    return op < GFX_OPS ? gfx_op_names[op] : "";
+}
+
+/*
+ * Depth of a bitmap, also for RTG bitmaps where bm->Depth is not valid
+ */
+static UWORD bitmap_depth(struct BitMap *bm)
+{
+    if (GfxBase->LibNode.lib_Version >= 39) {
+        return (UWORD)GetBitMapAttr(bm, BMA_DEPTH);
+    }
+    return bm->Depth;
+}
+
+/*
+ * TRUE if a bitmap is not a standard planar one (graphics card memory)
+ */
+static BOOL bitmap_is_rtg(struct BitMap *bm)
+{
+    if (GfxBase->LibNode.lib_Version >= 39) {
+        return (GetBitMapAttr(bm, BMA_FLAGS) & BMF_STANDARD) == 0;
+    }
+    return FALSE;
+}
+
+/*
+ * Set up the pixel array sources for a rastport of the given depth
+ * WritePixelArray8 needs a temporary rastport on graphics before V40
+ */
+static BOOL alloc_gfx_pixels(GfxPixels *pixels, struct RastPort *rp, UWORD depth)
+{
+    ULONG i;
+
+    memset(pixels, 0, sizeof(*pixels));
+
+    pixels->chunky = AllocMem(GFX_BLOCK_W * GFX_BLOCK_H, MEMF_ANY);
+    if (!pixels->chunky) return FALSE;
+
+    for (i = 0; i < GFX_BLOCK_W * GFX_BLOCK_H; i++) {
+        pixels->chunky[i] = (UBYTE)(i & ((1 << (depth > 8 ? 8 : depth)) - 1));
+    }
+
+    if (GfxBase->LibNode.lib_Version < 40 && depth <= 8) {
+        pixels->temp_rp = *rp;
+        pixels->temp_rp.Layer = NULL;
+        InitBitMap(&pixels->temp_bm, depth, GFX_BLOCK_W, 1);
+        for (i = 0; i < depth; i++) {
+            pixels->temp_bm.Planes[i] = AllocRaster(GFX_BLOCK_W, 1);
+            if (!pixels->temp_bm.Planes[i]) break;
+        }
+        pixels->temp_rp.BitMap = &pixels->temp_bm;
+        pixels->have_temp = (i == depth);
+    }
+
+    return TRUE;
+}
+
+/*
+ * Free the pixel array sources
+ */
+static void free_gfx_pixels(GfxPixels *pixels)
+{
+    ULONG i;
+
+    for (i = 0; i < 8; i++) {
+        if (pixels->temp_bm.Planes[i]) {
+            FreeRaster(pixels->temp_bm.Planes[i], GFX_BLOCK_W, 1);
+        }
+    }
+    if (pixels->chunky) {
+        FreeMem(pixels->chunky, GFX_BLOCK_W * GFX_BLOCK_H);
+    }
+}
+
+/*
+ * Run one operation loops times with its test area at x, y
+ * Returns elapsed microseconds, 0 if the operation is not available
+ */
+static uint64_t time_gfx_op(struct RastPort *rp, ULONG op, WORD x, WORD y,
+                            GfxPixels *pixels, ULONG loops)
+{
+    struct EClockVal start, end;
+    ULONG E_Freq;
+    ULONG i;
+
+    if (op == GFX_OP_PIXELS && GfxBase->LibNode.lib_Version < 40 && !pixels->have_temp) {
+        return 0;
+    }
+
+    E_Freq = read_benchmark_clock(&start);
+
+    switch (op) {
+        case GFX_OP_RECTFILL:
+            for (i = 0; i < loops; i++) {
+                SetAPen(rp, (i & 3) + 1);
+                RectFill(rp, x, y, x + GFX_BLOCK_W - 1, y + GFX_BLOCK_H - 1);
+            }
+            break;
+
+        case GFX_OP_BLIT:
+            for (i = 0; i < loops; i++) {
+                ClipBlit(rp, x, y, rp, x + GFX_BLOCK_W, y, GFX_BLOCK_W, GFX_BLOCK_H, 0xC0);
+            }
+            break;
+
+        case GFX_OP_PIXELS:
+            for (i = 0; i < loops; i++) {
+                if (GfxBase->LibNode.lib_Version >= 40) {
+                    WriteChunkyPixels(rp, x, y, x + GFX_BLOCK_W - 1, y + GFX_BLOCK_H - 1,
+                                      pixels->chunky, GFX_BLOCK_W);
+                } else {
+                    WritePixelArray8(rp, x, y, x + GFX_BLOCK_W - 1, y + GFX_BLOCK_H - 1,
+                                     pixels->chunky, &pixels->temp_rp);
+                }
+            }
+            break;
+
+        case GFX_OP_TEXT:
+            for (i = 0; i < loops; i++) {
+                Move(rp, x, y + rp->TxBaseline);
+                Text(rp, (CONST_STRPTR)gfx_text, sizeof(gfx_text) - 1);
+            }
+            break;
+
+        case GFX_OP_SCROLL:
+            for (i = 0; i < loops; i++) {
+                ScrollRaster(rp, 0, 1, x, y, x + GFX_SCROLL_W - 1, y + GFX_BLOCK_H - 1);
+            }
+            break;
+    }
+
+    /* Native blits may still be running */
+    WaitBlit();
+
+    E_Freq = read_benchmark_clock(&end);
+
+    return EClock_Diff_in_ms(&start, &end, E_Freq);
+}
+
+/*
+ * Time all operations on a rastport and fill in one screen's results
+ */
+static void measure_rastport(struct RastPort *rp, WORD x, WORD y, GfxScreenResults *res)
+{
+    GfxPixels pixels;
+    UBYTE old_apen = rp->FgPen;
+    UBYTE old_bpen = rp->BgPen;
+    UBYTE old_drmd = rp->DrawMode;
+    ULONG bits = res->depth > 8 ? ((res->depth + 7) / 8) * 8 : res->depth;
+    ULONG text_w;
+    ULONG op;
+
+    if (!alloc_gfx_pixels(&pixels, rp, res->depth)) return;
+
+    SetDrMd(rp, JAM2);
+    SetBPen(rp, 0);
+    text_w = TextLength(rp, (CONST_STRPTR)gfx_text, sizeof(gfx_text) - 1);
+
+    for (op = 0; op < GFX_OPS; op++) {
+        ULONG loops = GFX_MIN_LOOPS;
+        uint64_t elapsed, pixels_per_op;
+
+        for (;;) {
+            elapsed = time_gfx_op(rp, op, x, y, &pixels, loops);
+            if (elapsed == 0 || elapsed >= GFX_MIN_US || loops >= GFX_MAX_LOOPS) break;
+            loops *= 2;
+        }
+        if (elapsed == 0) continue;
+
+        switch (op) {
+            case GFX_OP_TEXT:
+                pixels_per_op = (uint64_t)text_w * rp->TxHeight;
+                break;
+            case GFX_OP_SCROLL:
+                pixels_per_op = (uint64_t)GFX_SCROLL_W * GFX_BLOCK_H;
+                break;
+            default:
+                pixels_per_op = (uint64_t)GFX_BLOCK_W * GFX_BLOCK_H;
+                break;
+        }
+
+        res->ops_sec[op] = (ULONG)(((uint64_t)loops * 1000000ULL) / elapsed);
+        res->bytes_sec[op] = (ULONG)(((uint64_t)loops * pixels_per_op * bits / 8 * 1000000ULL) / elapsed);
+
+        debug("  gfx: %s: %lu loops, %lu us\n", (LONG)gfx_op_names[op], loops, (ULONG)elapsed);
+    }
+
+    free_gfx_pixels(&pixels);
+
+    SetAPen(rp, old_apen);
+    SetBPen(rp, old_bpen);
+    SetDrMd(rp, old_drmd);
+
+    res->valid = TRUE;
+}
+
+/*
+ * Fill in the geometry of a screen
+ */
+static void describe_screen(struct Screen *screen, GfxScreenResults *res)
+{
+    struct BitMap *bm = screen->RastPort.BitMap;
+
+    res->width = screen->Width;
+    res->height = screen->Height;
+    res->depth = bitmap_depth(bm);
+    res->rtg = bitmap_is_rtg(bm);
+    res->mode_id = GfxBase->LibNode.lib_Version >= 36 ? GetVPModeID(&screen->ViewPort)
+                                                      : INVALID_ID;
+}
+
+/*
+ * Mode for the second screen: the chosen one or the best 640x480x8
+ */
+static ULONG select_gfx_mode(void)
+{
+    if (gfx_mode_id != (ULONG)INVALID_ID) return gfx_mode_id;
+
+    if (GfxBase->LibNode.lib_Version < 39) return INVALID_ID;
+
+    return BestModeID(BIDTAG_NominalWidth, 640,
+                      BIDTAG_NominalHeight, 480,
+                      BIDTAG_Depth, 8,
+                      TAG_DONE);
+}
+
+/*
+ * Open a screen in the selected mode and measure it
+ */
+static void measure_mode_screen(GfxScreenResults *res)
+{
+    struct DimensionInfo dims;
+    struct Screen *screen;
+    ULONG mode = select_gfx_mode();
+
+    if (mode == (ULONG)INVALID_ID || IntuitionBase->LibNode.lib_Version < 36) return;
+
+    if (!GetDisplayInfoData(NULL, (UBYTE *)&dims, sizeof(dims), DTAG_DIMS, mode)) return;
+
+    screen = OpenScreenTags(NULL,
+        SA_DisplayID, mode,
+        SA_Width, dims.Nominal.MaxX - dims.Nominal.MinX + 1,
+        SA_Height, dims.Nominal.MaxY - dims.Nominal.MinY + 1,
+        SA_Depth, dims.MaxDepth,
+        SA_Type, CUSTOMSCREEN,
+        SA_Quiet, TRUE,
+        SA_ShowTitle, FALSE,
+        TAG_DONE);
+    if (!screen) {
+        debug("  gfx: cannot open mode %08lx\n", mode);
+        return;
+    }
+
+    describe_screen(screen, res);
+
+    /* Without an explicit choice only a graphics card mode is of interest */
+    if (res->rtg || gfx_mode_id != (ULONG)INVALID_ID) {
+        measure_rastport(&screen->RastPort, 0, 0, res);
+    }
+
+    CloseScreen(screen);
+}
+
+/*
+ * Measure the current screen and the selected mode
+ */
+void run_gfx_benchmarks(void)
+{
+    struct Screen *screen = app->use_custom_screen ? app->screen : app->window->WScreen;
+
+    memset(&gfx_results, 0, sizeof(gfx_results));
+
+    if (!benchmark_timer_available()) return;
+
+    /* Draws over the software panel, the caller repaints it */
+    describe_screen(screen, &gfx_results.screen[GFX_SCREEN_CURRENT]);
+    measure_rastport(app->rp, SOFTWARE_PANEL_X + 4, SOFTWARE_PANEL_Y + 16,
+                     &gfx_results.screen[GFX_SCREEN_CURRENT]);
+
+    measure_mode_screen(&gfx_results.screen[GFX_SCREEN_MODE]);
+
+    gfx_results.valid = TRUE;
+}
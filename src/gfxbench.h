@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - graphics.library rendering benchmark header
+ */
+
+#ifndef GFXBENCH_H
+#define GFXBENCH_H
+
+#include "xsysinfo.h"
+
+/* Operations timed on every screen */
+#define GFX_OP_RECTFILL     0
+#define GFX_OP_BLIT         1       /* ClipBlit within the screen */
+#define GFX_OP_PIXELS       2       /* WriteChunkyPixels/WritePixelArray8 */
+#define GFX_OP_TEXT         3
+#define GFX_OP_SCROLL       4       /* ScrollRaster by one line */
+#define GFX_OPS             5
+
+/* Screens measured */
+#define GFX_SCREEN_CURRENT  0       /* The screen xSysInfo runs on */
+#define GFX_SCREEN_MODE     1       /* GFXMODE, or the best 640x480x8 RTG mode */
+#define GFX_SCREENS         2
+
+/* Test blocks, all within the software panel of the main view */
+#define GFX_BLOCK_W         64
+#define GFX_BLOCK_H         48
+#define GFX_SCROLL_W        256
+
+#define GFX_MIN_LOOPS       4
+#define GFX_MAX_LOOPS       (1UL << 16)
+#define GFX_MIN_US          20000   /* Minimum runtime per operation */
+
+/* Results for one screen */
+typedef struct {
+    ULONG ops_sec[GFX_OPS];     /* Calls per second, 0 if not supported */
+    ULONG bytes_sec[GFX_OPS];   /* Display memory touched per second */
+    ULONG mode_id;
+    UWORD width;
+    UWORD height;
+    UWORD depth;
+    BOOL rtg;                   /* Bitmap is not a native planar one */
+    BOOL valid;
+} GfxScreenResults;
+
+typedef struct {
+    GfxScreenResults screen[GFX_SCREENS];
+    BOOL valid;
+} GfxBenchResults;
+
+extern GfxBenchResults gfx_results;
+
+/* Function prototypes */
+void set_gfx_bench_mode(ULONG mode_id);     /* INVALID_ID picks a mode */
+void run_gfx_benchmarks(void);
+const char *get_gfx_op_name(ULONG op);
+
+#endif /* GFXBENCH_H */
@@ -9,6 +9,7 @@
 #include <stdio.h>
 #include <inttypes.h>
 
+#include <graphics/gfx.h>
 #include <graphics/rastport.h>
 #include <graphics/text.h>
 #include <devices/inputevent.h>
@@ -22,11 +23,15 @@
 #include "gui.h"
 #include "hardware.h"
 #include "benchmark.h"
+#include "history.h"
 #include "software.h"
 #include "memory.h"
 #include "drives.h"
 #include "boards.h"
 #include "scsi.h"
+#include "microbench.h"
+#include "gfxbench.h"
+#include "monitor.h"
 #include "print.h"
 #include "cache.h"
 #include "locale_str.h"
@@ -57,6 +62,9 @@ static void draw_header(void);
 static void draw_software_panel(void);
 static void draw_speed_panel(void);
 static void refresh_speed_bars(void);
+static void refresh_mem_speed_values(void);
+static const char *get_mem_speed_mode_label(void);
+static const char *get_hardware_type_label(void);
 static void draw_hardware_panel(void);
 static void draw_bottom_buttons(void);
 static void draw_cache_buttons(void);
@@ -65,6 +73,24 @@ static void update_software_list(void);
 static void update_hardware_text(void);
 static void refresh_all_cache_buttons(void);
 
+/* Main view areas and damage waiting for redraw_dirty() */
+static ULONG dirty_areas = 0;
+static struct Rectangle dirty_bounds;
+static BOOL dirty_bounds_valid = FALSE;
+
+static const struct {
+    ULONG area;
+    WORD x0, y0, x1, y1;
+} dirty_panels[] = {
+    { DIRTY_HEADER,   0, 0, SCREEN_WIDTH - 1, HEADER_HEIGHT - 1 },
+    { DIRTY_SOFTWARE, SOFTWARE_PANEL_X, SOFTWARE_PANEL_Y,
+                      SOFTWARE_PANEL_X + SOFTWARE_PANEL_W - 1, SOFTWARE_PANEL_Y + SOFTWARE_PANEL_H - 1 },
+    { DIRTY_SPEED,    SPEED_PANEL_X, SPEED_PANEL_Y,
+                      SPEED_PANEL_X + SPEED_PANEL_W - 1, SPEED_PANEL_Y + SPEED_PANEL_H - 1 },
+    { DIRTY_HARDWARE, HARDWARE_PANEL_X, HARDWARE_PANEL_Y,
+                      HARDWARE_PANEL_X + HARDWARE_PANEL_W - 1, HARDWARE_PANEL_Y + HARDWARE_PANEL_H - 1 },
+};
+
 void format_scaled(char *buffer, size_t size, ULONG value_x100, BOOL round)
 {
     ULONG integer_part = value_x100 / 100;
@@ -154,13 +180,26 @@ Button *find_button(ButtonID id)
 }
 
 /*
- * Set button pressed state and redraw it
+ * Set button pressed state, redraw_dirty() draws it if it changed
  */
 void set_button_pressed(ButtonID id, BOOL pressed)
 {
     Button *btn = find_button(id);
-    if (btn) {
+    if (btn && btn->pressed != pressed) {
         btn->pressed = pressed;
+        btn->dirty = TRUE;
+    }
+}
+
+/*
+ * Set button label, redraw_dirty() draws it if it changed
+ */
+void set_button_label(ButtonID id, const char *label)
+{
+    Button *btn = find_button(id);
+    if (btn && btn->label != label) {
+        btn->label = label;
+        btn->dirty = TRUE;
     }
 }
 
@@ -172,6 +211,8 @@ void redraw_button(ButtonID id)
     Button *btn = find_button(id);
     if (!btn) return;
 
+    btn->dirty = FALSE;
+
     /* For scroll arrows, use special drawing */
     if (id == BTN_SOFTWARE_UP) {
         draw_scroll_arrow(btn->x, btn->y, btn->width, btn->height,
@@ -179,7 +220,8 @@ void redraw_button(ButtonID id)
     } else if (id == BTN_SOFTWARE_DOWN) {
         draw_scroll_arrow(btn->x, btn->y, btn->width, btn->height,
                           FALSE, btn->pressed);
-    } else if (id == BTN_SOFTWARE_CYCLE || id == BTN_SCALE_TOGGLE || id == BTN_HARDWARE_CYCLE) {
+    } else if (id == BTN_SOFTWARE_CYCLE || id == BTN_SCALE_TOGGLE ||
+               id == BTN_HARDWARE_CYCLE || id == BTN_MEMSPEED_CYCLE) {
         draw_cycle_button(btn);
     } else {
         draw_button(btn);
@@ -201,7 +243,8 @@ void main_view_update_buttons(void)
     add_button(301, 176, 60, 11,
                get_string(MSG_BTN_BOARDS), BTN_BOARDS, TRUE);
     add_button(239, 187, 60, 11,
-               get_string(MSG_BTN_SPEED), BTN_SPEED, TRUE);
+               benchmark_task_running() ? get_string(MSG_BTN_STOP) : get_string(MSG_BTN_SPEED),
+               BTN_SPEED, TRUE);
     add_button(301, 187, 60, 11,
                get_string(MSG_BTN_PRINT), BTN_PRINT, TRUE);
 
@@ -235,14 +278,26 @@ void main_view_update_buttons(void)
                    get_string(MSG_SHRINK) : get_string(MSG_EXPAND),
                BTN_SCALE_TOGGLE, TRUE);
 
+    /* Memory speed mode cycle button (next to the CHIP/FAST/ROM header) */
+    add_button(SPEED_PANEL_X + 118, SPEED_PANEL_Y + 79, 56, 9,
+               get_mem_speed_mode_label(), BTN_MEMSPEED_CYCLE, TRUE);
+
      /* Hardware type cycle button */
     add_button(HARDWARE_PANEL_X + HARDWARE_PANEL_W - 80,
                HARDWARE_PANEL_Y + 2, 78, 12,
-               app->hardware_type == HARDWARE_STD ?
-                   get_string(MSG_HARDWARE_STD) :
-                   get_string(MSG_HARDWARE_EXT),
+               get_hardware_type_label(),
                BTN_HARDWARE_CYCLE, TRUE);
 
+    /* Instruction timing view, next to the hardware cycle button */
+    add_button(HARDWARE_PANEL_X + HARDWARE_PANEL_W - 124,
+               HARDWARE_PANEL_Y + 2, 42, 12,
+               get_string(MSG_BTN_CPU), BTN_CPU_VIEW, TRUE);
+
+    /* Live monitor, between the software title and the type cycle button */
+    add_button(SOFTWARE_PANEL_X + SOFTWARE_PANEL_W - 154,
+               SOFTWARE_PANEL_Y + 2, 52, 12,
+               get_string(MSG_BTN_LIVE), BTN_MON_VIEW, TRUE);
+
     /* Inline cache toggle buttons in hardware panel (right column) */
     /* Button shows only "ON"/"OFF"/"N/A", label is drawn separately */
     /* Cache rows use 11px spacing (8+3) so buttons don't overlap */
@@ -324,14 +379,33 @@ void main_view_handle_button(ButtonID id)
             switch_to_view(VIEW_BOARDS);
             break;
 
+        case BTN_CPU_VIEW:
+            switch_to_view(VIEW_CPU);
+            break;
+
+        case BTN_MON_VIEW:
+            switch_to_view(VIEW_MONITOR);
+            break;
+
         case BTN_SPEED:
-            show_status_overlay(get_string(MSG_MEASURING_SPEED));
-            run_benchmarks();
-            update_hardware_text();
-            hide_status_overlay();
+            if (benchmark_task_running()) {
+                cancel_benchmark_task();
+            } else if (start_benchmark_task(app->bench_port)) {
+                /* Results come in through handle_benchmark_progress() */
+                set_button_label(BTN_SPEED, get_string(MSG_BTN_STOP));
+                redraw_dirty();
+            } else {
+                show_status_overlay(get_string(MSG_MEASURING_SPEED));
+                run_benchmarks();
+                mark_dirty(DIRTY_SPEED | DIRTY_HARDWARE);
+                hide_status_overlay();
+                history_record_run();
+            }
             break;
 
         case BTN_PRINT:
+            /* The background suite is still filling in bench_results */
+            if (benchmark_task_running()) break;
             {
                 char filename[MAX_FILENAME_LEN];
                 strncpy(filename, DEFAULT_OUTPUT_FILE, sizeof(filename) - 1);
@@ -347,10 +421,21 @@ void main_view_handle_button(ButtonID id)
         case BTN_SOFTWARE_CYCLE:
             app->software_type = (app->software_type + 1) % 4;
             app->software_scroll = 0;
+            if (app->software_type == SOFTWARE_MMU) {
+                /* Speeds may have been measured since the last check */
+                analyze_mmu_mappings();
+            }
             update_software_list();
             break;
         case BTN_HARDWARE_CYCLE:
-            app->hardware_type = (app->hardware_type + 1) % 2;
+            app->hardware_type = (app->hardware_type + 1) % 6;
+            if (app->hardware_type == HARDWARE_GFX && !benchmark_task_running()) {
+                show_status_overlay(get_string(MSG_MEASURING_SPEED));
+                run_gfx_benchmarks();
+                /* The test patterns were drawn over the software panel */
+                mark_dirty(DIRTY_SOFTWARE);
+                hide_status_overlay();
+            }
             update_hardware_text();
             break;
 
@@ -360,32 +445,44 @@ void main_view_handle_button(ButtonID id)
             refresh_speed_bars();
             break;
 
+        case BTN_MEMSPEED_CYCLE:
+            app->mem_speed_mode = (app->mem_speed_mode + 1) % 3;
+            refresh_mem_speed_values();
+            break;
+
         case BTN_ICACHE:
+            /* The background suite runs with the CACR it started with */
+            if (benchmark_task_running()) break;
             toggle_icache();
             refresh_all_cache_buttons();
             break;
 
         case BTN_DCACHE:
+            if (benchmark_task_running()) break;
             toggle_dcache();
             refresh_all_cache_buttons();
             break;
 
         case BTN_IBURST:
+            if (benchmark_task_running()) break;
             toggle_iburst();
             refresh_all_cache_buttons();
             break;
 
         case BTN_DBURST:
+            if (benchmark_task_running()) break;
             toggle_dburst();
             refresh_all_cache_buttons();
             break;
 
         case BTN_CBACK:
+            if (benchmark_task_running()) break;
             toggle_copyback();
             refresh_all_cache_buttons();
             break;
 
         case BTN_SUPER_SCALAR:
+            if (benchmark_task_running()) break;
             toggle_super_scalar();
             refresh_all_cache_buttons();
             break;
@@ -448,6 +545,14 @@ void update_button_states(void)
         case VIEW_SCSI:
             scsi_view_update_buttons();
             break;
+
+        case VIEW_CPU:
+            cpu_view_update_buttons();
+            break;
+
+        case VIEW_MONITOR:
+            monitor_view_update_buttons();
+            break;
     }
 }
 
@@ -458,6 +563,10 @@ void redraw_current_view(void)
 {
     struct RastPort *rp = app->rp;
 
+    /* Everything is repainted */
+    dirty_areas = 0;
+    dirty_bounds_valid = FALSE;
+
     /* Clear background */
     SetAPen(rp, COLOR_BACKGROUND);
     RectFill(rp, 0, 0, SCREEN_WIDTH - 1, app->screen_height - 1);
@@ -480,6 +589,95 @@ void redraw_current_view(void)
         case VIEW_SCSI:
             draw_scsi_view();
             break;
+        case VIEW_CPU:
+            draw_cpu_view();
+            break;
+        case VIEW_MONITOR:
+            draw_monitor_view();
+            break;
+    }
+}
+
+/*
+ * Mark main view areas for the next redraw_dirty()
+ */
+void mark_dirty(ULONG areas)
+{
+    dirty_areas |= areas;
+}
+
+/*
+ * Mark a damaged rectangle, e.g. from the layer's damage list. The main
+ * view repaints the background under it and every panel it touches
+ */
+void mark_dirty_rect(WORD x0, WORD y0, WORD x1, WORD y1)
+{
+    int i;
+
+    if (app->current_view != VIEW_MAIN) {
+        dirty_areas |= DIRTY_VIEW;
+        return;
+    }
+
+    if (!dirty_bounds_valid) {
+        dirty_bounds.MinX = x0;
+        dirty_bounds.MinY = y0;
+        dirty_bounds.MaxX = x1;
+        dirty_bounds.MaxY = y1;
+        dirty_bounds_valid = TRUE;
+    } else {
+        if (x0 < dirty_bounds.MinX) dirty_bounds.MinX = x0;
+        if (y0 < dirty_bounds.MinY) dirty_bounds.MinY = y0;
+        if (x1 > dirty_bounds.MaxX) dirty_bounds.MaxX = x1;
+        if (y1 > dirty_bounds.MaxY) dirty_bounds.MaxY = y1;
+    }
+
+    for (i = 0; i < (int)(sizeof(dirty_panels) / sizeof(dirty_panels[0])); i++) {
+        if (dirty_bounds.MinX <= dirty_panels[i].x1 && dirty_bounds.MaxX >= dirty_panels[i].x0 &&
+            dirty_bounds.MinY <= dirty_panels[i].y1 && dirty_bounds.MaxY >= dirty_panels[i].y0) {
+            dirty_areas |= dirty_panels[i].area;
+        }
+    }
+}
+
+/*
+ * Repaint what was marked dirty and the buttons that changed
+ */
+void redraw_dirty(void)
+{
+    struct RastPort *rp = app->rp;
+    ULONG areas = dirty_areas;
+    int i;
+
+    dirty_areas = 0;
+
+    if ((areas & DIRTY_VIEW) || (areas != 0 && app->current_view != VIEW_MAIN)) {
+        redraw_current_view();
+        return;
+    }
+
+    /* Gaps between the panels */
+    if (dirty_bounds_valid) {
+        SetAPen(rp, COLOR_BACKGROUND);
+        RectFill(rp, dirty_bounds.MinX, dirty_bounds.MinY,
+                 dirty_bounds.MaxX, dirty_bounds.MaxY);
+        dirty_bounds_valid = FALSE;
+    }
+
+    if (areas & DIRTY_HEADER) draw_header();
+    if (areas & DIRTY_SOFTWARE) draw_software_panel();
+    if (areas & DIRTY_SPEED) {
+        draw_speed_panel();
+        /* The panel background covers the bottom buttons */
+        draw_bottom_buttons();
+    }
+    if (areas & DIRTY_HARDWARE) draw_hardware_panel();
+
+    /* Single buttons */
+    for (i = 0; i < num_buttons; i++) {
+        if (buttons[i].dirty && buttons[i].id != BTN_SOFTWARE_SCROLLBAR) {
+            redraw_button(buttons[i].id);
+        }
     }
 }
 
@@ -588,6 +786,8 @@ void draw_button(Button *btn)
 
     if (!btn) return;
 
+    btn->dirty = FALSE;
+
     /* Button background */
     SetAPen(rp, btn->enabled ? COLOR_PANEL_BG : COLOR_BUTTON_DARK);
     RectFill(rp, btn->x, btn->y, btn->x + btn->width - 1, btn->y + btn->height - 1);
@@ -621,6 +821,8 @@ void draw_cycle_button(Button *btn)
 
     if (!btn) return;
 
+    btn->dirty = FALSE;
+
     /* Button background - darker like an input field */
     SetAPen(rp, COLOR_BACKGROUND);
     RectFill(rp, btn->x, btn->y, btn->x + btn->width - 1, btn->y + btn->height - 1);
@@ -838,6 +1040,11 @@ static void draw_software_panel(void)
         draw_cycle_button(cycle_btn);
     }
 
+    Button *mon_btn = find_button(BTN_MON_VIEW);
+    if (mon_btn) {
+        draw_button(mon_btn);
+    }
+
     update_software_list();
 }
 
@@ -849,9 +1056,7 @@ static void update_hardware_text(void)
 {
     Button *hw_cycle_btn = find_button(BTN_HARDWARE_CYCLE);
     if (hw_cycle_btn) {
-        const char *new_hw_label = app->hardware_type == HARDWARE_STD ?
-                                    get_string(MSG_HARDWARE_STD) :
-                                    get_string(MSG_HARDWARE_EXT);
+        const char *new_hw_label = get_hardware_type_label();
         if (hw_cycle_btn->label != new_hw_label) {
             hw_cycle_btn->label = new_hw_label;
             draw_cycle_button(hw_cycle_btn);
@@ -873,6 +1078,7 @@ static void update_software_list(void)
     WORD list_top = SOFTWARE_PANEL_Y + 24;
     WORD list_height = SOFTWARE_LIST_LINES * 8;
     char buffer[128];
+    char mapping[128];
 
     /* Get current list */
     switch (app->software_type) {
@@ -946,11 +1152,13 @@ static void update_software_list(void)
         SoftwareEntry *entry = &list->entries[i];
 
         if (app->software_type == SOFTWARE_MMU) {
-            if (strlen(entry->name) > 49) {
-                entry->name[48] = '+';
-                entry->name[49] = '\0';
+            /* Mappings are only formatted for the rows shown */
+            const char *name = get_software_entry_name(entry, mapping, sizeof(mapping));
+
+            snprintf(buffer, 50, "%-49s", name);
+            if (strlen(name) > 49) {
+                buffer[48] = '+';
             }
-            snprintf(buffer, 50, "%-49s", entry->name);
             SetAPen(rp, COLOR_TEXT);
             Move(rp, SOFTWARE_PANEL_X + 4, y);
             TightText(rp, SOFTWARE_PANEL_X + 4, y, (CONST_STRPTR)buffer, -1, 8);
@@ -1116,6 +1324,26 @@ static void draw_speed_panel(void)
     draw_panel(SPEED_PANEL_X + 1, SPEED_PANEL_Y + 1,
                SPEED_PANEL_W - 2, 14, get_string(MSG_SPEED_COMPARISONS));
 
+    /* Change against earlier runs on this machine, next to the title */
+    if (bench_results.benchmarks_valid) {
+        const HistoryEntry *prev = history_get_previous();
+        const HistoryEntry *best = history_get_best();
+        char prev_str[12], best_str[12];
+
+        if (prev && best) {
+            format_history_delta(prev_str, sizeof(prev_str),
+                                 bench_results.dhrystones, prev->dhrystones);
+            format_history_delta(best_str, sizeof(best_str),
+                                 bench_results.dhrystones, best->dhrystones);
+            snprintf(buffer, sizeof(buffer), "%s %s %s %s",
+                     get_string(MSG_HIST_PREV), prev_str,
+                     get_string(MSG_HIST_BEST), best_str);
+            SetAPen(rp, COLOR_HIGHLIGHT);
+            SetBPen(rp, COLOR_PANEL_BG);
+            TightText(rp, SPEED_PANEL_X + 152, SPEED_PANEL_Y + 11, (CONST_STRPTR)buffer, -1, 4);
+        }
+    }
+
     /* Draw "You" entry first */
     y = SPEED_PANEL_Y + 22;
     SetAPen(rp, COLOR_TEXT);
@@ -1125,7 +1353,9 @@ static void draw_speed_panel(void)
     Text(rp, (CONST_STRPTR)buffer, strlen(buffer));
 
     if (bench_results.benchmarks_valid) {
-        snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)bench_results.dhrystones);
+        /* Mark a noisy repeat-mode result */
+        snprintf(buffer, sizeof(buffer), "%lu%s", (unsigned long)bench_results.dhrystones,
+                 bench_results.dhry_stats.unstable ? "*" : "");
     } else {
         snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_NA));
     }
@@ -1183,7 +1413,8 @@ static void draw_speed_panel(void)
     snprintf(buffer, sizeof(buffer), "%s ",
                  get_string(MSG_MFLOPS));
     TightText(rp, SPEED_PANEL_X + 84, y, (CONST_STRPTR)buffer, -1, 4);
-    if (hw_info.fpu_type != FPU_NONE && bench_results.benchmarks_valid && hw_info.fpu_enabled) {
+    if (hw_info.fpu_type != FPU_NONE && bench_results.benchmarks_valid && hw_info.fpu_enabled &&
+        bench_results.mflops > 0) {
         char scaled[16];
         format_scaled(scaled, sizeof(scaled), bench_results.mflops, TRUE);
         snprintf(buffer, sizeof(buffer), "%s", scaled);
@@ -1200,37 +1431,358 @@ static void draw_speed_panel(void)
     snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_MEM_SPEED_HEADER));
     TightText(rp, SPEED_PANEL_X + 4, y, (CONST_STRPTR)buffer, -1, 4);
 
-    /* Memory speed values */
-    y += 8;
-    {
-        char chip_str[8], fast_str[8], rom_str[8];
+    /* Memory speed values (and read/write/copy cycle button) */
+    refresh_mem_speed_values();
+}
 
-        /* Format CHIP speed in MB/s */
-        if (bench_results.benchmarks_valid && bench_results.chip_speed > 0) {
-            format_scaled(chip_str, sizeof(chip_str), bench_results.chip_speed / 10000, TRUE);
+/*
+ * Handle a progress message from the background benchmark: fill in
+ * the speed panel as results arrive, the hardware panel when it is done
+ */
+void handle_benchmark_progress(BenchProgressMsg *progress)
+{
+    BOOL finished = benchmark_task_finished(progress);
+
+    if (finished && !progress->cancelled) {
+        history_record_run();
+    }
+
+    if (app->current_view == VIEW_MAIN) {
+        if (finished) {
+            /* Clock speeds are measured last */
+            set_button_label(BTN_SPEED, get_string(MSG_BTN_SPEED));
+            mark_dirty(DIRTY_SPEED | DIRTY_HARDWARE);
         } else {
-            snprintf(chip_str, sizeof(chip_str), "%s", get_string(MSG_NA));
+            mark_dirty(DIRTY_SPEED);
         }
+        redraw_dirty();
+    }
+
+    /* The benchmark task waits for this before it continues */
+    if (!finished) {
+        ReplyMsg(&progress->msg);
+    }
+}
+
+/*
+ * Label for the memory speed mode cycle button
+ */
+static const char *get_mem_speed_mode_label(void)
+{
+    switch (app->mem_speed_mode) {
+        case MEMSPEED_WRITE:
+            return get_string(MSG_MEM_WRITE);
+        case MEMSPEED_COPY:
+            return get_string(MSG_MEM_COPY);
+        case MEMSPEED_READ:
+        default:
+            return get_string(MSG_MEM_READ);
+    }
+}
+
+/*
+ * Refresh memory speed line only (for mode cycle without full redraw)
+ */
+static void refresh_mem_speed_values(void)
+{
+    struct RastPort *rp = app->rp;
+    WORD y = SPEED_PANEL_Y + 94;
+    char buffer[64];
+    char chip_str[8], fast_str[8], rom_str[8];
+    ULONG chip_speed, fast_speed, rom_speed;
+
+    /* Update mode cycle button */
+    Button *mode_btn = find_button(BTN_MEMSPEED_CYCLE);
+    if (mode_btn) {
+        mode_btn->label = get_mem_speed_mode_label();
+        draw_cycle_button(mode_btn);
+    }
+
+    switch (app->mem_speed_mode) {
+        case MEMSPEED_WRITE:
+            chip_speed = bench_results.chip_write_speed;
+            fast_speed = bench_results.fast_write_speed;
+            rom_speed = 0;
+            break;
+        case MEMSPEED_COPY:
+            chip_speed = bench_results.chip_copy_speed;
+            fast_speed = bench_results.fast_copy_speed;
+            rom_speed = 0;
+            break;
+        case MEMSPEED_READ:
+        default:
+            chip_speed = bench_results.chip_speed;
+            fast_speed = bench_results.fast_speed;
+            rom_speed = bench_results.rom_speed;
+            break;
+    }
+
+    /* Format CHIP speed in MB/s */
+    if (bench_results.benchmarks_valid && chip_speed > 0) {
+        format_scaled(chip_str, sizeof(chip_str), chip_speed / 10000, TRUE);
+    } else {
+        snprintf(chip_str, sizeof(chip_str), "%s", get_string(MSG_NA));
+    }
+
+    /* Format FAST speed in MB/s or N/A */
+    if (bench_results.benchmarks_valid && fast_speed > 0) {
+        format_scaled(fast_str, sizeof(fast_str), fast_speed / 10000, TRUE);
+    } else {
+        snprintf(fast_str, sizeof(fast_str), "%s", get_string(MSG_NA));
+    }
 
-        /* Format FAST speed in MB/s or N/A */
-        if (bench_results.benchmarks_valid && bench_results.fast_speed > 0) {
-            format_scaled(fast_str, sizeof(fast_str), bench_results.fast_speed / 10000, TRUE);
+    /* Format ROM speed in MB/s (read only) */
+    if (bench_results.benchmarks_valid && rom_speed > 0) {
+        format_scaled(rom_str, sizeof(rom_str), rom_speed / 10000, TRUE);
+    } else {
+        snprintf(rom_str, sizeof(rom_str), "%s", get_string(MSG_NA));
+    }
+
+    snprintf(buffer, sizeof(buffer), "%-6s %-6s %-6s  %s",
+             chip_str, fast_str, rom_str, get_string(MSG_MEM_SPEED_UNIT));
+
+    /* Clear previous values (left of the bottom buttons) */
+    SetAPen(rp, COLOR_PANEL_BG);
+    RectFill(rp, SPEED_PANEL_X + 2, y - 6, SPEED_PANEL_X + 175, y + 1);
+
+    SetAPen(rp, COLOR_HIGHLIGHT);
+    SetBPen(rp, COLOR_PANEL_BG);
+    TightText(rp, SPEED_PANEL_X + 4, y, (CONST_STRPTR)buffer, -1, 4);
+}
+
+/*
+ * Label for the hardware type cycle button
+ */
+static const char *get_hardware_type_label(void)
+{
+    switch (app->hardware_type) {
+        case HARDWARE_EXT:
+            return get_string(MSG_HARDWARE_EXT);
+        case HARDWARE_FPU:
+            return get_string(MSG_HARDWARE_FPU);
+        case HARDWARE_ROM:
+            return get_string(MSG_HARDWARE_ROM);
+        case HARDWARE_GFX:
+            return get_string(MSG_HARDWARE_GFX);
+        case HARDWARE_JIT:
+            return get_string(MSG_HARDWARE_JIT);
+        case HARDWARE_STD:
+        default:
+            return get_string(MSG_HARDWARE_STD);
+    }
+}
+
+/*
+ * Draw the per-operation FPU breakdown (hardware panel, FPU OPS mode)
+ */
+static void draw_fpu_suite_info(WORD y)
+{
+    const FpuSuite *suite = &bench_results.fpu_suite;
+    char buffer[32];
+    char mops_str[16];
+    ULONG op;
+
+    draw_label_value(HARDWARE_PANEL_X + 4, y,
+                     get_string(MSG_FPU_SUITE), NULL, 120);
+    y += 12;
+
+    for (op = 0; op < FPU_OPS; op++) {
+        if (!bench_results.benchmarks_valid || !suite->valid || suite->mops[op] == 0) {
+            snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_NA));
         } else {
-            snprintf(fast_str, sizeof(fast_str), "%s", get_string(MSG_NA));
+            format_scaled(mops_str, sizeof(mops_str), suite->mops[op], FALSE);
+            snprintf(buffer, sizeof(buffer), "%7s %s %6lu NS%s", mops_str,
+                     op == FPU_OP_DAXPY ? get_string(MSG_MFLOPS) : get_string(MSG_MOPS),
+                     (unsigned long)suite->ns_per_op[op],
+                     (suite->emulated && op >= FPU_OP_FSIN && op <= FPU_OP_FETOX) ? " *" : "");
         }
+        draw_label_value(HARDWARE_PANEL_X + 4, y,
+                         get_fpu_op_name((FpuOp)op), buffer, 56);
+        y += 10;
+    }
 
-        /* Format ROM speed in MB/s */
-        if (bench_results.benchmarks_valid && bench_results.rom_speed > 0) {
-            format_scaled(rom_str, sizeof(rom_str), bench_results.rom_speed / 10000, TRUE);
-        } else {
-            snprintf(rom_str, sizeof(rom_str), "%s", get_string(MSG_NA));
+    if (suite->valid && suite->emulated) {
+        y += 2;
+        snprintf(buffer, sizeof(buffer), "* %s", get_string(MSG_FPSP));
+        draw_label_value(HARDWARE_PANEL_X + 4, y, buffer, NULL, 0);
+    }
+}
+
+/*
+ * Draw Kickstart ROM shadowing and call overhead (hardware panel, ROM mode)
+ */
+static void draw_rom_shadow_info(WORD y)
+{
+    char buffer[48];
+    char speed_str[16];
+    const char *state;
+
+    draw_label_value(HARDWARE_PANEL_X + 4, y,
+                     get_string(MSG_ROM_SHADOW), NULL, 120);
+    y += 12;
+
+    snprintf(buffer, sizeof(buffer), "%u.%u (%luK)",
+             (unsigned)hw_info.kickstart_version, (unsigned)hw_info.kickstart_revision,
+             (unsigned long)hw_info.kickstart_size);
+    draw_label_value(HARDWARE_PANEL_X + 4, y, get_string(MSG_ROM_KICKSTART), buffer, 96);
+    y += 10;
+
+    if (!bench_results.benchmarks_valid || bench_results.rom_shadow == ROM_SHADOW_UNKNOWN) {
+        draw_label_value(HARDWARE_PANEL_X + 4, y, get_string(MSG_ROM_STATE),
+                         get_string(MSG_NA), 96);
+        return;
+    }
+
+    format_scaled(speed_str, sizeof(speed_str), bench_results.rom_speed / 10000, TRUE);
+    snprintf(buffer, sizeof(buffer), "%s MB/S", speed_str);
+    draw_label_value(HARDWARE_PANEL_X + 4, y, get_string(MSG_ROM_READ), buffer, 96);
+    y += 10;
+
+    if (bench_results.fast_speed > 0) {
+        format_scaled(speed_str, sizeof(speed_str), bench_results.fast_speed / 10000, TRUE);
+        snprintf(buffer, sizeof(buffer), "%s MB/S", speed_str);
+    } else {
+        snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_NA));
+    }
+    draw_label_value(HARDWARE_PANEL_X + 4, y, get_string(MSG_ROM_FAST_READ), buffer, 96);
+    y += 10;
+
+    switch (bench_results.rom_shadow) {
+        case ROM_SHADOW_MMU:
+            state = get_string(MSG_ROM_SHADOW_MMU);
+            break;
+        case ROM_SHADOW_FAST:
+            state = get_string(MSG_ROM_SHADOW_FAST);
+            break;
+        default:
+            state = get_string(MSG_ROM_NOT_SHADOWED);
+            break;
+    }
+    draw_label_value(HARDWARE_PANEL_X + 4, y, get_string(MSG_ROM_STATE), state, 96);
+    y += 10;
+
+    format_scaled(speed_str, sizeof(speed_str), bench_results.rom_call_ns_x100, FALSE);
+    snprintf(buffer, sizeof(buffer), "%s %s%s", speed_str, get_string(MSG_NS),
+             bench_results.rom_call_in_rom ? "" : " *");
+    draw_label_value(HARDWARE_PANEL_X + 4, y, get_string(MSG_ROM_CALL), buffer, 96);
+    y += 10;
+
+    if (!bench_results.rom_call_in_rom) {
+        snprintf(buffer, sizeof(buffer), "* %s", get_string(MSG_ROM_CALL_PATCHED));
+        draw_label_value(HARDWARE_PANEL_X + 4, y, buffer, NULL, 0);
+        y += 10;
+    }
+
+    if (bench_results.maprom_hint) {
+        y += 2;
+        SetAPen(app->rp, COLOR_HIGHLIGHT);
+        SetBPen(app->rp, COLOR_PANEL_BG);
+        Move(app->rp, HARDWARE_PANEL_X + 4, y);
+        Text(app->rp, (CONST_STRPTR)get_string(MSG_ROM_MAPROM_HINT),
+             strlen(get_string(MSG_ROM_MAPROM_HINT)));
+    }
+}
+
+/*
+ * Draw Emu68 cold vs. warm runs and JIT flush cost (hardware panel, JIT mode)
+ */
+static void draw_jit_bench_info(WORD y)
+{
+    const JitResults *jit = &bench_results.jit;
+    char buffer[48];
+    char cold_str[16], warm_str[16];
+
+    draw_label_value(HARDWARE_PANEL_X + 4, y,
+                     get_string(MSG_JIT_TITLE), NULL, 120);
+    y += 12;
+
+    if (!bench_results.benchmarks_valid || !jit->valid) {
+        draw_label_value(HARDWARE_PANEL_X + 4, y,
+                         hw_info.cpu_type == CPU_EMU ? get_string(MSG_NA) :
+                                                       get_string(MSG_JIT_NOT_EMU68),
+                         NULL, 0);
+        return;
+    }
+
+    snprintf(buffer, sizeof(buffer), "%lu / %lu",
+             (unsigned long)jit->dhry_cold, (unsigned long)jit->dhry_warm);
+    draw_label_value(HARDWARE_PANEL_X + 4, y, get_string(MSG_JIT_DHRY), buffer, 96);
+    y += 10;
+
+    if (jit->mflops_warm > 0) {
+        format_scaled(cold_str, sizeof(cold_str), jit->mflops_cold, FALSE);
+        format_scaled(warm_str, sizeof(warm_str), jit->mflops_warm, FALSE);
+        snprintf(buffer, sizeof(buffer), "%s / %s", cold_str, warm_str);
+    } else {
+        snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_NA));
+    }
+    draw_label_value(HARDWARE_PANEL_X + 4, y, get_string(MSG_JIT_MFLOPS), buffer, 96);
+    y += 10;
+
+    format_scaled(cold_str, sizeof(cold_str), jit->mem_cold / 10000, TRUE);
+    format_scaled(warm_str, sizeof(warm_str), jit->mem_warm / 10000, TRUE);
+    snprintf(buffer, sizeof(buffer), "%s / %s MB/S", cold_str, warm_str);
+    draw_label_value(HARDWARE_PANEL_X + 4, y, get_string(MSG_JIT_MEM), buffer, 96);
+    y += 10;
+
+    format_scaled(cold_str, sizeof(cold_str), jit->flush_us_x100, FALSE);
+    snprintf(buffer, sizeof(buffer), "%s US", cold_str);
+    draw_label_value(HARDWARE_PANEL_X + 4, y, get_string(MSG_JIT_FLUSH), buffer, 96);
+    y += 10;
+
+    snprintf(buffer, sizeof(buffer), "%lu US", (unsigned long)jit->retranslate_us);
+    draw_label_value(HARDWARE_PANEL_X + 4, y, get_string(MSG_JIT_RETRANSLATE), buffer, 96);
+}
+
+/*
+ * Draw graphics throughput per screen (hardware panel, GFX OPS mode)
+ */
+static void draw_gfx_bench_info(WORD y)
+{
+    char buffer[48];
+    char mb_str[16];
+    ULONG s, op;
+
+    draw_label_value(HARDWARE_PANEL_X + 4, y,
+                     get_string(MSG_GFX_SUITE), NULL, 120);
+    y += 12;
+
+    if (!gfx_results.valid) {
+        draw_label_value(HARDWARE_PANEL_X + 4, y, get_string(MSG_NA), NULL, 0);
+        return;
+    }
+
+    for (s = 0; s < GFX_SCREENS; s++) {
+        const GfxScreenResults *res = &gfx_results.screen[s];
+
+        if (!res->valid) {
+            if (s == GFX_SCREEN_MODE) {
+                draw_label_value(HARDWARE_PANEL_X + 4, y,
+                                 get_string(MSG_GFX_NO_MODE), NULL, 0);
+            }
+            continue;
         }
 
-        snprintf(buffer, sizeof(buffer), "%-6s %-6s %-6s  %s",
-                 chip_str, fast_str, rom_str, get_string(MSG_MEM_SPEED_UNIT));
+        snprintf(buffer, sizeof(buffer), "%s %ux%ux%u%s",
+                 s == GFX_SCREEN_CURRENT ? get_string(MSG_GFX_CURRENT) : get_string(MSG_GFX_MODE),
+                 (unsigned)res->width, (unsigned)res->height, (unsigned)res->depth,
+                 res->rtg ? " RTG" : "");
+        draw_label_value(HARDWARE_PANEL_X + 4, y, buffer, NULL, 0);
+        y += 10;
+
+        for (op = 0; op < GFX_OPS; op++) {
+            if (res->ops_sec[op] == 0) {
+                snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_NA));
+            } else {
+                format_scaled(mb_str, sizeof(mb_str), res->bytes_sec[op] / 10000, FALSE);
+                snprintf(buffer, sizeof(buffer), "%6lu/S %6s MB/S",
+                         (unsigned long)res->ops_sec[op], mb_str);
+            }
+            draw_label_value(HARDWARE_PANEL_X + 12, y, get_gfx_op_name(op), buffer, 72);
+            y += 9;
+        }
+        y += 4;
     }
-    SetAPen(rp, COLOR_HIGHLIGHT);
-    TightText(rp, SPEED_PANEL_X + 4, y, (CONST_STRPTR)buffer, -1, 4);
 }
 
 /*
@@ -1254,6 +1806,10 @@ static void draw_hardware_panel(void)
     if (hw_cycle_btn) {
         draw_cycle_button(hw_cycle_btn);
     }
+    Button *cpu_btn = find_button(BTN_CPU_VIEW);
+    if (cpu_btn) {
+        draw_button(cpu_btn);
+    }
 
     y = HARDWARE_PANEL_Y + 24;
     if (app->hardware_type == HARDWARE_STD) {
@@ -1539,6 +2095,14 @@ static void draw_hardware_panel(void)
                          get_string(MSG_CARD_SLOT), hw_info.card_slot_string, 90);
         /* Cache toggle buttons are drawn by draw_cache_buttons() */
         draw_cache_buttons();
+    } else if (app->hardware_type == HARDWARE_FPU) {
+        draw_fpu_suite_info(y);
+    } else if (app->hardware_type == HARDWARE_ROM) {
+        draw_rom_shadow_info(y);
+    } else if (app->hardware_type == HARDWARE_GFX) {
+        draw_gfx_bench_info(y);
+    } else if (app->hardware_type == HARDWARE_JIT) {
+        draw_jit_bench_info(y);
     }else { //extended hw-info
         draw_label_value(HARDWARE_PANEL_X + 4, y,
                          get_string(MSG_EXT_INFO), NULL, 120);
@@ -1729,8 +2293,8 @@ static void refresh_all_cache_buttons(void)
     set_button_pressed(BTN_CBACK, hw_info.copyback_enabled);
     set_button_pressed(BTN_SUPER_SCALAR, hw_info.super_scalar_enabled);
 
-    /* Redraw all cache buttons */
-    draw_cache_buttons();
+    /* Redraw the cache buttons that changed */
+    redraw_dirty();
 }
 
 /*
@@ -1777,6 +2341,13 @@ void handle_button_press(ButtonID btn_id)
         case VIEW_SCSI:
             scsi_view_handle_button(btn_id);
             break;
+
+        case VIEW_CPU:
+            cpu_view_handle_button(btn_id);
+            break;
+        case VIEW_MONITOR:
+            monitor_view_handle_button(btn_id);
+            break;
     }
 }
 
@@ -1841,18 +2412,46 @@ void handle_scrollbar_click(WORD mx __attribute__((unused)), WORD my)
  */
 void switch_to_view(ViewMode view)
 {
+    /* The sampler only runs while its graphs are shown */
+    if (app->current_view == VIEW_MONITOR && view != VIEW_MONITOR) {
+        stop_monitor();
+    }
+
     app->current_view = view;
 
     /* Reset view-specific state */
     switch (view) {
         case VIEW_MEMORY:
+            ensure_enumerated(ENUM_MEMORY);
             app->memory_region_index = 0;
+            app->memory_show_sweep = FALSE;
+            app->memory_show_frag = FALSE;
+            app->memory_show_dma = FALSE;
             break;
         case VIEW_DRIVES:
+            ensure_enumerated(ENUM_DRIVES);
             app->selected_drive = drive_list.count > 0 ? 0 : -1;
+            app->drives_show_matrix = FALSE;
+            app->drives_show_fs = FALSE;
+            break;
+        case VIEW_SCSI:
+            app->scsi_show_speed = FALSE;
+            break;
+        case VIEW_CPU:
+            app->cpu_show_cache_matrix = FALSE;
+            app->cpu_show_blitter = FALSE;
+            app->cpu_show_latency = FALSE;
+            break;
+        case VIEW_MONITOR:
+            ensure_enumerated(ENUM_MEMORY);
+            app->monitor_region = 0;
+            start_monitor();
             break;
         case VIEW_BOARDS:
+            ensure_enumerated(ENUM_BOARDS);
+            ensure_enumerated(ENUM_MEMORY);
             app->board_scroll = 0;
+            app->selected_board = board_list.count > 0 ? 0 : -1;
             break;
         default:
             break;
@@ -1868,6 +2467,77 @@ static UWORD blank_pointer[] = {
     0x0000, 0x0000   /* Reserved */
 };
 
+/* Main view contents under the status overlay */
+static struct BitMap *overlay_bm = NULL;
+static struct BitMap overlay_planar;
+static struct RastPort overlay_rp;
+static WORD overlay_x, overlay_y, overlay_w, overlay_h;
+
+/*
+ * Free the saved overlay background
+ */
+static void free_overlay_background(void)
+{
+    int i;
+
+    if (!overlay_bm) return;
+
+    if (overlay_bm == &overlay_planar) {
+        for (i = 0; i < overlay_planar.Depth; i++) {
+            if (overlay_planar.Planes[i]) {
+                FreeRaster(overlay_planar.Planes[i], overlay_w, overlay_h);
+                overlay_planar.Planes[i] = NULL;
+            }
+        }
+    }
+#ifndef __KICK13__
+    else {
+        FreeBitMap(overlay_bm);
+    }
+#endif
+    overlay_bm = NULL;
+}
+
+/*
+ * Copy the area under the overlay into an offscreen bitmap
+ */
+static void save_overlay_background(WORD x, WORD y, WORD w, WORD h)
+{
+    struct BitMap *screen_bm = app->rp->BitMap;
+    int i;
+
+    overlay_x = x;
+    overlay_y = y;
+    overlay_w = w;
+    overlay_h = h;
+
+#ifndef __KICK13__
+    if (GfxBase->LibNode.lib_Version >= 39) {
+        /* Friend bitmap, so RTG screens get a matching format */
+        overlay_bm = AllocBitMap(w, h, GetBitMapAttr(screen_bm, BMA_DEPTH), 0, screen_bm);
+    } else
+#endif
+    {
+        /* InitBitMap() leaves Planes[] alone, a failed AllocRaster()
+         * must not free the previous overlay's planes again */
+        memset(&overlay_planar, 0, sizeof(overlay_planar));
+        InitBitMap(&overlay_planar, screen_bm->Depth, w, h);
+        overlay_bm = &overlay_planar;
+        for (i = 0; i < overlay_planar.Depth; i++) {
+            overlay_planar.Planes[i] = AllocRaster(w, h);
+            if (!overlay_planar.Planes[i]) {
+                free_overlay_background();
+                return;
+            }
+        }
+    }
+    if (!overlay_bm) return;
+
+    InitRastPort(&overlay_rp);
+    overlay_rp.BitMap = overlay_bm;
+    ClipBlit(app->rp, x, y, &overlay_rp, 0, 0, w, h, 0xC0);
+}
+
 /*
  * Show status overlay (red background, centered message, no interaction)
  */
@@ -1882,6 +2552,11 @@ void show_status_overlay(const char *message)
     WORD dialog_x = (SCREEN_WIDTH - dialog_w) / 2;
     WORD dialog_y = (app->screen_height - dialog_h) / 2;
 
+    /* Main view callers only mark what changed, see hide_status_overlay() */
+    if (app->current_view == VIEW_MAIN) {
+        save_overlay_background(dialog_x, dialog_y, dialog_w, dialog_h);
+    }
+
     /* Hide mouse pointer with blank sprite */
     SetPointer(app->window, blank_pointer, 1, 1, 0, 0);
 
@@ -1917,8 +2592,19 @@ void hide_status_overlay(void)
     /* Restore mouse pointer */
     ClearPointer(app->window);
 
-    /* Redraw the main view to restore the area */
-    redraw_current_view();
+    /*
+     * Main view: put back what was under the overlay and repaint the
+     * areas the caller marked dirty. Other views redraw as a whole
+     */
+    if (overlay_bm && app->current_view == VIEW_MAIN) {
+        ClipBlit(&overlay_rp, 0, 0, app->rp, overlay_x, overlay_y,
+                 overlay_w, overlay_h, 0xC0);
+        free_overlay_background();
+        redraw_dirty();
+    } else {
+        free_overlay_background();
+        redraw_current_view();
+    }
 }
 
 /*
@@ -10,6 +10,7 @@
 
 #include "xsysinfo.h"
 #include "drives.h"
+#include "benchmark.h"
 
 /* Button IDs */
 typedef enum {
@@ -28,6 +29,9 @@ typedef enum {
     BTN_SOFTWARE_DOWN,      /* Software list scroll down */
     BTN_SOFTWARE_SCROLLBAR, /* Software list scroll bar */
     BTN_SCALE_TOGGLE,       /* Expand/Shrink */
+    BTN_MEMSPEED_CYCLE,     /* Read/Write/Copy memory speeds */
+    BTN_CPU_VIEW,           /* Instruction timing view */
+    BTN_MON_VIEW,           /* Live system monitor */
 
 
     /* Cache toggle buttons (inline in hardware panel) */
@@ -43,23 +47,51 @@ typedef enum {
     BTN_MEM_COUNTER,    /* Display-only counter between prev/next */
     BTN_MEM_NEXT,
     BTN_MEM_SPEED,
+    BTN_MEM_SWEEP,      /* Cache-size sweep / back to info */
+    BTN_MEM_FRAG,       /* Free-list fragmentation / back to info */
+    BTN_MEM_DMA,        /* CHIP DMA contention / back to info */
     BTN_MEM_EXIT,
 
     /* Drives view buttons */
     BTN_DRV_EXIT,
     BTN_DRV_SCSI,
     BTN_DRV_SPEED,
+    BTN_DRV_QUEUE,
+    BTN_DRV_SEEK,
+    BTN_DRV_MATRIX,
+    BTN_DRV_FS,
+    BTN_DRV_REFRESH,
 
-    /* Boards view button */
+    /* Boards view buttons */
     BTN_BOARD_EXIT,
+    BTN_BOARD_PREV,
+    BTN_BOARD_NEXT,
+    BTN_BOARD_SPEED,
+    BTN_BOARD_SAFE,
 
     /* SCSI view button */
     BTN_SCSI_EXIT,
+    BTN_SCSI_REFRESH,
+    BTN_SCSI_SPEED,
+
+    /* CPU view buttons */
+    BTN_CPU_RUN,
+    BTN_CPU_EXIT,
+    BTN_CPU_CACHES,
+    BTN_CPU_BLITTER,
+    BTN_CPU_LATENCY,
+
+    /* Monitor view buttons */
+    BTN_MON_REGION,
+    BTN_MON_EXIT,
+
+    /* Drives view page button */
+    BTN_DRV_NEXT,
 
     /* Drive selection buttons - MUST be last as they use sequential IDs */
     BTN_DRV_DRIVE_BASE,
 
-    BTN_COUNT = BTN_DRV_DRIVE_BASE + MAX_DRIVES
+    BTN_COUNT = BTN_DRV_DRIVE_BASE + DRIVE_BUTTONS
 } ButtonID;
 
 /* Button definition */
@@ -70,8 +102,16 @@ typedef struct {
     ButtonID id;            /* Button identifier */
     BOOL enabled;           /* Can be clicked */
     BOOL pressed;           /* Currently pressed */
+    BOOL dirty;             /* Changed since it was last drawn */
 } Button;
 
+/* Main view areas for partial redraws, see mark_dirty() */
+#define DIRTY_HEADER        0x01
+#define DIRTY_SOFTWARE      0x02
+#define DIRTY_SPEED         0x04
+#define DIRTY_HARDWARE      0x08
+#define DIRTY_VIEW          0x80    /* Whole view (all views but main) */
+
 /* Layout constants for main view */
 #define HEADER_HEIGHT       23
 #define PANEL_MARGIN        4
@@ -124,6 +164,15 @@ void draw_boards_view(void);
 /* Redraw current view */
 void redraw_current_view(void);
 
+/*
+ * Partial redraw: mark what changed, then redraw_dirty() repaints only
+ * those main view panels plus buttons changed by set_button_pressed()
+ * or set_button_label(). Other views are repainted as a whole
+ */
+void mark_dirty(ULONG areas);
+void mark_dirty_rect(WORD x0, WORD y0, WORD x1, WORD y1);
+void redraw_dirty(void);
+
 /* Panel drawing helpers */
 void draw_panel(WORD x, WORD y, WORD w, WORD h, const char *title);
 void draw_button(Button *btn);
@@ -146,6 +195,7 @@ void draw_scroll_arrow(WORD x, WORD y, WORD w, WORD h, BOOL up, BOOL pressed);
 void draw_scroll_bar(WORD x, WORD y, WORD w, WORD h, ULONG pos, ULONG total, ULONG visible);
 
 /* Event handling */
+void handle_benchmark_progress(BenchProgressMsg *progress);
 ButtonID handle_click(WORD mx, WORD my);
 void handle_button_press(ButtonID btn);
 void handle_scrollbar_click(WORD mx, WORD my);
@@ -156,6 +206,7 @@ void update_button_states(void);
 void add_button(WORD x, WORD y, WORD w, WORD h, const char *label, ButtonID id, BOOL enabled);
 Button *find_button(ButtonID id);
 void set_button_pressed(ButtonID id, BOOL pressed);
+void set_button_label(ButtonID id, const char *label);
 void redraw_button(ButtonID id);
 
 /* View switching */
@@ -184,4 +235,10 @@ void boards_view_handle_button(ButtonID id);
 void scsi_view_update_buttons(void);
 void scsi_view_handle_button(ButtonID id);
 
+void cpu_view_update_buttons(void);
+void cpu_view_handle_button(ButtonID id);
+
+void monitor_view_update_buttons(void);
+void monitor_view_handle_button(ButtonID id);
+
 #endif /* GUI_H */
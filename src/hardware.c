@@ -31,6 +31,7 @@
 #include "cpu.h" //for cpu-type/rev
 #include "cache.h"
 #include "benchmark.h" //for frequencies
+#include "profile.h"
 
 /* Global hardware info */
 HardwareInfo hw_info;
@@ -45,36 +46,38 @@ extern struct GfxBase *GfxBase;
  */
 BOOL detect_hardware(void)
 {
+    BOOL emu68;
 
     memset(&hw_info, 0, sizeof(HardwareInfo));
 
-    if (!detect_emu68_systems()) {
+    PROFILE_PHASE("detect_emu68_systems", emu68 = detect_emu68_systems());
+    if (!emu68) {
         debug("  hw: Detecting CPU...\n");
-        detect_cpu();
+        PROFILE_PHASE("detect_cpu", detect_cpu());
     }
     else {
         debug("  hw: Emu68-System detected...\n");
     }
     debug("  hw: Detecting FPU...\n");
-    detect_fpu();
+    PROFILE_PHASE("detect_fpu", detect_fpu());
     debug("  hw: Detecting MMU...\n");
-    detect_mmu();
+    PROFILE_PHASE("detect_mmu", detect_mmu());
     debug("  hw: Reading VBR...\n");
-    read_vbr();
+    PROFILE_PHASE("read_vbr", read_vbr());
     debug("  hw: Detecting chipset...\n");
-    detect_chipset();
+    PROFILE_PHASE("detect_chipset", detect_chipset());
     debug("  hw: Detecting system chips...\n");
-    detect_system_chips();
+    PROFILE_PHASE("detect_system_chips", detect_system_chips());
     debug("  hw: Detecting clock...\n");
-    detect_clock();
+    PROFILE_PHASE("detect_clock", detect_clock());
     debug("  hw: Detecting batt mem ressources...\n");
-    detect_batt_mem();
+    PROFILE_PHASE("detect_batt_mem", detect_batt_mem());
     debug("  hw: Detecting frequencies...\n");
-    detect_frequencies();
+    PROFILE_PHASE("detect_frequencies", detect_frequencies());
     debug("  hw: Refreshing cache status...\n");
-    refresh_cache_status();
+    PROFILE_PHASE("refresh_cache_status", refresh_cache_status());
     debug("  hw: Generating comment...\n");
-    generate_comment();
+    PROFILE_PHASE("generate_comment", generate_comment());
 
     /* Get Kickstart info */
     UWORD kick_version = *((volatile UWORD *)KICK_VERSION);
@@ -539,6 +542,30 @@ void read_vbr(void)
     }
 }
 
+/*
+ * Name of an Agnus/Alice type, without revision
+ */
+const char *get_agnus_string(AgnusType type)
+{
+    switch (type) {
+        case AGNUS_OCS_NTSC:        return get_string(MSG_AGNUS_OCS_NTSC);
+        case AGNUS_OCS_PAL:         return get_string(MSG_AGNUS_OCS_PAL);
+        case AGNUS_OCS_FAT_NTSC:    return get_string(MSG_AGNUS_OCS_FAT_NTSC);
+        case AGNUS_OCS_FAT_PAL:     return get_string(MSG_AGNUS_OCS_FAT_PAL);
+        case AGNUS_ECS_2MB_NTSC:    return get_string(MSG_AGNUS_ECS_2MB_NTSC);
+        case AGNUS_ECS_2MB_PAL:     return get_string(MSG_AGNUS_ECS_2MB_PAL);
+        case AGNUS_ECS_B_NTSC:      return get_string(MSG_AGNUS_ECS_B_NTSC);
+        case AGNUS_ECS_B_PAL:       return get_string(MSG_AGNUS_ECS_B_PAL);
+        case AGNUS_ECS_NTSC:        return get_string(MSG_AGNUS_ECS_NTSC);
+        case AGNUS_ECS_PAL:         return get_string(MSG_AGNUS_ECS_PAL);
+        case AGNUS_ALICE_NTSC:      return get_string(MSG_AGNUS_ALICE_NTSC);
+        case AGNUS_ALICE_PAL:       return get_string(MSG_AGNUS_ALICE_PAL);
+        case AGNUS_SAGA:            return get_string(MSG_AGNUS_SAGA);
+        case AGNUS_UNKNOWN:
+        default:                    return get_string(MSG_AGNUS_UNKNOWN);
+    }
+}
+
 /*
  * Detect chipset (Agnus/Denise)
  */
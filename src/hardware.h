@@ -33,6 +33,7 @@
 #define CUSTOM_BLTDDAT   0xDFF000
 #define CUSTOM_DMACONR   0xDFF002
 #define CUSTOM_DMACONR_MIRR   0xDAF002
+#define CUSTOM_DMACON    0xDFF096
 #define CUSTOM_JOY0DAT   0xDFF00A
 #define CUSTOM_JOY0DAT_MIRR  0xDAF00A
 #define CUSTOM_JOY1DAT   0xDFF00C
@@ -275,6 +276,7 @@ void detect_fpu(void);
 void detect_mmu(void);
 void read_vbr(void);
 void detect_chipset(void);
+const char *get_agnus_string(AgnusType type);
 void detect_clock(void);
 void detect_batt_mem(void);
 void detect_gary(void);
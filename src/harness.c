@@ -0,0 +1,382 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Benchmark harness
+ *
+ * One calibration and timing path for the CPU, FPU and memory
+ * kernels: the iteration count grows until a run takes the kernel's
+ * minimum runtime, every run is net of the EClock read and loop
+ * counter overhead, and repeat runs drop outliers before the median
+ * is taken. Kernels measured this way are listed in the report.
+ */
+
+#include <string.h>
+#include <limits.h>
+
+#include <proto/exec.h>
+
+#include "xsysinfo.h"
+#include "harness.h"
+#include "benchmark.h"
+#include "debug.h"
+
+/* Kernels calibrated so far, in order */
+static BenchKernel *kernels[BENCH_MAX_KERNELS];
+static ULONG kernel_count = 0;
+
+/* Cost of two back-to-back clock reads, 0 until measured */
+static ULONG clock_overhead_ns = 0;
+static BOOL clock_measured = FALSE;
+
+/*
+ * Nanoseconds between two clock reads, EClock ticks where available
+ */
+uint64_t harness_clock_diff_ns(struct EClockVal *start, struct EClockVal *end, ULONG E_Freq)
+{
+    uint64_t ticks;
+
+    if (E_Freq == 0) {
+        return (uint64_t)EClock_Diff_in_ms(start, end, 0) * 1000ULL;
+    }
+
+    ticks = (((uint64_t)end->ev_hi << 32) + (uint64_t)end->ev_lo) -
+            (((uint64_t)start->ev_hi << 32) + (uint64_t)start->ev_lo);
+    return (ticks * 1000000000ULL) / E_Freq;
+}
+
+/*
+ * Shortest of a few empty start/end clock read pairs
+ */
+static ULONG measure_clock_overhead(void)
+{
+    struct EClockVal start, end;
+    ULONG E_Freq;
+    ULONG best = 0;
+    ULONG ns;
+    int i;
+
+    for (i = 0; i < 16; i++) {
+        Forbid();
+        read_benchmark_clock(&start);
+        E_Freq = read_benchmark_clock(&end);
+        Permit();
+
+        ns = (ULONG)harness_clock_diff_ns(&start, &end, E_Freq);
+        if (i == 0 || ns < best) best = ns;
+    }
+
+    debug("  bench: clock read overhead %lu ns\n", best);
+    return best;
+}
+
+/*
+ * Cost of two back-to-back clock reads, measured on first use
+ */
+ULONG harness_clock_overhead_ns(void)
+{
+    if (!clock_measured) {
+        clock_overhead_ns = measure_clock_overhead();
+        clock_measured = TRUE;
+    }
+    return clock_overhead_ns;
+}
+
+/*
+ * Time of loops empty subq/bne iterations, without the clock reads
+ * measure_loop_overhead() times them with
+ */
+static ULONG counter_overhead_ns(ULONG loops)
+{
+    uint64_t ns;
+
+    if (loops == 0) return 0;
+
+    ns = (uint64_t)measure_loop_overhead(loops) * 1000ULL;
+    if (ns <= clock_overhead_ns) return 0;
+    ns -= clock_overhead_ns;
+
+    return ns > ULONG_MAX ? ULONG_MAX : (ULONG)ns;
+}
+
+static void register_kernel(BenchKernel *kernel)
+{
+    ULONG i;
+
+    for (i = 0; i < kernel_count; i++) {
+        if (kernels[i] == kernel) return;
+    }
+    if (kernel_count < BENCH_MAX_KERNELS) {
+        kernels[kernel_count++] = kernel;
+    }
+}
+
+/*
+ * Integer square root
+ */
+static ULONG isqrt64(uint64_t value)
+{
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > value) bit >>= 2;
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (ULONG)root;
+}
+
+static ULONG median_of(const ULONG *values, ULONG count)
+{
+    return (count & 1) ? values[count / 2] :
+           (ULONG)(((uint64_t)values[count / 2 - 1] + values[count / 2]) / 2);
+}
+
+/*
+ * Median, min/max and standard deviation of count results (sorts
+ * values). With BENCH_OUTLIER_MIN_RUNS or more, results further than
+ * BENCH_OUTLIER_PERCENT from the median are dropped first
+ */
+static void compute_bench_stats(ULONG *values, ULONG count, BenchStats *stats)
+{
+    uint64_t sum = 0, sq_sum = 0;
+    ULONG mean, median, kept;
+    ULONG i, j;
+
+    memset(stats, 0, sizeof(BenchStats));
+    if (count == 0) return;
+
+    /* Insertion sort, count is small */
+    for (i = 1; i < count; i++) {
+        ULONG v = values[i];
+        for (j = i; j > 0 && values[j - 1] > v; j--) {
+            values[j] = values[j - 1];
+        }
+        values[j] = v;
+    }
+
+    kept = count;
+    if (count >= BENCH_OUTLIER_MIN_RUNS) {
+        uint64_t limit;
+
+        median = median_of(values, count);
+        limit = (uint64_t)median * BENCH_OUTLIER_PERCENT / 100;
+        for (i = 0, kept = 0; i < count; i++) {
+            uint64_t d = values[i] > median ? values[i] - median : median - values[i];
+            if (d <= limit) kept++;
+        }
+
+        /* A bimodal spread can lie entirely outside the limit, keep
+         * everything then */
+        if (kept < 2) {
+            kept = count;
+        } else {
+            for (i = 0, kept = 0; i < count; i++) {
+                uint64_t d = values[i] > median ? values[i] - median : median - values[i];
+                if (d <= limit) values[kept++] = values[i];
+            }
+        }
+    }
+
+    for (i = 0; i < kept; i++) sum += values[i];
+    mean = (ULONG)(sum / kept);
+    for (i = 0; i < kept; i++) {
+        int64_t d = (int64_t)values[i] - (int64_t)mean;
+        sq_sum += (uint64_t)(d * d);
+    }
+
+    stats->runs = kept;
+    stats->outliers = count - kept;
+    stats->min = values[0];
+    stats->max = values[kept - 1];
+    stats->median = median_of(values, kept);
+    stats->stddev = isqrt64(sq_sum / kept);
+
+    /* Spread (max - min) relative to the median */
+    stats->unstable = stats->median > 0 &&
+                      ((uint64_t)(stats->max - stats->min) * 100ULL >
+                       (uint64_t)stats->median * BENCH_SPREAD_THRESHOLD);
+}
+
+/*
+ * Time one run with a fixed iteration count
+ */
+BOOL harness_time(BenchKernel *kernel, ULONG iterations, BenchWork *work, uint64_t *elapsed_ns)
+{
+    struct EClockVal start, end;
+    ULONG E_Freq;
+    uint64_t ns, overhead;
+
+    work->work = 0;
+    work->counter_loops = 0;
+    *elapsed_ns = 0;
+
+    if (!benchmark_timer_available()) return FALSE;
+    if (kernel->setup && !kernel->setup(kernel->data)) return FALSE;
+
+    harness_clock_overhead_ns();
+
+    if (kernel->flags & BENCH_KERNEL_FORBID) Forbid();
+    E_Freq = read_benchmark_clock(&start);
+    kernel->run(kernel->data, iterations, work);
+    E_Freq = read_benchmark_clock(&end);
+    if (kernel->flags & BENCH_KERNEL_FORBID) Permit();
+
+    ns = harness_clock_diff_ns(&start, &end, E_Freq);
+    kernel->total_us += (ULONG)(ns / 1000ULL);
+
+    overhead = (uint64_t)clock_overhead_ns + counter_overhead_ns(work->counter_loops);
+    kernel->overhead_ns = overhead > ULONG_MAX ? ULONG_MAX : (ULONG)overhead;
+
+    if (ns > overhead) {
+        ns -= overhead;
+    } else if (ns > 0) {
+        /* Should not happen, but safety first */
+        ns = 1000;
+    }
+
+    *elapsed_ns = ns;
+    return TRUE;
+}
+
+/*
+ * Result of a timed run
+ */
+ULONG harness_rate(const BenchKernel *kernel, const BenchWork *work, uint64_t elapsed_ns)
+{
+    uint64_t scaled, rate;
+
+    if (elapsed_ns == 0 || work->work == 0) return 0;
+
+    scaled = work->work * kernel->scale;
+    if (scaled < ~0ULL / 1000ULL) {
+        rate = (scaled * 1000ULL) / elapsed_ns;
+    } else {
+        rate = scaled / (elapsed_ns / 1000ULL ? elapsed_ns / 1000ULL : 1);
+    }
+
+    return rate > ULONG_MAX ? ULONG_MAX : (ULONG)rate;
+}
+
+/*
+ * Single run with a fixed iteration count
+ */
+ULONG harness_measure(BenchKernel *kernel, ULONG iterations)
+{
+    BenchWork work;
+    uint64_t elapsed_ns;
+
+    if (!harness_time(kernel, iterations, &work, &elapsed_ns)) return 0;
+
+    return harness_rate(kernel, &work, elapsed_ns);
+}
+
+/*
+ * Grow the iteration count until a run takes min_runtime_us. Very
+ * short runs are mostly timer noise, those grow x16, longer ones are
+ * scaled to 1/BENCH_CALIBRATE_MARGIN past the target
+ */
+BOOL harness_calibrate(BenchKernel *kernel, BenchWork *work, uint64_t *elapsed_ns)
+{
+    uint64_t target = (uint64_t)kernel->min_runtime_us * 1000ULL;
+    uint64_t iterations = kernel->start_iterations ? kernel->start_iterations : 1;
+    ULONG attempt;
+
+    register_kernel(kernel);
+    kernel->iterations = 0;
+    kernel->attempts = 0;
+    kernel->total_us = 0;
+
+    for (attempt = 0; attempt < BENCH_CALIBRATE_ATTEMPTS; attempt++) {
+        if (attempt > 0 && benchmark_cancelled()) {
+            return FALSE;
+        }
+        if (!harness_time(kernel, (ULONG)iterations, work, elapsed_ns)) {
+            return FALSE;
+        }
+        kernel->iterations = (ULONG)iterations;
+        kernel->attempts = attempt + 1;
+
+        if (*elapsed_ns >= target || iterations >= kernel->max_iterations) {
+            break;
+        }
+
+        if (*elapsed_ns < BENCH_FAST_RUN_US * 1000ULL) {
+            iterations *= 16;
+        } else {
+            uint64_t scaled = (iterations * (target + target / BENCH_CALIBRATE_MARGIN)) / *elapsed_ns;
+            iterations = scaled > iterations ? scaled : iterations * 2;
+        }
+        if (iterations > kernel->max_iterations) {
+            iterations = kernel->max_iterations;
+        }
+    }
+
+    debug("  bench: %s calibrated to %lu iterations in %lu runs, %lu us\n",
+          (LONG)kernel->name, kernel->iterations, kernel->attempts,
+          (ULONG)(*elapsed_ns / 1000ULL));
+    return TRUE;
+}
+
+/*
+ * Calibrate, then time the calibrated count runs more times. Without
+ * repeat runs the calibration run is the result
+ */
+ULONG harness_run(BenchKernel *kernel, ULONG runs, BenchStats *stats)
+{
+    ULONG values[BENCH_MAX_REPEAT];
+    BenchWork work;
+    uint64_t elapsed_ns;
+    ULONG count = 0;
+
+    memset(&kernel->stats, 0, sizeof(BenchStats));
+    if (runs > BENCH_MAX_REPEAT) runs = BENCH_MAX_REPEAT;
+
+    if (!harness_calibrate(kernel, &work, &elapsed_ns)) {
+        if (stats) *stats = kernel->stats;
+        return 0;
+    }
+
+    if (runs == 0) {
+        values[0] = harness_rate(kernel, &work, elapsed_ns);
+        if (values[0] > 0) count = 1;
+    }
+
+    while (count < runs) {
+        if (benchmark_cancelled()) {
+            count = 0;
+            break;
+        }
+        if (!harness_time(kernel, kernel->iterations, &work, &elapsed_ns)) break;
+        values[count] = harness_rate(kernel, &work, elapsed_ns);
+        if (values[count] == 0) break;
+        count++;
+    }
+
+    compute_bench_stats(values, count, &kernel->stats);
+    if (count > 1) {
+        debug("  bench: %s median %lu, min %lu, max %lu, stddev %lu over %lu runs (%lu dropped)\n",
+              (LONG)kernel->name, kernel->stats.median, kernel->stats.min, kernel->stats.max,
+              kernel->stats.stddev, kernel->stats.runs, kernel->stats.outliers);
+    }
+
+    if (stats) *stats = kernel->stats;
+    return kernel->stats.median;
+}
+
+ULONG harness_count(void)
+{
+    return kernel_count;
+}
+
+const BenchKernel *harness_get(ULONG index)
+{
+    return index < kernel_count ? kernels[index] : NULL;
+}
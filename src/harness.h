@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Benchmark harness header
+ */
+
+#ifndef HARNESS_H
+#define HARNESS_H
+
+#include "xsysinfo.h"
+#include "benchmark.h"
+
+/* Kernel flags */
+#define BENCH_KERNEL_FORBID     0x01    /* Time the run inside Forbid() */
+
+/* Calibration */
+#define BENCH_CALIBRATE_ATTEMPTS 8      /* Timed runs to find the iteration count */
+#define BENCH_FAST_RUN_US       100     /* Below this, grow x16 instead of scaling */
+#define BENCH_CALIBRATE_MARGIN  8       /* Aim 1/8 past the target */
+
+/* Repeat runs further than this from the median are dropped */
+#define BENCH_OUTLIER_MIN_RUNS  5
+#define BENCH_OUTLIER_PERCENT   10
+
+#define BENCH_MAX_KERNELS       32      /* Kernels listed in the report */
+
+/* What one run of a kernel did */
+typedef struct {
+    uint64_t work;          /* Units the result is a rate of (loops, bytes, ops) */
+    ULONG counter_loops;    /* subq/bne loops to take off as counter overhead */
+} BenchWork;
+
+/* Untimed preparation before every run, FALSE if the kernel can not run */
+typedef BOOL (*BenchSetupFunc)(APTR data);
+
+/* The timed code, fills in work */
+typedef void (*BenchKernelFunc)(APTR data, ULONG iterations, BenchWork *work);
+
+/* A benchmark kernel. The first block is set by the benchmark, the
+ * second by the harness after each calibration or run */
+typedef struct {
+    const char *name;           /* Static string */
+    BenchSetupFunc setup;       /* NULL = none */
+    BenchKernelFunc run;
+    APTR data;                  /* Passed to setup and run */
+    ULONG scale;                /* Result = work * scale / elapsed us */
+    ULONG start_iterations;
+    ULONG max_iterations;
+    ULONG min_runtime_us;       /* Calibration target */
+    ULONG flags;                /* BENCH_KERNEL_* */
+
+    ULONG iterations;           /* Calibrated count */
+    ULONG attempts;             /* Calibration runs it took */
+    ULONG overhead_ns;          /* Clock and counter overhead taken off a run */
+    ULONG total_us;             /* Wall time of calibration and runs */
+    BenchStats stats;           /* Last harness_run() */
+} BenchKernel;
+
+/* Nanoseconds between two read_benchmark_clock() values */
+uint64_t harness_clock_diff_ns(struct EClockVal *start, struct EClockVal *end, ULONG E_Freq);
+
+/* Cost of two back-to-back clock reads, measured on first use */
+ULONG harness_clock_overhead_ns(void);
+
+/* Time one run with a fixed iteration count, elapsed_ns is net of
+ * the clock read and loop counter overhead. FALSE if setup failed */
+BOOL harness_time(BenchKernel *kernel, ULONG iterations, BenchWork *work, uint64_t *elapsed_ns);
+
+/* Result of a timed run, 0 if nothing was measured */
+ULONG harness_rate(const BenchKernel *kernel, const BenchWork *work, uint64_t elapsed_ns);
+
+/* Single run with a fixed iteration count, returns the result */
+ULONG harness_measure(BenchKernel *kernel, ULONG iterations);
+
+/* Grow the iteration count until a run takes min_runtime_us, work and
+ * elapsed_ns receive the last run. FALSE if setup failed or cancelled */
+BOOL harness_calibrate(BenchKernel *kernel, BenchWork *work, uint64_t *elapsed_ns);
+
+/* Calibrate, then time runs more runs (0 = the calibration run only).
+ * Returns the median, stats (if set) receives the distribution */
+ULONG harness_run(BenchKernel *kernel, ULONG runs, BenchStats *stats);
+
+/* Kernels calibrated so far */
+ULONG harness_count(void);
+const BenchKernel *harness_get(ULONG index);
+
+#endif /* HARNESS_H */
@@ -0,0 +1,278 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Benchmark history
+ *
+ * Every completed benchmark run is appended to a small file in ENVARC:
+ * so the effect of jumper, cache or firmware changes can be compared
+ * against earlier runs on the same machine.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <dos/dos.h>
+#include <dos/dosextens.h>
+
+#include <proto/exec.h>
+#include <proto/dos.h>
+
+#include "xsysinfo.h"
+#include "history.h"
+#include "hardware.h"
+#include "benchmark.h"
+#include "drives.h"
+#include "debug.h"
+
+/* External references */
+extern HardwareInfo hw_info;
+extern BenchmarkResults bench_results;
+extern DriveList drive_list;
+
+typedef struct {
+    ULONG magic;
+    ULONG version;
+    ULONG count;
+} HistoryHeader;
+
+static HistoryEntry entries[HISTORY_MAX_ENTRIES];
+static ULONG entry_count = 0;
+static LONG current_entry = -1;     /* Entry of the current results, -1 if none */
+static BOOL history_loaded = FALSE;
+
+/*
+ * Open the history file without a requester if ENVARC: is not assigned
+ * (plain Kickstart 1.3 boot disks)
+ */
+static BPTR open_history_file(LONG mode)
+{
+    struct Process *proc = (struct Process *)FindTask(NULL);
+    APTR old_window = proc->pr_WindowPtr;
+    BPTR fh;
+
+    proc->pr_WindowPtr = (APTR)-1; /* Suppress system requesters */
+    fh = Open((CONST_STRPTR)HISTORY_FILE, mode);
+    proc->pr_WindowPtr = old_window;
+
+    return fh;
+}
+
+/*
+ * Read the history file once, a missing or foreign file is an empty history
+ */
+static void load_history(void)
+{
+    HistoryHeader header;
+    BPTR fh;
+    ULONG i;
+
+    if (history_loaded) return;
+    history_loaded = TRUE;
+
+    fh = open_history_file(MODE_OLDFILE);
+    if (!fh) return;
+
+    if (Read(fh, &header, sizeof(header)) != sizeof(header) ||
+        header.magic != HISTORY_MAGIC || header.version != HISTORY_VERSION) {
+        debug("  history: Ignoring invalid history file\n");
+        Close(fh);
+        return;
+    }
+
+    for (i = 0; i < header.count && entry_count < HISTORY_MAX_ENTRIES; i++) {
+        HistoryEntry *entry = &entries[entry_count];
+        ULONG d;
+
+        if (Read(fh, entry, sizeof(HistoryEntry)) != sizeof(HistoryEntry)) {
+            break;
+        }
+        if (entry->drive_count > HISTORY_MAX_DRIVES) {
+            entry->drive_count = HISTORY_MAX_DRIVES;
+        }
+        for (d = 0; d < entry->drive_count; d++) {
+            entry->drives[d].device_name[sizeof(entry->drives[d].device_name) - 1] = '\0';
+        }
+        entry_count++;
+    }
+
+    Close(fh);
+
+    debug("  history: Loaded %ld runs\n", (LONG)entry_count);
+}
+
+/*
+ * Write the whole history
+ */
+static void save_history(void)
+{
+    HistoryHeader header;
+    BPTR fh;
+
+    fh = open_history_file(MODE_NEWFILE);
+    if (!fh) {
+        debug("  history: Cannot write %s\n", (LONG)HISTORY_FILE);
+        return;
+    }
+
+    header.magic = HISTORY_MAGIC;
+    header.version = HISTORY_VERSION;
+    header.count = entry_count;
+
+    if (Write(fh, &header, sizeof(header)) == sizeof(header) && entry_count > 0) {
+        Write(fh, entries, entry_count * sizeof(HistoryEntry));
+    }
+
+    Close(fh);
+}
+
+/*
+ * Load the stored runs at startup, so drawing the results never
+ * touches the file
+ */
+void history_init(void)
+{
+    load_history();
+}
+
+/*
+ * Copy the speeds of all measured drives into an entry
+ */
+static void fill_drives(HistoryEntry *entry)
+{
+    ULONG i;
+
+    entry->drive_count = 0;
+    for (i = 0; i < drive_list.count && entry->drive_count < HISTORY_MAX_DRIVES; i++) {
+        const DriveInfo *drive = &drive_list.drives[i];
+        HistoryDrive *hd;
+
+        if (!drive->speed_measured || drive->speed_bytes_sec == 0) continue;
+
+        hd = &entry->drives[entry->drive_count++];
+        memset(hd, 0, sizeof(HistoryDrive));
+        strncpy(hd->device_name, drive->device_name, sizeof(hd->device_name) - 1);
+        hd->speed_bytes_sec = drive->speed_bytes_sec;
+    }
+}
+
+/*
+ * Append the current bench_results (and measured drives) and save
+ */
+void history_record_run(void)
+{
+    HistoryEntry *entry;
+    struct DateStamp now;
+
+    if (!bench_results.benchmarks_valid) return;
+
+    load_history();
+
+    /* Drop the oldest run when full */
+    if (entry_count == HISTORY_MAX_ENTRIES) {
+        memmove(&entries[0], &entries[1], (HISTORY_MAX_ENTRIES - 1) * sizeof(HistoryEntry));
+        entry_count--;
+    }
+
+    entry = &entries[entry_count];
+    memset(entry, 0, sizeof(HistoryEntry));
+
+    DateStamp(&now);
+    entry->days = now.ds_Days;
+    entry->minutes = now.ds_Minute;
+    entry->cpu_mhz = hw_info.cpu_mhz;
+    entry->fpu_mhz = hw_info.fpu_mhz;
+    entry->dhrystones = bench_results.dhrystones;
+    entry->mflops = bench_results.mflops;
+    entry->chip_speed = bench_results.chip_speed;
+    entry->fast_speed = bench_results.fast_speed;
+    entry->rom_speed = bench_results.rom_speed;
+    fill_drives(entry);
+
+    current_entry = (LONG)entry_count++;
+    save_history();
+}
+
+/*
+ * Add drive speeds measured after the run to this session's entry
+ */
+void history_update_drives(void)
+{
+    if (current_entry < 0) return;
+
+    fill_drives(&entries[current_entry]);
+    save_history();
+}
+
+/*
+ * Stored runs, oldest first
+ */
+ULONG history_count(void)
+{
+    return entry_count;
+}
+
+const HistoryEntry *history_get(ULONG index)
+{
+    return index < entry_count ? &entries[index] : NULL;
+}
+
+/*
+ * Run before the current one (the last stored run if there is none)
+ */
+const HistoryEntry *history_get_previous(void)
+{
+    LONG index;
+
+    index = current_entry >= 0 ? current_entry - 1 : (LONG)entry_count - 1;
+    return index >= 0 ? &entries[index] : NULL;
+}
+
+/*
+ * Fastest Dhrystone run apart from the current one
+ */
+const HistoryEntry *history_get_best(void)
+{
+    const HistoryEntry *best = NULL;
+    ULONG i;
+
+    for (i = 0; i < entry_count; i++) {
+        if ((LONG)i == current_entry) continue;
+        if (!best || entries[i].dhrystones > best->dhrystones) {
+            best = &entries[i];
+        }
+    }
+
+    return best;
+}
+
+/*
+ * "+1.2%" style change of current over reference
+ */
+void format_history_delta(char *buffer, size_t size, ULONG current, ULONG reference)
+{
+    LONG permille;
+    ULONG magnitude;
+
+    if (reference == 0 || current == 0) {
+        snprintf(buffer, size, "-");
+        return;
+    }
+
+    permille = (LONG)(((long long)current - (long long)reference) * 1000LL /
+                      (long long)reference);
+    magnitude = permille < 0 ? (ULONG)-permille : (ULONG)permille;
+
+    snprintf(buffer, size, "%c%lu.%lu%%", permille < 0 ? '-' : '+',
+             (unsigned long)(magnitude / 10), (unsigned long)(magnitude % 10));
+}
+
+/*
+ * Forget the in-memory copy (the file is already up to date)
+ */
+void history_cleanup(void)
+{
+    entry_count = 0;
+    current_entry = -1;
+    history_loaded = FALSE;
+}
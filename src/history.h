@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Benchmark history header
+ */
+
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include "xsysinfo.h"
+
+/* History file, survives reboots */
+#define HISTORY_FILE        "ENVARC:xSysInfo.history"
+#define HISTORY_MAGIC       0x58534948  /* 'XSIH' */
+#define HISTORY_VERSION     1
+#define HISTORY_MAX_ENTRIES 32          /* Oldest runs are dropped */
+#define HISTORY_MAX_DRIVES  4
+
+/* Drive speed of a run */
+typedef struct {
+    char device_name[32];
+    ULONG speed_bytes_sec;
+} HistoryDrive;
+
+/* One benchmark run */
+typedef struct {
+    ULONG days;                 /* DateStamp of the run */
+    ULONG minutes;
+    ULONG cpu_mhz;              /* MHz * 100 */
+    ULONG fpu_mhz;              /* MHz * 100 */
+    ULONG dhrystones;
+    ULONG mflops;               /* MFLOPS * 100 */
+    ULONG chip_speed;           /* Read speeds in bytes/sec */
+    ULONG fast_speed;
+    ULONG rom_speed;
+    ULONG drive_count;
+    HistoryDrive drives[HISTORY_MAX_DRIVES];
+} HistoryEntry;
+
+/* Function prototypes */
+
+/* Load the stored runs, call once at startup */
+void history_init(void);
+
+/* Append the current bench_results (and measured drives) and save */
+void history_record_run(void);
+
+/* Add drive speeds measured after the run to this session's entry */
+void history_update_drives(void);
+
+/* Stored runs, oldest first (empty before history_init()) */
+ULONG history_count(void);
+const HistoryEntry *history_get(ULONG index);
+
+/* Runs to compare the current results with, NULL if there are none */
+const HistoryEntry *history_get_previous(void);
+const HistoryEntry *history_get_best(void);
+
+/* "+1.2%" style change of current over reference */
+void format_history_delta(char *buffer, size_t size, ULONG current, ULONG reference);
+
+void history_cleanup(void);
+
+#endif /* HISTORY_H */
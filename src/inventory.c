@@ -0,0 +1,406 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Persistent drive/SCSI inventory cache
+ *
+ * Probing SCSI support and scanning a bus opens every unit and can take
+ * seconds per controller. The results are kept in ENVARC: keyed by
+ * handler name and unit, and are only trusted while the same version of
+ * the device driver is loaded and the unit's partitions are unchanged.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <exec/execbase.h>
+#include <exec/memory.h>
+#include <exec/devices.h>
+#include <dos/dos.h>
+#include <dos/dosextens.h>
+
+#include <proto/exec.h>
+#include <proto/dos.h>
+
+#include "xsysinfo.h"
+#include "inventory.h"
+#include "scsi.h"
+#include "drives.h"
+#include "debug.h"
+
+extern struct ExecBase *SysBase;
+
+/* Record kinds */
+#define INV_SCSI_SUPPORT    1   /* data.supported for handler/unit */
+#define INV_SCSI_SCAN       2   /* Controller was scanned, data.count devices */
+#define INV_SCSI_DEVICE     3   /* data.device found at handler/unit */
+
+typedef struct {
+    char handler_name[64];
+    ULONG unit;
+    UWORD dev_version;          /* Driver version the record was made with */
+    UWORD dev_revision;
+    UWORD kind;
+    UWORD pad;
+    ULONG geometry;             /* get_geometry_key() the record was made with */
+    union {
+        BOOL supported;
+        ULONG count;
+        ScsiDeviceInfo device;
+    } data;
+} InventoryRecord;
+
+typedef struct {
+    ULONG magic;
+    ULONG version;
+    ULONG count;
+} InventoryHeader;
+
+static InventoryRecord *records = NULL;
+static ULONG record_count = 0;
+static ULONG record_capacity = 0;
+static BOOL inventory_loaded = FALSE;
+static BOOL inventory_dirty = FALSE;
+
+/*
+ * Version of a loaded device driver, FALSE if it is not loaded
+ */
+static BOOL get_device_version(const char *handler_name, UWORD *version, UWORD *revision)
+{
+    struct Device *dev;
+    BOOL found = FALSE;
+
+    Forbid();
+    dev = (struct Device *)FindName(&SysBase->DeviceList, (CONST_STRPTR)handler_name);
+    if (dev) {
+        *version = dev->dd_Library.lib_Version;
+        *revision = dev->dd_Library.lib_Revision;
+        found = TRUE;
+    }
+    Permit();
+
+    return found;
+}
+
+/*
+ * Partition layout of handler/unit (of every unit for a bus scan) in
+ * the drive list, so a drive swapped or repartitioned on the same
+ * driver and unit does not match its old records
+ */
+static ULONG get_geometry_key(const char *handler_name, ULONG unit, UWORD kind)
+{
+    ULONG key = 0;
+    ULONG i;
+
+    for (i = 0; i < drive_list.count; i++) {
+        const DriveInfo *drive = &drive_list.drives[i];
+
+        if (strcmp(drive->handler_name, handler_name) != 0) continue;
+        if (kind != INV_SCSI_SCAN && drive->unit_number != unit) continue;
+
+        /* Summed, the DosList order can change between boots */
+        key += ((drive->unit_number * 31 + drive->low_cylinder) * 31 +
+                drive->total_blocks) * 2654435761UL;
+    }
+
+    return key;
+}
+
+/*
+ * Make room for at least one more record
+ */
+static BOOL grow_records(void)
+{
+    InventoryRecord *new_records;
+    ULONG new_capacity;
+
+    if (record_count < record_capacity) return TRUE;
+
+    new_capacity = record_capacity ? record_capacity * 2 : 32;
+    new_records = AllocMem(new_capacity * sizeof(InventoryRecord), MEMF_ANY | MEMF_CLEAR);
+    if (!new_records) return FALSE;
+
+    if (records) {
+        memcpy(new_records, records, record_count * sizeof(InventoryRecord));
+        FreeMem(records, record_capacity * sizeof(InventoryRecord));
+    }
+    records = new_records;
+    record_capacity = new_capacity;
+
+    return TRUE;
+}
+
+/*
+ * Open the cache file without a requester if ENVARC: is not assigned
+ * (plain Kickstart 1.3 boot disks)
+ */
+static BPTR open_inventory_file(LONG mode)
+{
+    struct Process *proc = (struct Process *)FindTask(NULL);
+    APTR old_window = proc->pr_WindowPtr;
+    BPTR fh;
+
+    proc->pr_WindowPtr = (APTR)-1; /* Suppress system requesters */
+    fh = Open((CONST_STRPTR)INVENTORY_FILE, mode);
+    proc->pr_WindowPtr = old_window;
+
+    return fh;
+}
+
+/*
+ * Read the cache file once, a missing or foreign file is an empty cache
+ */
+static void load_inventory(void)
+{
+    InventoryHeader header;
+    BPTR fh;
+    ULONG i;
+
+    if (inventory_loaded) return;
+    inventory_loaded = TRUE;
+
+    fh = open_inventory_file(MODE_OLDFILE);
+    if (!fh) return;
+
+    if (Read(fh, &header, sizeof(header)) != sizeof(header) ||
+        header.magic != INVENTORY_MAGIC || header.version != INVENTORY_VERSION) {
+        debug("  inventory: Ignoring invalid cache file\n");
+        Close(fh);
+        return;
+    }
+
+    for (i = 0; i < header.count; i++) {
+        if (!grow_records()) break;
+        if (Read(fh, &records[record_count], sizeof(InventoryRecord)) !=
+            sizeof(InventoryRecord)) {
+            break;
+        }
+        records[record_count].handler_name[sizeof(records[0].handler_name) - 1] = '\0';
+        record_count++;
+    }
+
+    Close(fh);
+
+    debug("  inventory: Loaded %ld records\n", (LONG)record_count);
+}
+
+/*
+ * Find a record, NULL if none
+ */
+static InventoryRecord *find_record(const char *handler_name, ULONG unit, UWORD kind)
+{
+    ULONG i;
+
+    for (i = 0; i < record_count; i++) {
+        if (records[i].kind == kind && records[i].unit == unit &&
+            strcmp(records[i].handler_name, handler_name) == 0) {
+            return &records[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Find a record that is still valid for the loaded driver and the
+ * current partitions
+ */
+static InventoryRecord *find_valid_record(const char *handler_name, ULONG unit, UWORD kind)
+{
+    InventoryRecord *rec;
+    UWORD version, revision;
+
+    load_inventory();
+
+    rec = find_record(handler_name, unit, kind);
+    if (!rec) return NULL;
+
+    if (!get_device_version(handler_name, &version, &revision) ||
+        version != rec->dev_version || revision != rec->dev_revision ||
+        get_geometry_key(handler_name, unit, kind) != rec->geometry) {
+        debug("  inventory: Stale record for %s unit %ld\n",
+              (LONG)handler_name, (LONG)unit);
+        return NULL;
+    }
+
+    return rec;
+}
+
+/*
+ * Drop all records of a kind for a handler
+ */
+static void remove_records(const char *handler_name, UWORD kind)
+{
+    ULONG i = 0;
+
+    while (i < record_count) {
+        if (records[i].kind == kind &&
+            strcmp(records[i].handler_name, handler_name) == 0) {
+            records[i] = records[--record_count];
+            inventory_dirty = TRUE;
+        } else {
+            i++;
+        }
+    }
+}
+
+/*
+ * Create or overwrite a record stamped with the current driver version
+ * and partitions
+ */
+static InventoryRecord *put_record(const char *handler_name, ULONG unit, UWORD kind)
+{
+    InventoryRecord *rec;
+    UWORD version = 0, revision = 0;
+
+    load_inventory();
+
+    rec = find_record(handler_name, unit, kind);
+    if (!rec) {
+        if (!grow_records()) return NULL;
+        rec = &records[record_count++];
+    }
+
+    get_device_version(handler_name, &version, &revision);
+
+    memset(rec, 0, sizeof(InventoryRecord));
+    strncpy(rec->handler_name, handler_name, sizeof(rec->handler_name) - 1);
+    rec->unit = unit;
+    rec->kind = kind;
+    rec->dev_version = version;
+    rec->dev_revision = revision;
+    rec->geometry = get_geometry_key(handler_name, unit, kind);
+    inventory_dirty = TRUE;
+
+    return rec;
+}
+
+/*
+ * Cached HD_SCSICMD support of handler/unit
+ */
+BOOL inventory_get_scsi_support(const char *handler_name, ULONG unit, BOOL *supported)
+{
+    InventoryRecord *rec = find_valid_record(handler_name, unit, INV_SCSI_SUPPORT);
+
+    if (!rec) return FALSE;
+
+    *supported = rec->data.supported;
+    return TRUE;
+}
+
+void inventory_set_scsi_support(const char *handler_name, ULONG unit, BOOL supported)
+{
+    InventoryRecord *rec = put_record(handler_name, unit, INV_SCSI_SUPPORT);
+
+    if (rec) rec->data.supported = supported;
+}
+
+/*
+ * Cached bus scan of a controller
+ */
+BOOL inventory_get_scsi_list(const char *handler_name, ScsiDeviceList *list)
+{
+    InventoryRecord *scan = find_valid_record(handler_name, 0, INV_SCSI_SCAN);
+    ScsiDeviceInfo *dev;
+    ULONG i;
+
+    if (!scan) return FALSE;
+
+    scsi_list_reset(list, handler_name);
+
+    for (i = 0; i < record_count; i++) {
+        if (records[i].kind == INV_SCSI_DEVICE &&
+            strcmp(records[i].handler_name, handler_name) == 0) {
+            dev = scsi_list_add(list);
+            if (!dev) break;
+            *dev = records[i].data.device;
+        }
+    }
+
+    /* A device record went missing, better scan again */
+    if (list->count != scan->data.count) {
+        list->count = 0;
+        return FALSE;
+    }
+
+    debug("  inventory: Using cached scan of %s (%ld devices)\n",
+          (LONG)handler_name, (LONG)list->count);
+    return TRUE;
+}
+
+void inventory_set_scsi_list(const char *handler_name, const ScsiDeviceList *list)
+{
+    InventoryRecord *rec;
+    ULONG i;
+
+    load_inventory();
+    remove_records(handler_name, INV_SCSI_DEVICE);
+
+    for (i = 0; i < list->count; i++) {
+        const ScsiDeviceInfo *dev = &list->devices[i];
+
+        rec = put_record(handler_name, calculate_unit_number(dev->target_id, dev->lun),
+                         INV_SCSI_DEVICE);
+        if (!rec) return;
+        rec->data.device = *dev;
+    }
+
+    rec = put_record(handler_name, 0, INV_SCSI_SCAN);
+    if (rec) rec->data.count = list->count;
+}
+
+/*
+ * Forget everything so the next lookups probe the hardware again
+ */
+void inventory_invalidate(void)
+{
+    load_inventory();
+    if (record_count > 0) inventory_dirty = TRUE;
+    record_count = 0;
+}
+
+/*
+ * Write the cache if it changed
+ */
+void inventory_save(void)
+{
+    InventoryHeader header;
+    BPTR fh;
+
+    if (!inventory_dirty) return;
+
+    fh = open_inventory_file(MODE_NEWFILE);
+    if (!fh) {
+        debug("  inventory: Cannot write %s\n", (LONG)INVENTORY_FILE);
+        return;
+    }
+
+    header.magic = INVENTORY_MAGIC;
+    header.version = INVENTORY_VERSION;
+    header.count = record_count;
+
+    if (Write(fh, &header, sizeof(header)) == sizeof(header) &&
+        (record_count == 0 ||
+         Write(fh, records, record_count * sizeof(InventoryRecord)) ==
+         (LONG)(record_count * sizeof(InventoryRecord)))) {
+        inventory_dirty = FALSE;
+    }
+
+    Close(fh);
+}
+
+/*
+ * Release the cache
+ */
+void inventory_cleanup(void)
+{
+    inventory_save();
+
+    if (records) {
+        FreeMem(records, record_capacity * sizeof(InventoryRecord));
+    }
+    records = NULL;
+    record_count = 0;
+    record_capacity = 0;
+    inventory_loaded = FALSE;
+}
@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Persistent drive/SCSI inventory cache header
+ */
+
+#ifndef INVENTORY_H
+#define INVENTORY_H
+
+#include "xsysinfo.h"
+#include "scsi.h"
+
+/* Cache file, survives reboots */
+#define INVENTORY_FILE      "ENVARC:xSysInfo.inventory"
+#define INVENTORY_MAGIC     0x58534943  /* 'XSIC' */
+#define INVENTORY_VERSION   3
+
+/* Function prototypes */
+
+/* Cached HD_SCSICMD support of handler/unit, FALSE if not cached or stale */
+BOOL inventory_get_scsi_support(const char *handler_name, ULONG unit, BOOL *supported);
+void inventory_set_scsi_support(const char *handler_name, ULONG unit, BOOL supported);
+
+/* Cached bus scan of a controller, FALSE if not cached or stale */
+BOOL inventory_get_scsi_list(const char *handler_name, ScsiDeviceList *list);
+void inventory_set_scsi_list(const char *handler_name, const ScsiDeviceList *list);
+
+/* Forget everything so the next lookups probe the hardware again */
+void inventory_invalidate(void);
+
+/* Write the cache if it changed and release it */
+void inventory_save(void);
+void inventory_cleanup(void);
+
+#endif /* INVENTORY_H */
@@ -0,0 +1,409 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Exec scheduling latency benchmark
+ *
+ * Times what real-time audio, MIDI and serial code waits for rather
+ * than how fast the CPU computes: a Signal()/Wait() and a message
+ * round trip to a partner task one priority above us, how late a
+ * timer.device request comes back, and the cost of Forbid()/Permit()
+ * and Disable()/Enable(). Every test keeps min/avg/max, a driver or
+ * patch that holds off interrupts or task switches shows in the max.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <exec/tasks.h>
+#include <exec/ports.h>
+#include <dos/dos.h>
+#include <devices/timer.h>
+
+#include <proto/exec.h>
+#include <clib/alib_protos.h>
+
+#include "xsysinfo.h"
+#include "latency.h"
+#include "benchmark.h"
+#include "harness.h"
+#include "hardware.h"
+#include "gui.h"
+#include "locale_str.h"
+#include "debug.h"
+
+extern HardwareInfo hw_info;
+
+/* Global results */
+LatencyResults latency_results;
+
+static const char *latency_test_names[LAT_TESTS] = {
+    "signal", "message", "timer", "forbid", "disable"
+};
+
+/* Shared with the partner task, set up before it signals ready */
+static struct Task *lat_parent;
+static struct Task *lat_partner;
+static struct MsgPort *lat_partner_port;
+static ULONG lat_ping_mask;
+static ULONG lat_pong_mask;
+static volatile BOOL lat_partner_done;
+
+/* Cost of two back-to-back clock reads, taken off every sample */
+static ULONG lat_clock_ns;
+
+const char *get_latency_test_name(ULONG test)
+{
+    return test < LAT_TESTS ? latency_test_names[test] : "?";
+}
+
+static void stats_add(LatencyStats *st, uint64_t *sum, ULONG ns)
+{
+    if (st->samples == 0 || ns < st->min_ns) st->min_ns = ns;
+    if (ns > st->max_ns) st->max_ns = ns;
+    *sum += ns;
+    st->samples++;
+}
+
+static void stats_finish(ULONG test, LatencyStats *st, uint64_t sum)
+{
+    if (st->samples > 0) {
+        st->avg_ns = (ULONG)(sum / st->samples);
+    }
+
+    debug("  latency: %s: %lu samples, min %lu avg %lu max %lu ns\n",
+          (LONG)latency_test_names[test], st->samples,
+          st->min_ns, st->avg_ns, st->max_ns);
+}
+
+/*
+ * Sample minus the clock overhead, clamped at 0
+ */
+static ULONG sample_ns(struct EClockVal *start, struct EClockVal *end, ULONG E_Freq)
+{
+    ULONG ns = (ULONG)harness_clock_diff_ns(start, end, E_Freq);
+
+    return ns > lat_clock_ns ? ns - lat_clock_ns : 0;
+}
+
+/*
+ * Partner task: answers every ping signal with a pong and replies to
+ * every message until it gets Ctrl-C
+ */
+static void latency_partner_entry(void)
+{
+    struct Message *msg;
+    BYTE ping = -1;
+    ULONG port_mask;
+    ULONG got;
+
+    lat_partner_port = CreatePort(NULL, 0);
+    ping = AllocSignal(-1);
+    if (!lat_partner_port || ping == -1) goto cleanup;
+
+    port_mask = 1UL << lat_partner_port->mp_SigBit;
+    lat_ping_mask = 1UL << ping;
+    Signal(lat_parent, lat_pong_mask);
+
+    for (;;) {
+        got = Wait(lat_ping_mask | port_mask | SIGBREAKF_CTRL_C);
+        if (got & lat_ping_mask) {
+            Signal(lat_parent, lat_pong_mask);
+        }
+        if (got & port_mask) {
+            while ((msg = GetMsg(lat_partner_port)) != NULL) {
+                ReplyMsg(msg);
+            }
+        }
+        if (got & SIGBREAKF_CTRL_C) break;
+    }
+
+cleanup:
+    if (lat_partner_port) {
+        DeletePort(lat_partner_port);
+        lat_partner_port = NULL;
+    }
+    if (ping != -1) FreeSignal(ping);
+
+    /* Stay in Forbid() until the task is gone */
+    Forbid();
+    lat_partner_done = TRUE;
+    Signal(lat_parent, lat_pong_mask);
+}
+
+/*
+ * Start the partner one priority above us, so Signal() and PutMsg()
+ * switch to it right away. Returns FALSE if it could not be started
+ */
+static BOOL start_partner(BYTE pong)
+{
+    struct Task *self = FindTask(NULL);
+    BYTE pri = self->tc_Node.ln_Pri;
+
+    lat_parent = self;
+    lat_pong_mask = 1UL << pong;
+    lat_partner_port = NULL;
+    lat_partner_done = FALSE;
+    SetSignal(0, lat_pong_mask);
+
+    lat_partner = CreateTask((STRPTR)XSYSINFO_NAME " latency", pri < 127 ? pri + 1 : pri,
+                             (APTR)latency_partner_entry, LAT_PARTNER_STACK);
+    if (!lat_partner) return FALSE;
+
+    Wait(lat_pong_mask);
+    if (lat_partner_done) {
+        lat_partner = NULL;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+static void stop_partner(void)
+{
+    if (!lat_partner) return;
+
+    Signal(lat_partner, SIGBREAKF_CTRL_C);
+    while (!lat_partner_done) {
+        Wait(lat_pong_mask);
+    }
+    lat_partner = NULL;
+}
+
+/*
+ * Signal() the partner and Wait() for its answer
+ */
+static void measure_signal_round_trip(void)
+{
+    LatencyStats *st = &latency_results.test[LAT_TEST_SIGNAL];
+    struct EClockVal start, end;
+    uint64_t sum = 0;
+    ULONG E_Freq;
+    ULONG i;
+
+    for (i = 0; i < LAT_ROUND_TRIPS; i++) {
+        read_benchmark_clock(&start);
+        Signal(lat_partner, lat_ping_mask);
+        Wait(lat_pong_mask);
+        E_Freq = read_benchmark_clock(&end);
+
+        stats_add(st, &sum, sample_ns(&start, &end, E_Freq));
+    }
+
+    stats_finish(LAT_TEST_SIGNAL, st, sum);
+}
+
+/*
+ * PutMsg() to the partner's port and wait for the reply
+ */
+static void measure_message_round_trip(void)
+{
+    LatencyStats *st = &latency_results.test[LAT_TEST_MESSAGE];
+    struct MsgPort *reply_port;
+    struct Message msg;
+    struct EClockVal start, end;
+    uint64_t sum = 0;
+    ULONG E_Freq;
+    ULONG i;
+
+    reply_port = CreatePort(NULL, 0);
+    if (!reply_port) return;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.mn_Node.ln_Type = NT_MESSAGE;
+    msg.mn_ReplyPort = reply_port;
+    msg.mn_Length = sizeof(msg);
+
+    for (i = 0; i < LAT_ROUND_TRIPS; i++) {
+        read_benchmark_clock(&start);
+        PutMsg(lat_partner_port, &msg);
+        WaitPort(reply_port);
+        GetMsg(reply_port);
+        E_Freq = read_benchmark_clock(&end);
+
+        stats_add(st, &sum, sample_ns(&start, &end, E_Freq));
+    }
+
+    DeletePort(reply_port);
+
+    stats_finish(LAT_TEST_MESSAGE, st, sum);
+}
+
+/*
+ * How long after the requested delay a UNIT_MICROHZ request returns.
+ * Uses its own request, the benchmark clock stays free for timing
+ */
+static void measure_timer_latency(void)
+{
+    LatencyStats *st = &latency_results.test[LAT_TEST_TIMER];
+    struct MsgPort *port;
+    struct timerequest *req = NULL;
+    struct EClockVal start, end;
+    uint64_t sum = 0;
+    ULONG E_Freq;
+    ULONG ns;
+    ULONG i;
+
+    port = CreatePort(NULL, 0);
+    if (!port) return;
+
+    req = (struct timerequest *)CreateExtIO(port, sizeof(struct timerequest));
+    if (!req) goto cleanup;
+
+    if (OpenDevice((CONST_STRPTR)"timer.device", UNIT_MICROHZ,
+                   (struct IORequest *)req, 0) != 0) {
+        DeleteExtIO((struct IORequest *)req);
+        req = NULL;
+        goto cleanup;
+    }
+
+    for (i = 0; i < LAT_TIMER_SAMPLES; i++) {
+        req->tr_node.io_Command = TR_ADDREQUEST;
+        req->tr_time.tv_secs = 0;
+        req->tr_time.tv_micro = LAT_TIMER_DELAY_US;
+
+        read_benchmark_clock(&start);
+        DoIO((struct IORequest *)req);
+        E_Freq = read_benchmark_clock(&end);
+
+        ns = sample_ns(&start, &end, E_Freq);
+        ns = ns > LAT_TIMER_DELAY_US * 1000 ? ns - LAT_TIMER_DELAY_US * 1000 : 0;
+        stats_add(st, &sum, ns);
+    }
+
+    CloseDevice((struct IORequest *)req);
+    DeleteExtIO((struct IORequest *)req);
+
+    stats_finish(LAT_TEST_TIMER, st, sum);
+
+cleanup:
+    DeletePort(port);
+}
+
+/*
+ * Cost of one Forbid()/Permit() or Disable()/Enable() pair
+ */
+static void measure_lock_cost(ULONG test)
+{
+    LatencyStats *st = &latency_results.test[test];
+    struct EClockVal start, end;
+    uint64_t sum = 0;
+    ULONG overhead_ns;
+    ULONG E_Freq;
+    ULONG ns;
+    ULONG s, i;
+
+    /* Same loop counter compensation as the other benchmarks */
+    overhead_ns = measure_loop_overhead(LAT_LOCK_LOOPS) * 1000 + lat_clock_ns;
+
+    for (s = 0; s < LAT_LOCK_SAMPLES; s++) {
+        if (test == LAT_TEST_FORBID) {
+            read_benchmark_clock(&start);
+            for (i = 0; i < LAT_LOCK_LOOPS; i++) {
+                Forbid();
+                Permit();
+            }
+            E_Freq = read_benchmark_clock(&end);
+        } else {
+            read_benchmark_clock(&start);
+            for (i = 0; i < LAT_LOCK_LOOPS; i++) {
+                Disable();
+                Enable();
+            }
+            E_Freq = read_benchmark_clock(&end);
+        }
+
+        ns = (ULONG)harness_clock_diff_ns(&start, &end, E_Freq);
+        ns = ns > overhead_ns ? ns - overhead_ns : 0;
+        stats_add(st, &sum, ns / LAT_LOCK_LOOPS);
+    }
+
+    stats_finish(test, st, sum);
+}
+
+/*
+ * Run all latency tests
+ */
+void run_latency_benchmarks(void)
+{
+    BYTE pong;
+
+    memset(&latency_results, 0, sizeof(latency_results));
+
+    if (!benchmark_timer_available()) return;
+
+    lat_clock_ns = harness_clock_overhead_ns();
+
+    pong = AllocSignal(-1);
+    if (pong != -1) {
+        if (start_partner(pong)) {
+            measure_signal_round_trip();
+            measure_message_round_trip();
+            stop_partner();
+        } else {
+            debug("  latency: cannot start partner task\n");
+        }
+        FreeSignal(pong);
+    }
+
+    measure_timer_latency();
+    measure_lock_cost(LAT_TEST_FORBID);
+    measure_lock_cost(LAT_TEST_DISABLE);
+
+    latency_results.valid = TRUE;
+}
+
+/*
+ * Draw latency table, microseconds with two decimals
+ */
+void draw_latency_bench(void)
+{
+    static const WORD columns[3] = { 260, 360, 460 };
+    static const LocaleStringID headers[3] = {
+        MSG_LAT_MIN, MSG_LAT_AVG, MSG_LAT_MAX
+    };
+    static const LocaleStringID tests[LAT_TESTS] = {
+        MSG_LAT_SIGNAL, MSG_LAT_MESSAGE, MSG_LAT_TIMER, MSG_LAT_FORBID, MSG_LAT_DISABLE
+    };
+    char buffer[64];
+    WORD y;
+    ULONG t, c;
+
+    /* Column headers */
+    y = 40;
+    draw_text(28, y, get_string(MSG_LAT_TEST), COLOR_TEXT);
+    for (c = 0; c < 3; c++) {
+        draw_text_right(columns[c], y, 88, get_string(headers[c]), COLOR_TEXT);
+    }
+
+    SetAPen(app->rp, COLOR_BUTTON_DARK);
+    Move(app->rp, 24, y + 4);
+    Draw(app->rp, 614, y + 4);
+
+    y = 56;
+    for (t = 0; t < LAT_TESTS; t++) {
+        const LatencyStats *st = &latency_results.test[t];
+        ULONG values[3];
+
+        values[0] = st->min_ns;
+        values[1] = st->avg_ns;
+        values[2] = st->max_ns;
+
+        draw_text(28, y, get_string(tests[t]), COLOR_TEXT);
+        for (c = 0; c < 3; c++) {
+            if (latency_results.valid && st->samples > 0) {
+                format_scaled(buffer, sizeof(buffer), values[c] / 10, FALSE);
+            } else {
+                snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_NA));
+            }
+            draw_text_right(columns[c], y, 88, buffer, COLOR_HIGHLIGHT);
+        }
+        y += 10;
+    }
+
+    if (!latency_results.valid) return;
+
+    y += 10;
+    draw_text(28, y, get_string(MSG_LAT_HINT), COLOR_TEXT);
+    draw_text(28, y + 10, hw_info.cpu_string, COLOR_TEXT);
+}
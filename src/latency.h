@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Exec scheduling latency benchmark header
+ */
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include "xsysinfo.h"
+
+/* Tests, each reported as min/avg/max */
+#define LAT_TEST_SIGNAL     0       /* Signal()/Wait() ping-pong round trip */
+#define LAT_TEST_MESSAGE    1       /* PutMsg()/ReplyMsg() round trip */
+#define LAT_TEST_TIMER      2       /* timer.device request, time past the delay */
+#define LAT_TEST_FORBID     3       /* Forbid()/Permit() pair */
+#define LAT_TEST_DISABLE    4       /* Disable()/Enable() pair */
+#define LAT_TESTS           5
+
+#define LAT_ROUND_TRIPS     256     /* Samples per ping-pong test */
+#define LAT_TIMER_SAMPLES   64
+#define LAT_TIMER_DELAY_US  2000    /* Requested UNIT_MICROHZ delay */
+#define LAT_LOCK_SAMPLES    32
+#define LAT_LOCK_LOOPS      1000    /* Pairs per Forbid/Disable sample */
+
+#define LAT_PARTNER_STACK   4096
+
+/* Statistics of one test */
+typedef struct {
+    ULONG min_ns;
+    ULONG avg_ns;
+    ULONG max_ns;
+    ULONG samples;              /* 0 = not run */
+} LatencyStats;
+
+typedef struct {
+    LatencyStats test[LAT_TESTS];
+    BOOL valid;
+} LatencyResults;
+
+extern LatencyResults latency_results;
+
+/* Function prototypes */
+void run_latency_benchmarks(void);
+const char *get_latency_test_name(ULONG test);
+void draw_latency_bench(void);
+
+#endif /* LATENCY_H */
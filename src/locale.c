@@ -304,6 +304,140 @@ static const char *default_strings[MSG_COUNT] = {
     /*MSG_MMU_FLAGS5_HINT*/     "SNG=Single Page RP=Repairable IO=IOspace",
     /*MSG_MMU_FLAGS6_HINT*/     "Ux=UserX SW=Swapped MAP=Remapped BN=Bundled",
     /*MSG_MMU_FLAGS7_HINT*/     "IND=Indirect +=more flags",
+    /* MSG_WRITE_SPEED */       "WRITE SPEED",
+    /* MSG_COPY_SPEED */        "COPY SPEED",
+    /* MSG_BYTE_COPY_SPEED */   "BYTE COPY",
+    /* MSG_MEM_READ */          "READ",
+    /* MSG_MEM_WRITE */         "WRITE",
+    /* MSG_MEM_COPY */          "COPY",
+    /* MSG_LATENCY */           "LATENCY",
+    /* MSG_BTN_SWEEP */         "SWEEP",
+    /* MSG_BTN_INFO */          "INFO",
+    /* MSG_BTN_QUEUE */         "QUEUE",
+    /* MSG_QUEUE_DEPTH */       "QD",
+    /* MSG_BTN_SEEK */          "SEEK",
+    /* MSG_IOPS */              "IOPS",
+    /* MSG_ACCESS_TIME */       "MS",
+    /* MSG_BTN_MATRIX */        "MATRIX",
+    /* MSG_TRANSFER_SIZE */     "SIZE",
+    /* MSG_FAST24_RAM */        "24BIT FAST",
+    /* MSG_FAST32_RAM */        "32BIT FAST",
+    /* MSG_MAX_TRANSFER */      "MAXTRANSFER",
+    /* MSG_DMA_MASK */          "MASK",
+    /* MSG_BTN_REFRESH */       "REFRESH",
+    /* MSG_PROBING_DRIVES */    "Probing Drives",
+    /* MSG_BTN_STOP */          "STOP",
+    /* MSG_HIST_PREV */         "PREV",
+    /* MSG_HIST_BEST */         "BEST",
+    /* MSG_HARDWARE_FPU */      "FPU OPS",
+    /* MSG_FPU_SUITE */         "FPU OPERATIONS",
+    /* MSG_MOPS */              "MOPS",
+    /* MSG_FPSP */              "EMULATED (FPSP)",
+    /* MSG_BTN_CPU */           "CPU",
+    /* MSG_BTN_RUN */           "RUN",
+    /* MSG_CPU_TIMING */        "CPU INSTRUCTION TIMING",
+    /* MSG_INSTRUCTION */       "INSTRUCTION",
+    /* MSG_CYCLES */            "CYCLES",
+    /* MSG_NS */                "NS",
+    /* MSG_EMULATED */          "EMULATED",
+    /* MSG_BTN_CACHES */        "CACHES",
+    /* MSG_BTN_TIMING */        "TIMING",
+    /* MSG_CACHE_MATRIX */      "CACHE CONFIGURATIONS",
+    /* MSG_SUPERS */            "SuperS",
+    /* MSG_BTN_FRAG */          "FRAG",
+    /* MSG_FRAGMENTATION */     "Fragmentation",
+    /* MSG_FRAG_SIZE */         "SIZE",
+    /* MSG_FRAG_CHUNKS */       "CHUNKS",
+    /* MSG_FRAG_FREE */         "FREE",
+    /* MSG_FRAG_FITS */         "FITS",
+    /* MSG_BTN_LIVE */          "LIVE",
+    /* MSG_MONITOR */           "SYSTEM MONITOR",
+    /* MSG_MON_CPU_LOAD */      "CPU LOAD",
+    /* MSG_MON_LARGEST */       "LARGEST",
+    /* MSG_MMU_TUNING */        "Tuning:",
+    /* MSG_MMU_NO_PROBLEMS */   "No MMU performance problems found",
+    /* MSG_MMU_FAST_INHIBITED */ "FAST cache-inhibited",
+    /* MSG_MMU_ZORRO_INHIBITED */ "Zorro RAM not cacheable",
+    /* MSG_MMU_FAST_WRITETHROUGH */ "FAST writethrough, not CB",
+    /* MSG_MMU_ROM_NOT_SHADOWED */ "ROM not shadowed to FAST",
+    /* MSG_MMU_CHIP_IMPRECISE */ "CHIP mapped imprecise",
+    /* MSG_MMU_FAST_SLOW */     "FAST no faster than CHIP",
+    /* MSG_BTN_DMA */           "DMA",
+    /* MSG_DMA_CONTENTION */    "CHIP BANDWIDTH UNDER DMA",
+    /* MSG_DMA_DISPLAY */       "DISPLAY",
+    /* MSG_DMA_LOSS */          "LOST",
+    /* MSG_BTN_BLITTER */       "BLITTER",
+    /* MSG_BLITTER_BENCH */     "BLITTER VS CPU THROUGHPUT",
+    /* MSG_BLIT_SIZE */         "SIZE",
+    /* MSG_BLIT_COPY */         "COPY MB/S",
+    /* MSG_BLIT_FILL */         "FILL MB/S",
+    /* MSG_BLIT_LINE */         "LINE MPX/S",
+    /* MSG_BLIT_CPU_COPY */     "CPU MB/S",
+    /* MSG_BLIT_WINS_ALL */     "Blitter copy faster at all sizes",
+    /* MSG_BLIT_CPU_WINS_ALL */ "CPU copy to CHIP faster at all sizes",
+    /* MSG_BLIT_CPU_WINS_UP_TO */ "CPU copy to CHIP faster up to",
+    /* MSG_HARDWARE_GFX */      "GFX OPS",
+    /* MSG_GFX_SUITE */         "GRAPHICS OPERATIONS",
+    /* MSG_GFX_CURRENT */       "Current",
+    /* MSG_GFX_MODE */          "Mode",
+    /* MSG_GFX_NO_MODE */       "No RTG screen mode",
+    /* MSG_BTN_SAFE */          "SAFE",
+    /* MSG_BTN_UNSAFE */        "UNSAFE",
+    /* MSG_BOARD_LATENCY */     "LATENCY",
+    /* MSG_BOARD_Z2_SPEED */    "Zorro III board running at Zorro II speed",
+    /* MSG_BOARD_NOT_TESTABLE */ "Not a memory board: mark it SAFE to test its I/O space",
+    /* MSG_BOARD_NOT_MEASURED */ "Press SPEED to measure this board",
+    /* MSG_HARDWARE_ROM */      "ROM",
+    /* MSG_ROM_SHADOW */        "KICKSTART ROM",
+    /* MSG_ROM_KICKSTART */     "Kickstart",
+    /* MSG_ROM_READ */          "ROM read",
+    /* MSG_ROM_FAST_READ */     "FAST read",
+    /* MSG_ROM_STATE */         "Shadowing",
+    /* MSG_ROM_NOT_SHADOWED */  "Not shadowed",
+    /* MSG_ROM_SHADOW_MMU */    "MMU remap",
+    /* MSG_ROM_SHADOW_FAST */   "At RAM speed",
+    /* MSG_ROM_CALL */          "Exec call",
+    /* MSG_ROM_CALL_PATCHED */  "FindTask() is patched",
+    /* MSG_ROM_MAPROM_HINT */   "MAPROM would speed up the OS",
+    /* MSG_HARDWARE_JIT */      "JIT",
+    /* MSG_JIT_TITLE */         "EMU68 JIT (COLD / WARM)",
+    /* MSG_JIT_NOT_EMU68 */     "Only measured on Emu68",
+    /* MSG_JIT_DHRY */          "Dhrystones",
+    /* MSG_JIT_MFLOPS */        "MFlops",
+    /* MSG_JIT_MEM */           "Mem read",
+    /* MSG_JIT_FLUSH */         "CacheClearU",
+    /* MSG_JIT_RETRANSLATE */   "Retranslate",
+    /* MSG_BTN_FS */            "FS",
+    /* MSG_FS_BUFFER */         "BUFFER",
+    /* MSG_FS_CREATE */         "CREATE FILES/S",
+    /* MSG_FS_DELETE */         "DELETE FILES/S",
+    /* MSG_FS_EXNEXT */         "EXNEXT ENTRIES/S",
+    /* MSG_FS_EXALL */          "EXALL ENTRIES/S",
+    /* MSG_EXEC_LATENCY */      "EXEC SCHEDULING LATENCY",
+    /* MSG_LAT_TEST */          "TEST",
+    /* MSG_LAT_MIN */           "MIN US",
+    /* MSG_LAT_AVG */           "AVG US",
+    /* MSG_LAT_MAX */           "MAX US",
+    /* MSG_LAT_SIGNAL */        "SIGNAL/WAIT ROUND TRIP",
+    /* MSG_LAT_MESSAGE */       "PUTMSG/REPLYMSG ROUND TRIP",
+    /* MSG_LAT_TIMER */         "TIMER REQUEST LATE BY",
+    /* MSG_LAT_FORBID */        "FORBID/PERMIT",
+    /* MSG_LAT_DISABLE */       "DISABLE/ENABLE",
+    /* MSG_LAT_HINT */          "Round trips include two task switches, timer asked for 2 ms",
+    /* MSG_SCSI_SPEED_TITLE */  "SCSI DRIVE CACHES AND READ(10) SPEED",
+    /* MSG_SCSI_READ_CACHE */   "Read",
+    /* MSG_SCSI_READ_AHEAD */   "Ahead",
+    /* MSG_SCSI_WRITE_CACHE */  "Write",
+    /* MSG_SCSI_BLOCKS */       "blk",
+    /* MSG_SCSI_SPEED_HINT */   "Caches from MODE SENSE page 8, READ(10) MB/s by blocks per command",
+    /* MSG_DMA_CURRENT */   "Current screen",
+    /* MSG_DMA_OFF */       "Display DMA off",
+    /* MSG_DMA_LORES_4 */   "Lores 4 colours",
+    /* MSG_DMA_HIRES_4 */   "Hires 4 colours",
+    /* MSG_DMA_HIRES_16 */  "Hires 16 colours",
+    /* MSG_DMA_LORES_EHB */ "Lores 64 EHB",
+    /* MSG_DMA_LORES_256 */ "Lores 256 colours",
+    /* MSG_DMA_HIRES_256 */ "Hires 256 colours",
 
 };
 
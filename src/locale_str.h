@@ -296,6 +296,140 @@ typedef enum {
     MSG_MMU_FLAGS5_HINT,
     MSG_MMU_FLAGS6_HINT,
     MSG_MMU_FLAGS7_HINT,
+    MSG_WRITE_SPEED,
+    MSG_COPY_SPEED,
+    MSG_BYTE_COPY_SPEED,
+    MSG_MEM_READ,
+    MSG_MEM_WRITE,
+    MSG_MEM_COPY,
+    MSG_LATENCY,
+    MSG_BTN_SWEEP,
+    MSG_BTN_INFO,
+    MSG_BTN_QUEUE,
+    MSG_QUEUE_DEPTH,
+    MSG_BTN_SEEK,
+    MSG_IOPS,
+    MSG_ACCESS_TIME,
+    MSG_BTN_MATRIX,
+    MSG_TRANSFER_SIZE,
+    MSG_FAST24_RAM,
+    MSG_FAST32_RAM,
+    MSG_MAX_TRANSFER,
+    MSG_DMA_MASK,
+    MSG_BTN_REFRESH,
+    MSG_PROBING_DRIVES,
+    MSG_BTN_STOP,
+    MSG_HIST_PREV,
+    MSG_HIST_BEST,
+    MSG_HARDWARE_FPU,
+    MSG_FPU_SUITE,
+    MSG_MOPS,
+    MSG_FPSP,
+    MSG_BTN_CPU,
+    MSG_BTN_RUN,
+    MSG_CPU_TIMING,
+    MSG_INSTRUCTION,
+    MSG_CYCLES,
+    MSG_NS,
+    MSG_EMULATED,
+    MSG_BTN_CACHES,
+    MSG_BTN_TIMING,
+    MSG_CACHE_MATRIX,
+    MSG_SUPERS,
+    MSG_BTN_FRAG,
+    MSG_FRAGMENTATION,
+    MSG_FRAG_SIZE,
+    MSG_FRAG_CHUNKS,
+    MSG_FRAG_FREE,
+    MSG_FRAG_FITS,
+    MSG_BTN_LIVE,
+    MSG_MONITOR,
+    MSG_MON_CPU_LOAD,
+    MSG_MON_LARGEST,
+    MSG_MMU_TUNING,
+    MSG_MMU_NO_PROBLEMS,
+    MSG_MMU_FAST_INHIBITED,
+    MSG_MMU_ZORRO_INHIBITED,
+    MSG_MMU_FAST_WRITETHROUGH,
+    MSG_MMU_ROM_NOT_SHADOWED,
+    MSG_MMU_CHIP_IMPRECISE,
+    MSG_MMU_FAST_SLOW,
+    MSG_BTN_DMA,
+    MSG_DMA_CONTENTION,
+    MSG_DMA_DISPLAY,
+    MSG_DMA_LOSS,
+    MSG_BTN_BLITTER,
+    MSG_BLITTER_BENCH,
+    MSG_BLIT_SIZE,
+    MSG_BLIT_COPY,
+    MSG_BLIT_FILL,
+    MSG_BLIT_LINE,
+    MSG_BLIT_CPU_COPY,
+    MSG_BLIT_WINS_ALL,
+    MSG_BLIT_CPU_WINS_ALL,
+    MSG_BLIT_CPU_WINS_UP_TO,
+    MSG_HARDWARE_GFX,
+    MSG_GFX_SUITE,
+    MSG_GFX_CURRENT,
+    MSG_GFX_MODE,
+    MSG_GFX_NO_MODE,
+    MSG_BTN_SAFE,
+    MSG_BTN_UNSAFE,
+    MSG_BOARD_LATENCY,
+    MSG_BOARD_Z2_SPEED,
+    MSG_BOARD_NOT_TESTABLE,
+    MSG_BOARD_NOT_MEASURED,
+    MSG_HARDWARE_ROM,
+    MSG_ROM_SHADOW,
+    MSG_ROM_KICKSTART,
+    MSG_ROM_READ,
+    MSG_ROM_FAST_READ,
+    MSG_ROM_STATE,
+    MSG_ROM_NOT_SHADOWED,
+    MSG_ROM_SHADOW_MMU,
+    MSG_ROM_SHADOW_FAST,
+    MSG_ROM_CALL,
+    MSG_ROM_CALL_PATCHED,
+    MSG_ROM_MAPROM_HINT,
+    MSG_HARDWARE_JIT,
+    MSG_JIT_TITLE,
+    MSG_JIT_NOT_EMU68,
+    MSG_JIT_DHRY,
+    MSG_JIT_MFLOPS,
+    MSG_JIT_MEM,
+    MSG_JIT_FLUSH,
+    MSG_JIT_RETRANSLATE,
+    MSG_BTN_FS,
+    MSG_FS_BUFFER,
+    MSG_FS_CREATE,
+    MSG_FS_DELETE,
+    MSG_FS_EXNEXT,
+    MSG_FS_EXALL,
+    MSG_EXEC_LATENCY,
+    MSG_LAT_TEST,
+    MSG_LAT_MIN,
+    MSG_LAT_AVG,
+    MSG_LAT_MAX,
+    MSG_LAT_SIGNAL,
+    MSG_LAT_MESSAGE,
+    MSG_LAT_TIMER,
+    MSG_LAT_FORBID,
+    MSG_LAT_DISABLE,
+    MSG_LAT_HINT,
+    MSG_SCSI_SPEED_TITLE,
+    MSG_SCSI_READ_CACHE,
+    MSG_SCSI_READ_AHEAD,
+    MSG_SCSI_WRITE_CACHE,
+    MSG_SCSI_BLOCKS,
+    MSG_SCSI_SPEED_HINT,
+    MSG_DMA_CURRENT,
+    MSG_DMA_OFF,
+    MSG_DMA_LORES_4,
+    MSG_DMA_HIRES_4,
+    MSG_DMA_HIRES_16,
+    MSG_DMA_LORES_EHB,
+    MSG_DMA_LORES_256,
+    MSG_DMA_HIRES_256,
     MSG_COUNT  /* Total number of strings */
 } LocaleStringID;
 
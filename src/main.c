@@ -14,6 +14,8 @@
 #include <intuition/screens.h>
 #include <graphics/gfxbase.h>
 #include <graphics/displayinfo.h>
+#include <graphics/clip.h>
+#include <graphics/regions.h>
 #include <libraries/identify.h>
 #include <dos/dosextens.h>
 #include <dos/rdargs.h>
@@ -34,7 +36,14 @@
 #include "memory.h"
 #include "boards.h"
 #include "drives.h"
+#include "inventory.h"
+#include "history.h"
+#include "monitor.h"
 #include "benchmark.h"
+#include "gfxbench.h"
+#include "cli.h"
+#include "profile.h"
+#include "pool.h"
 #include "locale_str.h"
 #include "debug.h"
 
@@ -58,6 +67,7 @@ BOOL g_debug_enabled = FALSE;
 
 /* Text-only mode (no GUI, print results to stdout) */
 static BOOL g_text_mode = FALSE;
+static BOOL g_monitor_mode = FALSE;
 
 /* Global application context */
 AppContext app_context;
@@ -69,15 +79,36 @@ struct TextAttr Topaz8Font = {
 };
 AppContext *app = &app_context;
 
-/* Command line argument template */
-#define TEMPLATE "DEBUG/S"
+/* Command line argument template. The old lower case forms
+ * ("repeat", "repeat=N") are parsed by hand when ReadArgs() fails */
+#define TEMPLATE "DEBUG/S,TEXT/S,MONITOR/S,REPEAT/K/N,GFXMODE/K," \
+                 "CPU/S,FPU/S,MEM/S,DRIVE/K,SCSI/S,QUIET/S," \
+                 "MINDHRY/K/N,MINMFLOPS/K/N,MINCHIP/K/N,MINFAST/K/N,MINDRIVE/K/N"
 
 /* Argument array indices */
 enum {
     ARG_DEBUG,
+    ARG_TEXT,
+    ARG_MONITOR,
+    ARG_REPEAT,
+    ARG_GFXMODE,
+    ARG_CPU,
+    ARG_FPU,
+    ARG_MEM,
+    ARG_DRIVE,
+    ARG_SCSI,
+    ARG_QUIET,
+    ARG_MINDHRY,
+    ARG_MINMFLOPS,
+    ARG_MINCHIP,
+    ARG_MINFAST,
+    ARG_MINDRIVE,
     ARG_COUNT
 };
 
+/* Headless test selection (CPU, FPU, MEM, DRIVE=, SCSI) */
+static CliOptions cli_options;
+
 /* Color palette matching original SysInfo */
 static const UWORD palette[8] = {
     0x0AAA,     /* 0: Gray screen background */
@@ -138,18 +169,143 @@ static int xstricmp(const char *o1, const char *o2)
     return 0;
 }
 
+/*
+ * Parse the run count of the repeat option ("repeat" or "repeat=N")
+ */
+static ULONG parse_repeat_count(const char *value)
+{
+    ULONG runs = 0;
+
+    if (!value || *value == '\0') {
+        return BENCH_DEFAULT_REPEAT;
+    }
+    while (*value >= '0' && *value <= '9') {
+        runs = runs * 10 + (ULONG)(*value - '0');
+        if (runs > BENCH_MAX_REPEAT) return BENCH_MAX_REPEAT;
+        value++;
+    }
+
+    return runs;
+}
+
+/*
+ * Parse a display mode ID given as hex, with optional 0x or $ prefix
+ * Returns INVALID_ID if the value is empty or not hex
+ */
+static ULONG parse_mode_id(const char *value)
+{
+    ULONG mode = 0;
+
+    if (!value) return INVALID_ID;
+    if (value[0] == '$') {
+        value++;
+    } else if (value[0] == '0' && (value[1] == 'x' || value[1] == 'X')) {
+        value += 2;
+    }
+    if (*value == '\0') return INVALID_ID;
+
+    while (*value) {
+        char c = *value++;
+        if (c >= '0' && c <= '9') {
+            mode = (mode << 4) | (ULONG)(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            mode = (mode << 4) | (ULONG)(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            mode = (mode << 4) | (ULONG)(c - 'A' + 10);
+        } else {
+            return INVALID_ID;
+        }
+    }
+
+    return mode;
+}
+
+/*
+ * Value of a /N argument, 0 if it was not given or is negative
+ */
+static ULONG numeric_arg(LONG arg)
+{
+    LONG value;
+
+    if (!arg) return 0;
+    value = *(LONG *)arg;
+    return value > 0 ? (ULONG)value : 0;
+}
+
+/*
+ * Parse the command line with ReadArgs() (dos.library V36+)
+ * Returns FALSE if it does not match the template
+ */
+static BOOL parse_readargs(void)
+{
+    LONG args[ARG_COUNT];
+    struct RDArgs *rdargs;
+
+    memset(args, 0, sizeof(args));
+    rdargs = ReadArgs((CONST_STRPTR)TEMPLATE, args, NULL);
+    if (!rdargs) return FALSE;
+
+    if (args[ARG_DEBUG]) g_debug_enabled = TRUE;
+    if (args[ARG_TEXT]) g_text_mode = TRUE;
+    if (args[ARG_MONITOR]) g_monitor_mode = TRUE;
+    if (args[ARG_REPEAT]) set_benchmark_repeat(numeric_arg(args[ARG_REPEAT]));
+    if (args[ARG_GFXMODE]) set_gfx_bench_mode(parse_mode_id((const char *)args[ARG_GFXMODE]));
+
+    if (args[ARG_CPU]) cli_options.tests |= CLI_TEST_CPU;
+    if (args[ARG_FPU]) cli_options.tests |= CLI_TEST_FPU;
+    if (args[ARG_MEM]) cli_options.tests |= CLI_TEST_MEM;
+    if (args[ARG_SCSI]) cli_options.tests |= CLI_TEST_SCSI;
+    if (args[ARG_DRIVE]) {
+        strncpy(cli_options.drive, (const char *)args[ARG_DRIVE], sizeof(cli_options.drive) - 1);
+        cli_options.tests |= CLI_TEST_DRIVE;
+    }
+    cli_options.quiet = args[ARG_QUIET] != 0;
+    cli_options.min_dhrystones = numeric_arg(args[ARG_MINDHRY]);
+    cli_options.min_mflops = numeric_arg(args[ARG_MINMFLOPS]);
+    cli_options.min_chip = numeric_arg(args[ARG_MINCHIP]);
+    cli_options.min_fast = numeric_arg(args[ARG_MINFAST]);
+    cli_options.min_drive = numeric_arg(args[ARG_MINDRIVE]);
+
+    /* Selected tests run without the GUI */
+    if (cli_options.tests) g_text_mode = TRUE;
+
+    FreeArgs(rdargs);
+    return TRUE;
+}
+
 /*
  * Parse command line arguments
  * Returns TRUE on success, FALSE on failure
  */
 static BOOL parse_args(int argc, char **argv)
 {
+    if (argc > 1 && DOSBase->dl_lib.lib_Version >= 36 && parse_readargs()) {
+        return TRUE;
+    }
+
     if (argc > 1) {
         for (int i = 1; i < argc; i++) {
             if (xstricmp(argv[i], "debug") == 0)
                 g_debug_enabled = TRUE;
             else if (xstricmp(argv[i], "text") == 0)
                 g_text_mode = TRUE;
+            else if (xstricmp(argv[i], "monitor") == 0)
+                g_monitor_mode = TRUE;
+            else if (xstricmp(argv[i], "repeat") == 0)
+                set_benchmark_repeat(BENCH_DEFAULT_REPEAT);
+            else if (strlen(argv[i]) > 7 && argv[i][6] == '=') {
+                char option[7];
+                strncpy(option, argv[i], 6);
+                option[6] = '\0';
+                if (xstricmp(option, "repeat") == 0)
+                    set_benchmark_repeat(parse_repeat_count(argv[i] + 7));
+            } else if (strlen(argv[i]) > 8 && argv[i][7] == '=') {
+                char option[8];
+                strncpy(option, argv[i], 7);
+                option[7] = '\0';
+                if (xstricmp(option, "gfxmode") == 0)
+                    set_gfx_bench_mode(parse_mode_id(argv[i] + 8));
+            }
         }
     }
     return TRUE;
@@ -199,6 +355,23 @@ static void parse_tooltypes(void)
             g_text_mode = TRUE;
         }
 
+        /* Check for MONITOR tooltype (start in the live monitor) */
+        if (FindToolType((CONST_STRPTR *)tooltypes, (CONST_STRPTR)"MONITOR")) {
+            g_monitor_mode = TRUE;
+        }
+
+        /* Check for REPEAT tooltype (REPEAT or REPEAT=N) */
+        value = (char *)FindToolType((CONST_STRPTR *)tooltypes, (CONST_STRPTR)"REPEAT");
+        if (value) {
+            set_benchmark_repeat(parse_repeat_count(value));
+        }
+
+        /* Check for GFXMODE tooltype (second screen of the graphics benchmark) */
+        value = (char *)FindToolType((CONST_STRPTR *)tooltypes, (CONST_STRPTR)"GFXMODE");
+        if (value) {
+            set_gfx_bench_mode(parse_mode_id(value));
+        }
+
         FreeDiskObject(dobj);
     }
 
@@ -211,6 +384,7 @@ static void parse_tooltypes(void)
 int main(int argc, char **argv)
 {
     int ret = RETURN_OK;
+    BOOL ok;
     debug(XSYSINFO_NAME ": Checking start...\n");
 
     /* Check if started from Workbench */
@@ -228,16 +402,27 @@ int main(int argc, char **argv)
     app->current_view = VIEW_MAIN;
     app->software_type = SOFTWARE_LIBRARIES;
     app->bar_scale = SCALE_SHRINK;
+    app->mem_speed_mode = MEMSPEED_READ;
     app->running = TRUE;
     app->pressed_button = -1;
 
+    debug(XSYSINFO_NAME ": Init timer...\n");
+    /* Initialize benchmark timer, first so the startup phases can be timed */
+    if (!init_timer()) {
+        Printf((CONST_STRPTR)"Failed to initialize timer\n");
+        ret = RETURN_FAIL;
+        goto cleanup;
+    }
+    profile_init();
+
     debug(XSYSINFO_NAME ": Initializing locale...\n");
     /* Initialize locale */
-    init_locale();
+    PROFILE_PHASE("init_locale", init_locale());
 
     debug(XSYSINFO_NAME ": Opening libraries...\n");
     /* Open required libraries */
-    if (!open_libraries()) {
+    PROFILE_PHASE("open_libraries", ok = open_libraries());
+    if (!ok) {
         ret = RETURN_FAIL;
         goto cleanup;
     }
@@ -249,7 +434,8 @@ int main(int argc, char **argv)
 
     debug(XSYSINFO_NAME ": Detecting hardware...\n");
     /* Detect hardware */
-    if (!detect_hardware()) {
+    PROFILE_PHASE("detect_hardware", ok = detect_hardware());
+    if (!ok) {
         Printf((CONST_STRPTR)"Failed to detect hardware\n");
         ret = RETURN_FAIL;
         goto cleanup;
@@ -257,31 +443,19 @@ int main(int argc, char **argv)
 
     debug(XSYSINFO_NAME ": Enumerating software...\n");
     /* Enumerate system software */
-    enumerate_all_software();
+    PROFILE_PHASE("enumerate_all_software", enumerate_all_software());
 
-    debug(XSYSINFO_NAME ": Enumerating memory...\n");
-    /* Enumerate memory regions */
-    enumerate_memory_regions();
-
-    debug(XSYSINFO_NAME ": Enumerating boards...\n");
-    /* Enumerate expansion boards */
-    enumerate_boards();
-
-    debug(XSYSINFO_NAME ": Enumerating drives...\n");
-    /* Enumerate drives */
-    enumerate_drives();
-
-    debug(XSYSINFO_NAME ": Init timer...\n");
-    /* Initialize benchmark timer */
-    if (!init_timer()) {
-        Printf((CONST_STRPTR)"Failed to initialize timer\n");
-        ret = RETURN_FAIL;
-        goto cleanup;
+    /* Earlier runs to compare with, read before anything is drawn */
+    if (!cli_options.tests) {
+        PROFILE_PHASE("history_init", history_init());
     }
 
+    /* Memory, boards and drives are enumerated on first use, see ensure_enumerated() */
+
     if (!g_text_mode) {
         debug(XSYSINFO_NAME ": Opening display...\n");
-        if (!open_display()) {
+        PROFILE_PHASE("open_display", ok = open_display());
+        if (!ok) {
             Printf((CONST_STRPTR)"%s\n", (LONG)get_string(MSG_ERR_NO_WINDOW));
             ret = RETURN_FAIL;
             goto cleanup;
@@ -291,14 +465,21 @@ int main(int argc, char **argv)
         init_buttons();
 
         debug(XSYSINFO_NAME ": Draw screen...\n");
-        redraw_current_view();
+        if (g_monitor_mode) {
+            switch_to_view(VIEW_MONITOR);
+        } else {
+            PROFILE_PHASE("redraw_current_view", redraw_current_view());
+        }
 
         debug(XSYSINFO_NAME ": Start main loop...\n");
         main_loop();
+    } else if (cli_options.tests) {
+        ret = run_cli_tests(&cli_options);
     } else {
         char buffer[16];
 
         run_benchmarks();
+        history_record_run();
 
         printf("CPU: %s MHz: ", hw_info.cpu_string);
         if (hw_info.cpu_mhz > 0) {
@@ -324,6 +505,28 @@ int main(int argc, char **argv)
             printf("%lu\n", (unsigned long)bench_results.dhrystones);
         else
             printf("%s\n", get_string(MSG_NA));
+        if (bench_results.benchmarks_valid && bench_results.dhry_stats.runs > 1) {
+            printf("  median of %lu runs, min %lu max %lu sd %lu%s\n",
+                   (unsigned long)bench_results.dhry_stats.runs,
+                   (unsigned long)bench_results.dhry_stats.min,
+                   (unsigned long)bench_results.dhry_stats.max,
+                   (unsigned long)bench_results.dhry_stats.stddev,
+                   bench_results.dhry_stats.unstable ? " (unstable)" : "");
+        }
+        if (bench_results.benchmarks_valid &&
+            bench_results.dhry_build != DHRY_BUILD_68000) {
+            printf("  native %s build: %lu\n",
+                   get_dhry_build_name(bench_results.dhry_build),
+                   (unsigned long)bench_results.dhrystones_native);
+        }
+        if (bench_results.benchmarks_valid && history_get_previous()) {
+            char prev_str[12], best_str[12];
+            format_history_delta(prev_str, sizeof(prev_str), bench_results.dhrystones,
+                                 history_get_previous()->dhrystones);
+            format_history_delta(best_str, sizeof(best_str), bench_results.dhrystones,
+                                 history_get_best()->dhrystones);
+            printf("  vs previous run %s, vs best run %s\n", prev_str, best_str);
+        }
 
         printf("MIPS: ");
         if (bench_results.benchmarks_valid) {
@@ -338,6 +541,16 @@ int main(int argc, char **argv)
             && hw_info.fpu_enabled) {
             format_scaled(buffer, sizeof(buffer), bench_results.mflops, TRUE);
             printf("%s\n", buffer);
+            if (bench_results.mflops_stats.runs > 1) {
+                char min_buf[16], max_buf[16], sd_buf[16];
+                format_scaled(min_buf, sizeof(min_buf), bench_results.mflops_stats.min, TRUE);
+                format_scaled(max_buf, sizeof(max_buf), bench_results.mflops_stats.max, TRUE);
+                format_scaled(sd_buf, sizeof(sd_buf), bench_results.mflops_stats.stddev, TRUE);
+                printf("  median of %lu runs, min %s max %s sd %s%s\n",
+                       (unsigned long)bench_results.mflops_stats.runs,
+                       min_buf, max_buf, sd_buf,
+                       bench_results.mflops_stats.unstable ? " (unstable)" : "");
+            }
         } else {
             printf("%s\n", get_string(MSG_NA));
         }
@@ -362,9 +575,40 @@ int main(int argc, char **argv)
         else
             snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_NA));
         printf("ROM speed: %s MB/s\n", buffer);
+
+        if (bench_results.benchmarks_valid && bench_results.chip_write_speed > 0)
+            format_scaled(buffer, sizeof(buffer),
+                          bench_results.chip_write_speed / 10000, TRUE);
+        else
+            snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_NA));
+        printf("Chip RAM write speed: %s MB/s\n", buffer);
+
+        if (bench_results.benchmarks_valid && bench_results.fast_write_speed > 0)
+            format_scaled(buffer, sizeof(buffer),
+                          bench_results.fast_write_speed / 10000, TRUE);
+        else
+            snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_NA));
+        printf("Fast RAM write speed: %s MB/s\n", buffer);
+
+        if (bench_results.benchmarks_valid && bench_results.chip_copy_speed > 0)
+            format_scaled(buffer, sizeof(buffer),
+                          bench_results.chip_copy_speed / 10000, TRUE);
+        else
+            snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_NA));
+        printf("Chip RAM copy speed: %s MB/s\n", buffer);
+
+        if (bench_results.benchmarks_valid && bench_results.fast_copy_speed > 0)
+            format_scaled(buffer, sizeof(buffer),
+                          bench_results.fast_copy_speed / 10000, TRUE);
+        else
+            snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_NA));
+        printf("Fast RAM copy speed: %s MB/s\n", buffer);
     }
 
 cleanup:
+    inventory_cleanup();
+    history_cleanup();
+    pool_cleanup();
     cleanup_timer();
     close_display();
     close_libraries();
@@ -849,18 +1093,45 @@ static void release_pens(void)
 static void main_loop(void)
 {
     struct IntuiMessage *msg;
+    struct Message *bench_msg;
     ULONG signals;
     ULONG win_signal;
+    ULONG bench_signal = 0;
+    ULONG monitor_sig;
 
     win_signal = 1L << app->window->UserPort->mp_SigBit;
 
+    /* Progress from the background benchmark task */
+    app->bench_port = CreatePort(NULL, 0);
+    if (app->bench_port) {
+        bench_signal = 1L << app->bench_port->mp_SigBit;
+    }
+
     while (app->running) {
-        signals = Wait(win_signal | SIGBREAKF_CTRL_C);
+        /* The monitor timer only exists while its view is shown */
+        monitor_sig = monitor_signal();
+        signals = Wait(win_signal | bench_signal | monitor_sig | SIGBREAKF_CTRL_C);
 
-        /* Check for break */
+        /* Check for break, cancels a running benchmark first */
         if (signals & SIGBREAKF_CTRL_C) {
-            app->running = FALSE;
-            break;
+            if (benchmark_task_running()) {
+                cancel_benchmark_task();
+            } else {
+                app->running = FALSE;
+                break;
+            }
+        }
+
+        /* Process benchmark progress */
+        if (app->bench_port) {
+            while ((bench_msg = GetMsg(app->bench_port)) != NULL) {
+                handle_benchmark_progress((BenchProgressMsg *)bench_msg);
+            }
+        }
+
+        /* Sample and draw the live monitor */
+        if (signals & monitor_sig) {
+            handle_monitor_signal();
         }
 
         /* Process window messages */
@@ -954,8 +1225,7 @@ static void main_loop(void)
                         case 's':
                         case 'S':
                             if (app->current_view == VIEW_MAIN) {
-                                run_benchmarks();
-                                redraw_current_view();
+                                handle_button_press(BTN_SPEED);
                             }
                             break;
                         case 'p':
@@ -969,12 +1239,27 @@ static void main_loop(void)
 
                 case IDCMP_REFRESHWINDOW:
                     BeginRefresh(app->window);
-                    redraw_current_view();
+                    /* Repaint only the panels under the damage */
+                    {
+                        struct Rectangle *damage =
+                            &app->window->WLayer->DamageList->bounds;
+                        mark_dirty_rect(damage->MinX, damage->MinY,
+                                        damage->MaxX, damage->MaxY);
+                    }
+                    redraw_dirty();
                     EndRefresh(app->window, TRUE);
                     break;
             }
         }
     }
+
+    /* Never leave the benchmark process running on exit */
+    stop_benchmark_task();
+    stop_monitor();
+    if (app->bench_port) {
+        DeletePort(app->bench_port);
+        app->bench_port = NULL;
+    }
 }
 
 /*
@@ -1033,6 +1318,34 @@ const char *get_location_string(MemoryLocation loc)
     }
 }
 
+/*
+ * Enumerate subsystems (ENUM_* flags) that have not been enumerated yet.
+ * Deferred until a view or the report needs them, so the main view
+ * comes up right after hardware detection
+ */
+void ensure_enumerated(ULONG subsystems)
+{
+    static ULONG enumerated = 0;
+    ULONG todo = subsystems & ~enumerated;
+
+    if (todo & ENUM_MEMORY) {
+        debug(XSYSINFO_NAME ": Enumerating memory...\n");
+        PROFILE_PHASE("enumerate_memory_regions", enumerate_memory_regions());
+    }
+
+    if (todo & ENUM_BOARDS) {
+        debug(XSYSINFO_NAME ": Enumerating boards...\n");
+        PROFILE_PHASE("enumerate_boards", enumerate_boards());
+    }
+
+    if (todo & ENUM_DRIVES) {
+        debug(XSYSINFO_NAME ": Enumerating drives...\n");
+        PROFILE_PHASE("enumerate_drives", enumerate_drives());
+    }
+
+    enumerated |= todo;
+}
+
 /*
  * Utility: Format byte size to human-readable string with fractions
  * Uses fixed-point math (x100) via format_scaled
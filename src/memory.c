@@ -11,23 +11,78 @@
 
 #include <exec/execbase.h>
 #include <exec/memory.h>
+#include <intuition/intuitionbase.h>
+#include <intuition/screens.h>
+#include <graphics/modeid.h>
+#include <graphics/view.h>
+#include <hardware/dmabits.h>
 
 #include <proto/exec.h>
 #include <proto/graphics.h>
+#include <proto/intuition.h>
 
 #include "xsysinfo.h"
 #include "memory.h"
 #include "gui.h"
 #include "locale_str.h"
 #include "benchmark.h"
+#include "pool.h"
 #include "debug.h"
 #include "hardware.h"
+#include "cpu.h"
 
 /* Global memory region list */
 MemoryRegionList memory_regions;
 
+/* Width of the cache-size sweep bars in the memory view */
+#define SWEEP_BAR_WIDTH 320
+
+/* Fragmentation histogram bars and chunk address map */
+#define FRAG_BAR_WIDTH      160
+#define FRAG_MAP_X          292
+#define FRAG_MAP_CELL_WIDTH 4
+
+/* Pointer-chase working-set sizes (each step is 4x the previous one) */
+const ULONG latency_sizes[MEM_LATENCY_SIZES] = {
+    1024, 4096, 16384, 65536, 262144
+};
+
+/* Last DMA contention run */
+DmaContention dma_contention;
+
+/* How the display is set up for a DMA contention row */
+typedef enum {
+    DMA_CURRENT,            /* Whatever screen is shown, like the main benchmark */
+    DMA_OFF,                /* Bitplane, copper and sprite DMA switched off */
+    DMA_SCREEN              /* A blank test screen of the given mode in front */
+} DmaSetup;
+
+typedef struct {
+    LocaleStringID name;
+    DmaSetup setup;
+    ULONG display_id;       /* Test screen mode on V36+ */
+    UWORD view_modes;       /* Same for OpenScreen() on 1.3 */
+    UWORD depth;
+    BOOL aga_only;
+} DmaConfig;
+
+/* Row the loss of the others is relative to */
+#define DMA_CONFIG_OFF  1
+
+static const DmaConfig dma_configs[DMA_CONFIGS] = {
+    { MSG_DMA_CURRENT,   DMA_CURRENT, 0,                  0,               0, FALSE },
+    { MSG_DMA_OFF,       DMA_OFF,     0,                  0,               0, FALSE },
+    { MSG_DMA_LORES_4,   DMA_SCREEN,  LORES_KEY,          0,               2, FALSE },
+    { MSG_DMA_HIRES_4,   DMA_SCREEN,  HIRES_KEY,          HIRES,           2, FALSE },
+    { MSG_DMA_HIRES_16,  DMA_SCREEN,  HIRES_KEY,          HIRES,           4, FALSE },
+    { MSG_DMA_LORES_EHB, DMA_SCREEN,  EXTRAHALFBRITE_KEY, EXTRA_HALFBRITE, 6, FALSE },
+    { MSG_DMA_LORES_256, DMA_SCREEN,  LORES_KEY,          0,               8, TRUE },
+    { MSG_DMA_HIRES_256, DMA_SCREEN,  HIRES_KEY,          HIRES,           8, TRUE },
+};
+
 /* External references */
 extern struct ExecBase *SysBase;
+extern struct IntuitionBase *IntuitionBase;
 extern HardwareInfo hw_info;
 extern AppContext *app;
 
@@ -75,39 +130,123 @@ const char *get_memory_type_string(UWORD attrs, APTR addr)
 }
 
 /*
- * Analyze memory region - count chunks and find largest block
+ * Smallest chunk size counted in a fragmentation size class
+ */
+ULONG mem_frag_bucket_size(ULONG bucket)
+{
+    return bucket == 0 ? MEM_BLOCKSIZE : 32UL << bucket;
+}
+
+/*
+ * Size class of a free chunk
+ */
+static ULONG mem_frag_bucket(ULONG bytes)
+{
+    ULONG bucket = 0;
+
+    while (bucket < MEM_FRAG_BUCKETS - 1 && bytes >= mem_frag_bucket_size(bucket + 1)) {
+        bucket++;
+    }
+    return bucket;
+}
+
+/*
+ * Analyze memory region - count chunks, find largest block and build the
+ * size-class histogram and address map of the free list (call in Forbid)
  */
-void analyze_memory_region(struct MemHeader *mh, ULONG *chunks, ULONG *largest)
+void analyze_memory_region(struct MemHeader *mh, MemoryRegion *region)
 {
+    static ULONG cell_free[MEM_FRAG_MAP_CELLS];
+    MemFragmentation *frag = &region->fragmentation;
     struct MemChunk *mc;
     ULONG count = 0;
     ULONG max_size = 0;
+    ULONG total = 0;
+    ULONG span, cell_size;
+    ULONG i;
 
-    *chunks = 0;
-    *largest = 0;
+    region->num_chunks = 0;
+    region->largest_block = 0;
+    memset(frag, 0, sizeof(MemFragmentation));
 
     if (!mh) return;
 
+    span = (ULONG)mh->mh_Upper - (ULONG)mh->mh_Lower;
+    cell_size = (span + MEM_FRAG_MAP_CELLS - 1) / MEM_FRAG_MAP_CELLS;
+    if (cell_size == 0) cell_size = 1;
+    memset(cell_free, 0, sizeof(cell_free));
+
     /* Walk the free list */
     for (mc = mh->mh_First; mc != NULL; mc = mc->mc_Next) {
+        ULONG bytes = mc->mc_Bytes;
+        ULONG offset = (ULONG)mc - (ULONG)mh->mh_Lower;
+        ULONG end = offset + bytes;
+        ULONG bucket = mem_frag_bucket(bytes);
+
         count++;
-        if (mc->mc_Bytes > max_size) {
-            max_size = mc->mc_Bytes;
+        total += bytes;
+        if (bytes > max_size) {
+            max_size = bytes;
+        }
+
+        frag->chunks[bucket]++;
+        frag->bytes[bucket] += bytes;
+        for (i = 0; i <= bucket; i++) {
+            frag->fits[i] += bytes / mem_frag_bucket_size(i);
+        }
+
+        /* Spread the chunk over the address slices it covers */
+        while (offset < end && offset < span) {
+            ULONG cell = offset / cell_size;
+            ULONG cell_end = (cell + 1) * cell_size;
+            ULONG n = (end < cell_end ? end : cell_end) - offset;
+
+            cell_free[cell] += n;
+            offset += n;
         }
     }
 
-    *chunks = count;
-    *largest = max_size;
+    region->num_chunks = count;
+    region->largest_block = max_size;
+
+    for (i = 0; i < MEM_FRAG_MAP_CELLS; i++) {
+        frag->map[i] = (UBYTE)(((uint64_t)cell_free[i] * 100) / cell_size);
+    }
+
+    /* Share of free memory that is not in the largest block */
+    if (total > 0) {
+        frag->index = 100 - (ULONG)(((uint64_t)max_size * 100) / total);
+    }
 }
 
 /*
  * Enumerate all memory regions
+ *
+ * The list is sized first and named afterwards, so that no allocation
+ * changes the free lists while they are being analyzed.
  */
 void enumerate_memory_regions(void)
 {
     struct MemHeader *mh;
+    MemoryRegion *regions;
+    ULONG count = 0;
+    ULONG i;
 
-    memset(&memory_regions, 0, sizeof(memory_regions));
+    memory_regions.count = 0;
+
+    Forbid();
+    for (mh = (struct MemHeader *)SysBase->MemList.lh_Head;
+         (struct Node *)mh != (struct Node *)&SysBase->MemList.lh_Tail;
+         mh = (struct MemHeader *)mh->mh_Node.ln_Succ) {
+        count++;
+    }
+    Permit();
+
+    regions = pool_grow(memory_regions.regions, &memory_regions.capacity, count,
+                        sizeof(MemoryRegion));
+    if (!regions) return;
+    memory_regions.regions = regions;
+    memset(regions, 0, memory_regions.capacity * sizeof(MemoryRegion));
 
     Forbid();
 
@@ -115,7 +254,8 @@ void enumerate_memory_regions(void)
          (struct Node *)mh != (struct Node *)&SysBase->MemList.lh_Tail;
          mh = (struct MemHeader *)mh->mh_Node.ln_Succ) {
 
-        if (memory_regions.count >= MAX_MEMORY_REGIONS) break;
+        /* Memory added since it was counted */
+        if (memory_regions.count >= memory_regions.capacity) break;
 
         MemoryRegion *region = &memory_regions.regions[memory_regions.count];
 
@@ -140,24 +280,23 @@ void enumerate_memory_regions(void)
             }
         }
 
-        analyze_memory_region(mh, &region->num_chunks, &region->largest_block);
-
-        if (mh->mh_Node.ln_Name) {
-            strncpy(region->node_name, mh->mh_Node.ln_Name,
-                    sizeof(region->node_name) - 1);
-        } else {
-            strncpy(region->node_name, "(unnamed)",
-                    sizeof(region->node_name) - 1);
-        }
-
-        strncpy(region->type_string,
-                get_memory_type_string(mh->mh_Attributes, mh->mh_Lower),
-                sizeof(region->type_string) - 1);
+        analyze_memory_region(mh, region);
 
         memory_regions.count++;
     }
 
     Permit();
+
+    /* MemHeaders are never removed, their names stay valid */
+    for (i = 0; i < memory_regions.count; i++) {
+        MemoryRegion *region = &memory_regions.regions[i];
+        struct MemHeader *node = region->memListNode;
+
+        region->node_name = pool_string(node->mh_Node.ln_Name ?
+                                        node->mh_Node.ln_Name : "(unnamed)");
+        region->type_string = pool_string(get_memory_type_string(node->mh_Attributes,
+                                                                 node->mh_Lower));
+    }
 }
 
 /*
@@ -180,7 +319,7 @@ void refresh_memory_region(ULONG index)
             MemoryRegion *region = &memory_regions.regions[index];
             region->first_free = mh->mh_First;
             region->amount_free = mh->mh_Free;
-            analyze_memory_region(mh, &region->num_chunks, &region->largest_block);
+            analyze_memory_region(mh, region);
             break;
         }
         i++;
@@ -190,34 +329,11 @@ void refresh_memory_region(ULONG index)
 }
 
 /*
- * Measure memory read speed for a region
- * Returns bytes per second
+ * Allocate a buffer in exactly the given region (to avoid any mem corruption)
+ * Returns NULL if the region cannot satisfy the request
  */
-ULONG measure_memory_speed(ULONG index)
+static APTR alloc_in_region(MemoryRegion *region, ULONG size)
 {
-    MemoryRegion *region;
-    ULONG buffer_size;
-    ULONG bytes_per_sec = 0;
-
-    if (index >= memory_regions.count) return 0;
-
-    region = &memory_regions.regions[index];
-
-    /* Use a reasonable buffer size - 64K for test reads */
-    buffer_size = 64 * 1024;
-
-    /* Limit to largest available block (halved for safety margin) */
-    if (buffer_size > region->largest_block / 2) {
-        buffer_size = region->largest_block / 2;
-    }
-
-    /* Ensure reasonable minimum size */
-    if (buffer_size < 256) {
-        region->speed_measured = TRUE;
-        region->speed_bytes_sec = 0;
-        return 0;
-    }
-
     /*
         Mega magic: I want to allocate a buffer in exactly this region (to avoid any mem corruption)
         So what to do (according to Thomas Richter):
@@ -251,7 +367,7 @@ ULONG measure_memory_speed(ULONG index)
         mh->mh_Node.ln_Succ = (struct Node *)mh;
         mh->mh_Node.ln_Pred = (struct Node *)mh;
         //AllocMem
-        buffer = AllocMem(buffer_size, region->mem_type | MEMF_CLEAR);
+        buffer = AllocMem(size, region->mem_type | MEMF_CLEAR);
         //restore the old pointers
         SysBase->MemList.lh_Head = (struct Node *)oldHead;
         SysBase->MemList.lh_Tail = (struct Node *)oldTail;
@@ -261,54 +377,493 @@ ULONG measure_memory_speed(ULONG index)
     }
     Permit();
 
+    return buffer;
+}
+
+/*
+ * Measure memory read speed for a region
+ * Returns bytes per second
+ */
+ULONG measure_memory_speed(ULONG index)
+{
+    MemoryRegion *region;
+    ULONG buffer_size;
+    ULONG bytes_per_sec = 0;
+    APTR buffer;
+
+    if (index >= memory_regions.count) return 0;
+
+    region = &memory_regions.regions[index];
+
+    /* Use a reasonable buffer size - 64K for test reads */
+    buffer_size = 64 * 1024;
+
+    /* Limit to largest available block (halved for safety margin) */
+    if (buffer_size > region->largest_block / 2) {
+        buffer_size = region->largest_block / 2;
+    }
+
+    /* Ensure reasonable minimum size */
+    if (buffer_size < 256) {
+        region->speed_measured = TRUE;
+        region->speed_bytes_sec = 0;
+        region->write_bytes_sec = 0;
+        region->copy_bytes_sec = 0;
+        region->byte_copy_bytes_sec = 0;
+        return 0;
+    }
+
+    buffer = alloc_in_region(region, buffer_size);
+
     if (buffer) { // we found memory
         /* Use shared benchmark function (16 iterations) */
         bytes_per_sec = measure_mem_read_speed((volatile ULONG *)buffer, buffer_size, 16);
+        region->write_bytes_sec = measure_mem_write_speed((volatile ULONG *)buffer, buffer_size, 16);
+        region->copy_bytes_sec = measure_mem_copy_speed((volatile ULONG *)buffer, buffer_size, 16,
+                                                        select_copy_kernel(region->mem_type));
+        /* Byte copy is slow, fewer passes are plenty */
+        region->byte_copy_bytes_sec = measure_mem_copy_speed((volatile ULONG *)buffer, buffer_size, 4,
+                                                             ASM_COPY_BYTE);
         FreeMem(buffer, buffer_size);
         region->speed_bytes_sec = bytes_per_sec;
         region->speed_measured = TRUE;
     } else {
         region->speed_measured = TRUE; //got no membrain : nothing to try again!
         region->speed_bytes_sec = 0;
+        region->write_bytes_sec = 0;
+        region->copy_bytes_sec = 0;
+        region->byte_copy_bytes_sec = 0;
         bytes_per_sec = 0;
     }
     return bytes_per_sec;
 }
 
 /*
- * Draw memory view
+ * Measure pointer-chase latency for a region at all working-set sizes
+ * that fit into its largest free block
+ */
+void measure_memory_latency(ULONG index)
+{
+    MemoryRegion *region;
+    ULONG buffer_size;
+    APTR buffer;
+    int i;
+
+    if (index >= memory_regions.count) return;
+
+    region = &memory_regions.regions[index];
+
+    for (i = 0; i < MEM_LATENCY_SIZES; i++) {
+        region->latency_ns_x100[i] = 0;
+    }
+    region->latency_measured = TRUE;
+
+    /* Biggest working set that fits (halved for safety margin) */
+    buffer_size = latency_sizes[MEM_LATENCY_SIZES - 1];
+    while (buffer_size > latency_sizes[0] && buffer_size > region->largest_block / 2) {
+        buffer_size /= 4;
+    }
+    if (buffer_size > region->largest_block / 2) return;
+
+    /* Extra line for 16 byte alignment */
+    buffer = alloc_in_region(region, buffer_size + 16);
+    if (!buffer) return;
+
+    for (i = 0; i < MEM_LATENCY_SIZES && latency_sizes[i] <= buffer_size; i++) {
+        region->latency_ns_x100[i] = measure_mem_latency((volatile ULONG *)buffer,
+                                                         latency_sizes[i],
+                                                         MEM_LATENCY_ACCESSES);
+    }
+
+    FreeMem(buffer, buffer_size + 16);
+}
+
+/*
+ * Run the cache-size sweep for a region, using the biggest working set
+ * that fits into its largest free block
  */
+void measure_memory_sweep(ULONG index)
+{
+    MemoryRegion *region;
+    ULONG buffer_size;
+    APTR buffer;
+
+    if (index >= memory_regions.count) return;
+
+    region = &memory_regions.regions[index];
+    memset(&region->cache_sweep, 0, sizeof(region->cache_sweep));
+
+    /* Limit to largest available block (halved for safety margin) */
+    buffer_size = CACHE_SWEEP_MAX_SIZE;
+    while (buffer_size > CACHE_SWEEP_MIN_SIZE && buffer_size > region->largest_block / 2) {
+        buffer_size /= 2;
+    }
+    if (buffer_size > region->largest_block / 2) {
+        region->cache_sweep.valid = TRUE;
+        return;
+    }
+
+    /* Extra line for 16 byte alignment */
+    buffer = alloc_in_region(region, buffer_size + 16);
+    if (!buffer) {
+        region->cache_sweep.valid = TRUE;
+        return;
+    }
+
+    run_cache_sweep((volatile ULONG *)buffer, buffer_size + 16, &region->cache_sweep);
+
+    FreeMem(buffer, buffer_size + 16);
+}
+
+const char *get_dma_config_name(ULONG config)
+{
+    return config < DMA_CONFIGS ? get_string(dma_configs[config].name) : "";
+}
+
 /*
- * Draw memory data area (info panel and navigation buttons - no title)
+ * Open a blank screen in front so its bitplanes are fetched
  */
-static void draw_memory_data(BOOL full_redraw)
+static struct Screen *open_dma_screen(const DmaConfig *config)
+{
+    struct NewScreen ns;
+    WORD width = (config->view_modes & HIRES) ? 640 : 320;
+    WORD height = app->is_pal ? SCREEN_HEIGHT_PAL : SCREEN_HEIGHT_NTSC;
+
+    if (IntuitionBase->LibNode.lib_Version >= 36) {
+        return OpenScreenTags(NULL,
+            SA_Width, width,
+            SA_Height, height,
+            SA_Depth, config->depth,
+            SA_DisplayID, config->display_id,
+            SA_Type, CUSTOMSCREEN,
+            SA_Quiet, TRUE,
+            SA_ShowTitle, FALSE,
+            TAG_DONE);
+    }
+
+    memset(&ns, 0, sizeof(ns));
+    ns.Width = width;
+    ns.Height = height;
+    ns.Depth = config->depth;
+    ns.ViewModes = config->view_modes;
+    ns.Type = CUSTOMSCREEN | SCREENQUIET;
+    return OpenScreen(&ns);
+}
+
+static void measure_dma_row(volatile ULONG *buffer, ULONG config)
+{
+    dma_contention.read_bytes_sec[config] =
+        measure_mem_read_speed(buffer, DMA_TEST_SIZE, DMA_TEST_ITERATIONS);
+    dma_contention.write_bytes_sec[config] =
+        measure_mem_write_speed(buffer, DMA_TEST_SIZE, DMA_TEST_ITERATIONS);
+}
+
+/*
+ * Measure CHIP RAM read and write speed with the same kernels as the
+ * main benchmark, once per display setup. A test screen is shown in
+ * front while its row is measured; with display DMA off the screen
+ * goes black for a moment.
+ */
+void measure_dma_contention(ULONG index)
+{
+    volatile UWORD *dmacon = (volatile UWORD *)CUSTOM_DMACON;
+    volatile UWORD *dmaconr = (volatile UWORD *)CUSTOM_DMACONR;
+    const UWORD display_dma = DMAF_RASTER | DMAF_COPPER | DMAF_SPRITE;
+    BOOL aga = (hw_info.agnus_type == AGNUS_ALICE_NTSC ||
+                hw_info.agnus_type == AGNUS_ALICE_PAL ||
+                hw_info.agnus_type == AGNUS_SAGA);
+    MemoryRegion *region;
+    struct Screen *screen;
+    APTR buffer;
+    ULONG i;
+
+    if (index >= memory_regions.count) return;
+    region = &memory_regions.regions[index];
+    if (!(region->mem_type & MEMF_CHIP)) return;
+
+    memset(&dma_contention, 0, sizeof(dma_contention));
+    dma_contention.agnus = hw_info.agnus_type;
+
+    /* Extra line for 16 byte alignment */
+    buffer = alloc_in_region(region, DMA_TEST_SIZE + 16);
+    if (!buffer) return;
+
+    for (i = 0; i < DMA_CONFIGS; i++) {
+        const DmaConfig *config = &dma_configs[i];
+
+        if (config->aga_only && !aga) continue;
+
+        switch (config->setup) {
+            case DMA_CURRENT:
+                measure_dma_row((volatile ULONG *)buffer, i);
+                break;
+
+            case DMA_OFF:
+                Forbid();
+                {
+                    UWORD saved = *dmaconr & display_dma;
+
+                    *dmacon = display_dma;
+                    measure_dma_row((volatile ULONG *)buffer, i);
+                    *dmacon = DMAF_SETCLR | saved;
+                }
+                Permit();
+                break;
+
+            case DMA_SCREEN:
+                screen = open_dma_screen(config);
+                if (!screen) {
+                    debug("  memory: Cannot open DMA test screen '%s'\n",
+                          (LONG)get_string(config->name));
+                    continue;
+                }
+                /* Let the new copper list take over */
+                WaitTOF();
+                WaitTOF();
+                measure_dma_row((volatile ULONG *)buffer, i);
+                CloseScreen(screen);
+                break;
+        }
+    }
+
+    FreeMem(buffer, DMA_TEST_SIZE + 16);
+    dma_contention.measured = TRUE;
+}
+
+/*
+ * Format a measured speed in appropriate units ("---" if not measured)
+ */
+static void format_mem_speed(char *buffer, size_t size, BOOL measured, ULONG speed)
+{
+    if (!measured || speed == 0) {
+        strncpy(buffer, "---", size);
+    } else if (speed >= 1000000) {
+        /* MB/s for fast memory */
+        snprintf(buffer, size, "%lu.%lu MB/s",
+                 (unsigned long)(speed / 1000000),
+                 (unsigned long)((speed % 1000000) / 100000));
+    } else if (speed >= 10000) {
+        /* KB/s */
+        snprintf(buffer, size, "%lu.%lu KB/s",
+                 (unsigned long)(speed / 1000),
+                 (unsigned long)((speed % 1000) / 100));
+    } else {
+        /* Bytes/s for very slow memory */
+        snprintf(buffer, size, "%lu B/s", (unsigned long)speed);
+    }
+}
+
+/*
+ * Draw the cache-size sweep of a region as a bar per working-set size
+ */
+static void draw_memory_sweep(MemoryRegion *region)
 {
     struct RastPort *rp = app->rp;
+    CacheSweep *sweep = &region->cache_sweep;
     char buffer[64];
+    ULONG max_speed = 0;
+    ULONG size;
     WORD y;
-    MemoryRegion *region;
-    Button *btn;
+    int i;
 
-    if (memory_regions.count == 0) {
-        SetAPen(rp, COLOR_TEXT);
-        SetBPen(rp, COLOR_PANEL_BG);
-        Move(rp, 200, 120);
-        Text(rp, (CONST_STRPTR)"No memory regions found", 23);
-        return;
+    for (i = 0; i < CACHE_SWEEP_SIZES; i++) {
+        if (sweep->bytes_sec[i] > max_speed) max_speed = sweep->bytes_sec[i];
     }
 
-    if (full_redraw) {
-        /* Draw memory info panel with 3D border */
-        draw_panel(100, 28, 520, 150, NULL);
+    y = 40;
+    for (i = 0, size = CACHE_SWEEP_MIN_SIZE; i < CACHE_SWEEP_SIZES; i++, size <<= 1) {
+        ULONG speed = sweep->bytes_sec[i];
+        char label[16];
+
+        if (size >= 1024 * 1024) {
+            snprintf(label, sizeof(label), "%luM", (unsigned long)(size / (1024 * 1024)));
+        } else if (size >= 1024) {
+            snprintf(label, sizeof(label), "%luK", (unsigned long)(size / 1024));
+        } else {
+            snprintf(label, sizeof(label), "%luB", (unsigned long)size);
+        }
+
+        format_mem_speed(buffer, sizeof(buffer), sweep->valid, speed);
+        draw_label_value(128, y, label, buffer, 56);
+
+        /* Bar scaled to the fastest step */
+        SetAPen(rp, COLOR_BACKGROUND);
+        RectFill(rp, 288, y - 6, 288 + SWEEP_BAR_WIDTH - 1, y);
+        if (speed > 0 && max_speed > 0) {
+            WORD w = (WORD)(((uint64_t)speed * SWEEP_BAR_WIDTH) / max_speed);
+            if (w > 0) {
+                SetAPen(rp, COLOR_BAR_FILL);
+                RectFill(rp, 288, y - 6, 288 + w - 1, y);
+            }
+        }
+        y += 9;
+    }
+
+    /* Cache state the sweep ran with */
+    y = 166;
+    if (sweep->valid) {
+        snprintf(buffer, sizeof(buffer), "%s %s  %s %s  %s %s  %s %s  %s %s",
+                 get_string(MSG_ICACHE), sweep->icache ? get_string(MSG_ON) : get_string(MSG_OFF),
+                 get_string(MSG_DCACHE), sweep->dcache ? get_string(MSG_ON) : get_string(MSG_OFF),
+                 get_string(MSG_IBURST), sweep->iburst ? get_string(MSG_ON) : get_string(MSG_OFF),
+                 get_string(MSG_DBURST), sweep->dburst ? get_string(MSG_ON) : get_string(MSG_OFF),
+                 get_string(MSG_CBACK), sweep->copyback ? get_string(MSG_ON) : get_string(MSG_OFF));
     } else {
-        /* Clear panel interior only (preserve 3D border) */
-        SetAPen(rp, COLOR_PANEL_BG);
-        RectFill(rp, 101, 29, 618, 176);
+        strncpy(buffer, "---", sizeof(buffer));
     }
+    draw_label_value(128, y, buffer, NULL, 0);
+}
 
-    /* Refresh current region data */
-    refresh_memory_region(app->memory_region_index);
-    region = &memory_regions.regions[app->memory_region_index];
+/*
+ * Draw the DMA contention table, the loss is relative to display DMA off
+ */
+static void draw_memory_dma(void)
+{
+    struct RastPort *rp = app->rp;
+    ULONG base = dma_contention.read_bytes_sec[DMA_CONFIG_OFF];
+    char buffer[64];
+    WORD y;
+    int i;
+
+    snprintf(buffer, sizeof(buffer), "%s: %s", get_string(MSG_DMA_CONTENTION),
+             get_agnus_string(dma_contention.measured ? dma_contention.agnus :
+                                                        hw_info.agnus_type));
+    draw_text(128, 40, buffer, COLOR_HIGHLIGHT);
+
+    /* Column headers */
+    y = 56;
+    draw_text(128, y, get_string(MSG_DMA_DISPLAY), COLOR_TEXT);
+    draw_text_right(288, y, 88, get_string(MSG_MEM_READ), COLOR_TEXT);
+    draw_text_right(384, y, 88, get_string(MSG_MEM_WRITE), COLOR_TEXT);
+    draw_text_right(480, y, 64, get_string(MSG_DMA_LOSS), COLOR_TEXT);
+
+    SetAPen(rp, COLOR_BUTTON_DARK);
+    Move(rp, 104, y + 4);
+    Draw(rp, 614, y + 4);
+
+    y = 68;
+    for (i = 0; i < DMA_CONFIGS; i++) {
+        ULONG read = dma_contention.read_bytes_sec[i];
+        ULONG write = dma_contention.write_bytes_sec[i];
+
+        draw_text(128, y, get_string(dma_configs[i].name), COLOR_TEXT);
+
+        format_mem_speed(buffer, sizeof(buffer), dma_contention.measured, read);
+        draw_text_right(288, y, 88, buffer, COLOR_HIGHLIGHT);
+
+        format_mem_speed(buffer, sizeof(buffer), dma_contention.measured, write);
+        draw_text_right(384, y, 88, buffer, COLOR_HIGHLIGHT);
+
+        if (read > 0 && base > 0 && read < base) {
+            snprintf(buffer, sizeof(buffer), "%lu%%",
+                     (unsigned long)(100 - (ULONG)(((uint64_t)read * 100) / base)));
+        } else if (read > 0 && base > 0) {
+            strncpy(buffer, "0%", sizeof(buffer));
+        } else {
+            strncpy(buffer, "---", sizeof(buffer));
+        }
+        draw_text_right(480, y, 64, buffer, COLOR_HIGHLIGHT);
+
+        y += 10;
+    }
+}
+
+/*
+ * Label of a fragmentation size class ("8B", "64B" .. "512K+")
+ */
+static void format_frag_bucket(char *buffer, size_t size, ULONG bucket)
+{
+    ULONG bytes = mem_frag_bucket_size(bucket);
+
+    if (bytes >= 1024) {
+        snprintf(buffer, size, "%luK%s", (unsigned long)(bytes / 1024),
+                 bucket == MEM_FRAG_BUCKETS - 1 ? "+" : "");
+    } else {
+        snprintf(buffer, size, "%luB", (unsigned long)bytes);
+    }
+}
+
+/*
+ * Draw the free-list size-class histogram and chunk map of a region
+ */
+static void draw_memory_frag(MemoryRegion *region)
+{
+    struct RastPort *rp = app->rp;
+    MemFragmentation *frag = &region->fragmentation;
+    char buffer[32];
+    ULONG max_bytes = 0;
+    WORD y;
+    int i;
+
+    for (i = 0; i < MEM_FRAG_BUCKETS; i++) {
+        if (frag->bytes[i] > max_bytes) max_bytes = frag->bytes[i];
+    }
+
+    /* Column headers */
+    y = 40;
+    draw_text(128, y, get_string(MSG_FRAG_SIZE), COLOR_TEXT);
+    draw_text_right(168, y, 64, get_string(MSG_FRAG_CHUNKS), COLOR_TEXT);
+    draw_text_right(240, y, 80, get_string(MSG_FRAG_FREE), COLOR_TEXT);
+    draw_text_right(500, y, 112, get_string(MSG_FRAG_FITS), COLOR_TEXT);
+
+    SetAPen(rp, COLOR_BUTTON_DARK);
+    Move(rp, 104, y + 4);
+    Draw(rp, 614, y + 4);
+
+    y = 52;
+    for (i = 0; i < MEM_FRAG_BUCKETS; i++) {
+        format_frag_bucket(buffer, sizeof(buffer), i);
+        draw_text(128, y, buffer, COLOR_TEXT);
+
+        snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)frag->chunks[i]);
+        draw_text_right(168, y, 64, buffer, COLOR_HIGHLIGHT);
+
+        format_size(frag->bytes[i], buffer, sizeof(buffer));
+        draw_text_right(240, y, 80, buffer, COLOR_HIGHLIGHT);
+
+        /* Free bytes in this class, scaled to the biggest class */
+        SetAPen(rp, COLOR_BACKGROUND);
+        RectFill(rp, 328, y - 6, 328 + FRAG_BAR_WIDTH - 1, y);
+        if (frag->bytes[i] > 0 && max_bytes > 0) {
+            WORD w = (WORD)(((uint64_t)frag->bytes[i] * FRAG_BAR_WIDTH) / max_bytes);
+            if (w > 0) {
+                SetAPen(rp, COLOR_BAR_FILL);
+                RectFill(rp, 328, y - 6, 328 + w - 1, y);
+            }
+        }
+
+        snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)frag->fits[i]);
+        draw_text_right(500, y, 112, buffer, COLOR_HIGHLIGHT);
+        y += 8;
+    }
+
+    /* Fragmentation index and chunk address map (dark = allocated) */
+    y = 174;
+    snprintf(buffer, sizeof(buffer), "%lu%%", (unsigned long)frag->index);
+    draw_label_value(128, y, get_string(MSG_FRAGMENTATION), buffer, 120);
+
+    for (i = 0; i < MEM_FRAG_MAP_CELLS; i++) {
+        WORD x = FRAG_MAP_X + i * FRAG_MAP_CELL_WIDTH;
+
+        if (frag->map[i] == 0) {
+            SetAPen(rp, COLOR_BUTTON_DARK);
+        } else if (frag->map[i] >= 100) {
+            SetAPen(rp, COLOR_BAR_FILL);
+        } else {
+            SetAPen(rp, COLOR_BAR_YOU);
+        }
+        RectFill(rp, x, y - 6, x + FRAG_MAP_CELL_WIDTH - 1, y);
+    }
+}
+
+/*
+ * Draw the info rows of a region
+ */
+static void draw_memory_info(MemoryRegion *region)
+{
+    char buffer[64];
+    WORD y;
+    int i;
 
     /* Draw memory info */
     y = 44;
@@ -372,28 +927,88 @@ static void draw_memory_data(BOOL full_redraw)
     y += 10;
 
     /* Memory speed - display in appropriate units */
-    if (region->speed_measured) {
-        ULONG speed = region->speed_bytes_sec;
-        if (speed >= 1000000) {
-            /* MB/s for fast memory */
-            snprintf(buffer, sizeof(buffer), "%lu.%lu MB/s",
-                     (unsigned long)(speed / 1000000),
-                     (unsigned long)((speed % 1000000) / 100000));
-        } else if (speed >= 10000) {
-            /* KB/s */
-            snprintf(buffer, sizeof(buffer), "%lu.%lu KB/s",
-                     (unsigned long)(speed / 1000),
-                     (unsigned long)((speed % 1000) / 100));
-        } else if (speed > 0) {
-            /* Bytes/s for very slow memory */
-            snprintf(buffer, sizeof(buffer), "%lu B/s", (unsigned long)speed);
-        } else {
+    format_mem_speed(buffer, sizeof(buffer), region->speed_measured, region->speed_bytes_sec);
+    draw_label_value(128, y, get_string(MSG_MEMORY_SPEED), buffer, 168);
+
+    /* Fragmentation index, the rest is on the FRAG page */
+    snprintf(buffer, sizeof(buffer), "%lu%%", (unsigned long)region->fragmentation.index);
+    draw_label_value(432, 84, get_string(MSG_FRAGMENTATION), buffer, 104);
+
+    /* Write/copy speeds and latency in the right column */
+    y = 94;
+    format_mem_speed(buffer, sizeof(buffer), region->speed_measured, region->write_bytes_sec);
+    draw_label_value(432, y, get_string(MSG_WRITE_SPEED), buffer, 104);
+    y += 10;
+
+    format_mem_speed(buffer, sizeof(buffer), region->speed_measured, region->copy_bytes_sec);
+    draw_label_value(432, y, get_string(MSG_COPY_SPEED), buffer, 104);
+    y += 10;
+
+    format_mem_speed(buffer, sizeof(buffer), region->speed_measured, region->byte_copy_bytes_sec);
+    draw_label_value(432, y, get_string(MSG_BYTE_COPY_SPEED), buffer, 104);
+    y += 10;
+
+    /* Pointer-chase latency curve, one row per working-set size */
+    for (i = 0; i < MEM_LATENCY_SIZES; i++) {
+        char label[24];
+        ULONG lat = region->latency_ns_x100[i];
+
+        snprintf(label, sizeof(label), "%s %luK", get_string(MSG_LATENCY),
+                 (unsigned long)(latency_sizes[i] / 1024));
+        if (!region->latency_measured || lat == 0) {
             strncpy(buffer, "---", sizeof(buffer));
+        } else {
+            char scaled[16];
+            format_scaled(scaled, sizeof(scaled), lat, TRUE);
+            snprintf(buffer, sizeof(buffer), "%s ns", scaled);
         }
+        draw_label_value(432, y, label, buffer, 104);
+        y += 10;
+    }
+}
+
+/*
+ * Draw memory view
+ */
+/*
+ * Draw memory data area (info panel and navigation buttons - no title)
+ */
+static void draw_memory_data(BOOL full_redraw)
+{
+    struct RastPort *rp = app->rp;
+    MemoryRegion *region;
+    Button *btn;
+
+    if (memory_regions.count == 0) {
+        SetAPen(rp, COLOR_TEXT);
+        SetBPen(rp, COLOR_PANEL_BG);
+        Move(rp, 200, 120);
+        Text(rp, (CONST_STRPTR)"No memory regions found", 23);
+        return;
+    }
+
+    if (full_redraw) {
+        /* Draw memory info panel with 3D border */
+        draw_panel(100, 28, 520, 150, NULL);
     } else {
-        strncpy(buffer, "---", sizeof(buffer));
+        /* Clear panel interior only (preserve 3D border) */
+        SetAPen(rp, COLOR_PANEL_BG);
+        RectFill(rp, 101, 29, 618, 176);
+    }
+
+    /* Refresh current region data */
+    refresh_memory_region(app->memory_region_index);
+    region = &memory_regions.regions[app->memory_region_index];
+
+    if (app->memory_show_sweep) {
+        draw_memory_sweep(region);
+    } else if (app->memory_show_dma) {
+        draw_memory_dma();
+    } else if (app->memory_show_frag) {
+        draw_memory_frag(region);
+    } else {
+        draw_memory_info(region);
     }
-    draw_label_value(128, y, get_string(MSG_MEMORY_SPEED), buffer, 168);
 
     /* Draw navigation buttons */
     btn = find_button(BTN_MEM_PREV);
@@ -404,6 +1019,12 @@ static void draw_memory_data(BOOL full_redraw)
     if (btn) draw_button(btn);
     btn = find_button(BTN_MEM_SPEED);
     if (btn) draw_button(btn);
+    btn = find_button(BTN_MEM_SWEEP);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_MEM_FRAG);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_MEM_DMA);
+    if (btn) draw_button(btn);
     btn = find_button(BTN_MEM_EXIT);
     if (btn) draw_button(btn);
 }
@@ -439,6 +1060,17 @@ void memory_view_update_buttons(void)
                get_string(MSG_BTN_SPEED), BTN_MEM_SPEED, TRUE);
     add_button(340, 188, 52, 12,
                get_string(MSG_BTN_EXIT), BTN_MEM_EXIT, TRUE);
+    add_button(400, 188, 52, 12,
+               app->memory_show_sweep ? get_string(MSG_BTN_INFO) : get_string(MSG_BTN_SWEEP),
+               BTN_MEM_SWEEP, TRUE);
+    add_button(460, 188, 52, 12,
+               app->memory_show_frag ? get_string(MSG_BTN_INFO) : get_string(MSG_BTN_FRAG),
+               BTN_MEM_FRAG, TRUE);
+    add_button(520, 188, 52, 12,
+               app->memory_show_dma ? get_string(MSG_BTN_INFO) : get_string(MSG_BTN_DMA),
+               BTN_MEM_DMA, app->memory_show_dma ||
+               (app->memory_region_index < (LONG)memory_regions.count &&
+                (memory_regions.regions[app->memory_region_index].mem_type & MEMF_CHIP)));
 }
 
 /*
@@ -466,10 +1098,57 @@ void memory_view_handle_button(ButtonID id)
             break;
 
         case BTN_MEM_SPEED:
+            /* The background suite would skew these results and its own */
+            if (benchmark_task_running()) break;
             if (app->memory_region_index >= 0 &&
                 app->memory_region_index < (LONG)memory_regions.count) {
                 show_status_overlay(get_string(MSG_MEASURING_SPEED));
                 measure_memory_speed(app->memory_region_index);
+                measure_memory_latency(app->memory_region_index);
+                hide_status_overlay();
+            }
+            break;
+
+        case BTN_MEM_SWEEP:
+            if (benchmark_task_running()) break;
+            if (app->memory_show_sweep) {
+                app->memory_show_sweep = FALSE;
+                redraw_current_view();
+            } else if (app->memory_region_index >= 0 &&
+                       app->memory_region_index < (LONG)memory_regions.count) {
+                app->memory_show_sweep = TRUE;
+                app->memory_show_frag = FALSE;
+                app->memory_show_dma = FALSE;
+                show_status_overlay(get_string(MSG_MEASURING_SPEED));
+                measure_memory_sweep(app->memory_region_index);
+                hide_status_overlay();
+            }
+            break;
+
+        case BTN_MEM_FRAG:
+            /* The free list is re-read on every redraw */
+            app->memory_show_frag = !app->memory_show_frag;
+            app->memory_show_sweep = FALSE;
+            app->memory_show_dma = FALSE;
+            redraw_current_view();
+            break;
+
+        case BTN_MEM_DMA:
+            if (benchmark_task_running()) break;
+            if (app->memory_show_dma) {
+                app->memory_show_dma = FALSE;
+                redraw_current_view();
+            } else if (app->memory_region_index >= 0 &&
+                       app->memory_region_index < (LONG)memory_regions.count) {
+                app->memory_show_dma = TRUE;
+                app->memory_show_sweep = FALSE;
+                app->memory_show_frag = FALSE;
+                show_status_overlay(get_string(MSG_MEASURING_SPEED));
+                /* Opening the test screens needs other tasks running, the
+                 * kernels take Forbid() themselves */
+                Permit();
+                measure_dma_contention(app->memory_region_index);
+                Forbid();
                 hide_status_overlay();
             }
             break;
@@ -9,9 +9,29 @@
 #define MEMORY_H
 
 #include "xsysinfo.h"
+#include "benchmark.h"
 
-/* Maximum memory regions we'll track */
-#define MAX_MEMORY_REGIONS  32
+/* Pointer-chase latency working-set sizes (1K .. 256K) */
+#define MEM_LATENCY_SIZES       5
+#define MEM_LATENCY_ACCESSES    65536
+
+/* Display configurations of the CHIP DMA contention test */
+#define DMA_CONFIGS         8
+#define DMA_TEST_SIZE       65536
+#define DMA_TEST_ITERATIONS 16
+
+/* Free-chunk size classes: 8B, 64B, 128B .. 256K, 512K+ */
+#define MEM_FRAG_BUCKETS    15
+#define MEM_FRAG_MAP_CELLS  80      /* Address slices in the chunk map */
+
+/* Free-list fragmentation of a region */
+typedef struct {
+    ULONG chunks[MEM_FRAG_BUCKETS]; /* Free chunks per size class */
+    ULONG bytes[MEM_FRAG_BUCKETS];  /* Free bytes per size class */
+    ULONG fits[MEM_FRAG_BUCKETS];   /* Allocations of the class size that would succeed */
+    UBYTE map[MEM_FRAG_MAP_CELLS];  /* Percent free per address slice */
+    ULONG index;                    /* 0 = one block, 100 = fully fragmented */
+} MemFragmentation;
 
 /* Memory region information */
 typedef struct {
@@ -26,35 +46,70 @@ typedef struct {
     ULONG amount_free;
     ULONG largest_block;
     ULONG num_chunks;
-    char node_name[64];
-    char type_string[64];   /* Human-readable type */
+    const char *node_name;  /* Pooled strings */
+    const char *type_string; /* Human-readable type */
     ULONG speed_bytes_sec;  /* Read speed in bytes/second */
+    ULONG write_bytes_sec;  /* Write speed in bytes/second */
+    ULONG copy_bytes_sec;   /* Copy speed (best kernel for CPU) in bytes/second */
+    ULONG byte_copy_bytes_sec; /* Byte-wise copy speed in bytes/second */
     BOOL speed_measured;    /* TRUE if speed test has been run */
+    ULONG latency_ns_x100[MEM_LATENCY_SIZES]; /* ns per access * 100 (0 = not run) */
+    BOOL latency_measured;  /* TRUE if latency test has been run */
+    CacheSweep cache_sweep; /* Read speed vs. working-set size */
+    MemFragmentation fragmentation; /* Free-list size classes and map */
     struct MemHeader *memListNode;
 } MemoryRegion;
 
-/* Memory region list */
+/* Memory region list, regions allocated from the pool */
 typedef struct {
-    MemoryRegion regions[MAX_MEMORY_REGIONS];
+    MemoryRegion *regions;
     ULONG count;
+    ULONG capacity;
 } MemoryRegionList;
 
+/* CHIP RAM bandwidth under display DMA, per test configuration */
+typedef struct {
+    ULONG read_bytes_sec[DMA_CONFIGS];  /* 0 = not run on this chipset */
+    ULONG write_bytes_sec[DMA_CONFIGS];
+    AgnusType agnus;                    /* Chipset the table was measured on */
+    BOOL measured;
+} DmaContention;
+
 /* Global memory region list */
 extern MemoryRegionList memory_regions;
 
+/* Last DMA contention run */
+extern DmaContention dma_contention;
+
+/* Working-set size in bytes for each latency_ns_x100 entry */
+extern const ULONG latency_sizes[MEM_LATENCY_SIZES];
+
 /* Function prototypes */
 void enumerate_memory_regions(void);
 void refresh_memory_region(ULONG index);
 
+/* Measure CHIP RAM of a region under each display configuration */
+void measure_dma_contention(ULONG index);
+const char *get_dma_config_name(ULONG config);
+
 /* Get memory type as string */
 const char *get_memory_type_string(UWORD attrs, APTR addr);
 
-/* Count free chunks and find largest block in a memory region */
-void analyze_memory_region(struct MemHeader *mh, ULONG *chunks, ULONG *largest);
+/* Walk the free list of a region: chunks, largest block and fragmentation */
+void analyze_memory_region(struct MemHeader *mh, MemoryRegion *region);
 
-/* Measure memory read speed for a region (returns bytes/second) */
+/* Smallest chunk size counted in a fragmentation size class */
+ULONG mem_frag_bucket_size(ULONG bucket);
+
+/* Measure memory read/write/copy speed for a region (returns read bytes/second) */
 ULONG measure_memory_speed(ULONG index);
 
+/* Measure pointer-chase latency for a region at all working-set sizes */
+void measure_memory_latency(ULONG index);
+
+/* Run the cache-size sweep inside a region */
+void measure_memory_sweep(ULONG index);
+
 /* Draw memory view */
 void draw_memory_view(void);
 
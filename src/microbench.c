@@ -0,0 +1,478 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Instruction-level CPU microbenchmarks
+ *
+ * Times single instruction classes in the unrolled loops of microbench.S
+ * and converts them to cycles per instruction with the measured CPU clock.
+ * This shows what Dhrystone hides: 64-bit MULS.L/DIVS.L trapped to the
+ * 68060.library, slow bitfield/CAS implementations on accelerators and
+ * emulators, and the cost of misaligned accesses.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <exec/execbase.h>
+#include <exec/memory.h>
+
+#include <proto/exec.h>
+#include <proto/graphics.h>
+
+#include "xsysinfo.h"
+#include "microbench.h"
+#include "blitbench.h"
+#include "latency.h"
+#include "benchmark.h"
+#include "harness.h"
+#include "hardware.h"
+#include "gui.h"
+#include "locale_str.h"
+#include "debug.h"
+
+extern struct ExecBase *SysBase;
+extern HardwareInfo hw_info;
+
+/* Kernel requirements */
+#define MB_NEEDS_020        0x01    /* 68020+ instruction or addressing */
+#define MB_NEEDS_MOVE16     0x02    /* 68040/68060/68080 */
+#define MB_TRAPS_060        0x04    /* Emulated by the 68060.library */
+
+/* Cache matrix rows that fit the panel */
+#define CACHE_MATRIX_ROWS   16
+
+/* Global results */
+MicroBenchResults micro_results;
+
+static const struct {
+    const char *name;
+    ULONG flags;
+} micro_kernels[MICRO_KERNELS] = {
+    { "MOVEQ #n,Dn",         0 },
+    { "ADD.L Dn,Dn",         0 },
+    { "MULS.W Dn,Dn",        0 },
+    { "MULS.L Dn,Dn",        MB_NEEDS_020 },
+    { "MULS.L Dn,Dh:Dl",     MB_NEEDS_020 | MB_TRAPS_060 },
+    { "DIVS.W Dn,Dn",        0 },
+    { "DIVS.L Dn,Dn",        MB_NEEDS_020 },
+    { "DIVS.L Dn,Dr:Dq",     MB_NEEDS_020 | MB_TRAPS_060 },
+    { "BFEXTU Dn{o:w},Dn",   MB_NEEDS_020 },
+    { "BFINS Dn,(An){o:w}",  MB_NEEDS_020 },
+    { "CAS.L Dc,Du,(An)",    MB_NEEDS_020 },
+    { "MOVE.L (An),Dn",      0 },
+    { "MOVE.L 1(An),Dn",     MB_NEEDS_020 },
+    { "MOVE16 (An)+,(An)+",  MB_NEEDS_MOVE16 },
+};
+
+/* What the harness passes to micro_run() */
+typedef struct {
+    ULONG kernel;
+    UBYTE *buffer;
+} MicroKernelData;
+
+static BenchKernel micro_bench_kernels[MICRO_KERNELS];
+static MicroKernelData micro_kernel_data[MICRO_KERNELS];
+
+/*
+ * Name of a kernel
+ */
+const char *get_micro_kernel_name(ULONG kernel)
+{
+    return kernel < MICRO_KERNELS ? micro_kernels[kernel].name : "";
+}
+
+/*
+ * TRUE if the CPU is a 68060 of any kind
+ */
+static BOOL is_68060(void)
+{
+    return hw_info.cpu_type == CPU_68060 || hw_info.cpu_type == CPU_68EC060 ||
+           hw_info.cpu_type == CPU_68LC060;
+}
+
+/*
+ * Timed part of a kernel, work is the instructions executed
+ */
+static void micro_run(APTR data, ULONG iterations, BenchWork *work)
+{
+    MicroKernelData *d = (MicroKernelData *)data;
+
+    DoMicroBench(iterations, d->kernel, d->buffer);
+
+    work->work = (uint64_t)iterations * MICRO_INSNS_PER_LOOP;
+    work->counter_loops = iterations;
+}
+
+/*
+ * Time of the two suba.w that rewind the MOVE16 pointers, for the
+ * count MOVE16 was calibrated to
+ */
+static uint64_t time_move16_reset(ULONG iterations, UBYTE *buffer)
+{
+    BenchKernel kernel;
+    MicroKernelData data;
+    BenchWork work;
+    uint64_t elapsed_ns;
+
+    data.kernel = ASM_MB_MOVE16_RESET;
+    data.buffer = buffer;
+
+    memset(&kernel, 0, sizeof(BenchKernel));
+    kernel.name = "MOVE16 reset";
+    kernel.run = micro_run;
+    kernel.data = &data;
+    kernel.scale = 1;
+    kernel.flags = BENCH_KERNEL_FORBID;
+
+    if (!harness_time(&kernel, iterations, &work, &elapsed_ns)) return 0;
+    return elapsed_ns;
+}
+
+/*
+ * Time all kernels this CPU can run
+ */
+void run_micro_benchmarks(void)
+{
+    UWORD attn = SysBase->AttnFlags;
+    BOOL cpu020 = (attn & AFF_68020) != 0;
+    BOOL move16 = (attn & AFF_68040) != 0 || hw_info.cpu_type == CPU_68080;
+    BOOL lib060;
+    APTR raw;
+    UBYTE *buffer;
+    ULONG k;
+
+    memset(&micro_results, 0, sizeof(micro_results));
+
+    if (!benchmark_timer_available()) return;
+
+    Forbid();
+    lib060 = FindName(&SysBase->LibList, (CONST_STRPTR)"68060.library") != NULL;
+    Permit();
+
+    if (hw_info.cpu_mhz == 0) {
+        hw_info.cpu_mhz = get_mhz_cpu();
+    }
+    micro_results.cpu_mhz = hw_info.cpu_mhz;
+
+    raw = AllocMem(MICRO_BUFFER_SIZE + 16, MEMF_ANY | MEMF_CLEAR);
+    if (!raw) return;
+    buffer = (UBYTE *)(((ULONG)raw + 15) & ~15);
+
+    for (k = 0; k < MICRO_KERNELS; k++) {
+        BenchKernel *kernel = &micro_bench_kernels[k];
+        ULONG flags = micro_kernels[k].flags;
+        BenchWork work;
+        uint64_t elapsed_ns;
+
+        if ((flags & MB_NEEDS_020) && !cpu020) continue;
+        if ((flags & MB_NEEDS_MOVE16) && !move16) continue;
+        if ((flags & MB_TRAPS_060) && is_68060()) {
+            /* Without the library the instruction ends in a guru */
+            if (!lib060) continue;
+            micro_results.emulated[k] = TRUE;
+        }
+
+        micro_kernel_data[k].kernel = k;
+        micro_kernel_data[k].buffer = buffer;
+
+        memset(kernel, 0, sizeof(BenchKernel));
+        kernel->name = micro_kernels[k].name;
+        kernel->run = micro_run;
+        kernel->data = &micro_kernel_data[k];
+        kernel->scale = 1;
+        kernel->start_iterations = MICRO_MIN_LOOPS;
+        kernel->max_iterations = MICRO_MAX_LOOPS;
+        kernel->min_runtime_us = MICRO_MIN_US;
+        kernel->flags = BENCH_KERNEL_FORBID;
+
+        if (!harness_calibrate(kernel, &work, &elapsed_ns)) break;
+        if (work.work == 0) continue;
+
+        if (k == ASM_MB_MOVE16) {
+            uint64_t reset_ns = time_move16_reset(kernel->iterations, buffer);
+            elapsed_ns = elapsed_ns > reset_ns ? elapsed_ns - reset_ns : 0;
+        }
+
+        micro_results.supported[k] = TRUE;
+        micro_results.ns_x100[k] = (ULONG)((elapsed_ns * 100ULL) / work.work);
+        micro_results.cycles_x100[k] = (ULONG)((elapsed_ns * (uint64_t)micro_results.cpu_mhz) /
+                                               (work.work * 1000ULL));
+    }
+
+    FreeMem(raw, MICRO_BUFFER_SIZE + 16);
+    micro_results.valid = TRUE;
+}
+
+/*
+ * Draw instruction timing table
+ */
+static void draw_cpu_timing(void)
+{
+    char buffer[64];
+    WORD y;
+    ULONG k;
+
+    /* Column headers */
+    y = 40;
+    draw_text(28, y, get_string(MSG_INSTRUCTION), COLOR_TEXT);
+    draw_text_right(220, y, 80, get_string(MSG_CYCLES), COLOR_TEXT);
+    draw_text_right(320, y, 80, get_string(MSG_NS), COLOR_TEXT);
+
+    SetAPen(app->rp, COLOR_BUTTON_DARK);
+    Move(app->rp, 24, y + 4);
+    Draw(app->rp, 614, y + 4);
+
+    y = 56;
+    for (k = 0; k < MICRO_KERNELS; k++) {
+        draw_text(28, y, micro_kernels[k].name, COLOR_TEXT);
+
+        if (micro_results.valid && micro_results.supported[k]) {
+            if (micro_results.cpu_mhz > 0) {
+                format_scaled(buffer, sizeof(buffer), micro_results.cycles_x100[k], FALSE);
+            } else {
+                snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_NA));
+            }
+            draw_text_right(220, y, 80, buffer, COLOR_HIGHLIGHT);
+
+            format_scaled(buffer, sizeof(buffer), micro_results.ns_x100[k], FALSE);
+            draw_text_right(320, y, 80, buffer, COLOR_HIGHLIGHT);
+
+            if (micro_results.emulated[k]) {
+                draw_text(420, y, get_string(MSG_EMULATED), COLOR_TEXT);
+            }
+        } else {
+            draw_text_right(220, y, 80, get_string(MSG_NA), COLOR_HIGHLIGHT);
+            draw_text_right(320, y, 80, get_string(MSG_NA), COLOR_HIGHLIGHT);
+        }
+        y += 9;
+    }
+
+    /* Clock the cycles are based on */
+    if (micro_results.valid && micro_results.cpu_mhz > 0) {
+        char mhz_str[16];
+        format_scaled(mhz_str, sizeof(mhz_str), micro_results.cpu_mhz, FALSE);
+        snprintf(buffer, sizeof(buffer), "%s %s %s", get_string(MSG_CPU_MHZ),
+                 hw_info.cpu_string, mhz_str);
+        draw_text(420, 56, buffer, COLOR_TEXT);
+    }
+
+}
+
+/*
+ * Format one cache matrix column as ON/OFF
+ */
+static const char *on_off(BOOL value)
+{
+    return value ? get_string(MSG_ON) : get_string(MSG_OFF);
+}
+
+/*
+ * Draw cache configuration matrix
+ */
+static void draw_cache_matrix(void)
+{
+    static const WORD columns[] = { 28, 84, 140, 196, 252, 300 };
+    char buffer[32];
+    WORD y;
+    ULONG i;
+
+    /* Column headers */
+    y = 40;
+    draw_text(columns[0], y, get_string(MSG_ICACHE), COLOR_TEXT);
+    draw_text(columns[1], y, get_string(MSG_DCACHE), COLOR_TEXT);
+    draw_text(columns[2], y, get_string(MSG_IBURST), COLOR_TEXT);
+    draw_text(columns[3], y, get_string(MSG_DBURST), COLOR_TEXT);
+    draw_text(columns[4], y, get_string(MSG_CBACK), COLOR_TEXT);
+    draw_text(columns[5], y, get_string(MSG_SUPERS), COLOR_TEXT);
+    draw_text_right(356, y, 96, get_string(MSG_DHRYSTONES), COLOR_TEXT);
+    draw_text_right(460, y, 80, get_string(MSG_MEM_READ), COLOR_TEXT);
+    draw_text_right(548, y, 64, "%", COLOR_TEXT);
+
+    SetAPen(app->rp, COLOR_BUTTON_DARK);
+    Move(app->rp, 24, y + 4);
+    Draw(app->rp, 614, y + 4);
+
+    if (!cache_matrix.valid) {
+        draw_text(columns[0], 56, get_string(MSG_NA), COLOR_HIGHLIGHT);
+        return;
+    }
+
+    y = 54;
+    for (i = 0; i < cache_matrix.count && i < CACHE_MATRIX_ROWS; i++) {
+        CacheMatrixEntry *entry = &cache_matrix.entries[i];
+        ULONG best = cache_matrix.entries[cache_matrix.best_dhrystones].dhrystones;
+        UBYTE color = (i == cache_matrix.best_dhrystones) ? COLOR_HIGHLIGHT : COLOR_TEXT;
+
+        draw_text(columns[0], y, on_off(entry->config.icache), color);
+        draw_text(columns[1], y, on_off(entry->config.dcache), color);
+        draw_text(columns[2], y, on_off(entry->config.iburst), color);
+        draw_text(columns[3], y, on_off(entry->config.dburst), color);
+        draw_text(columns[4], y, on_off(entry->config.copyback), color);
+        draw_text(columns[5], y, on_off(entry->config.super_scalar), color);
+
+        snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)entry->dhrystones);
+        draw_text_right(356, y, 96, buffer, color);
+
+        format_scaled(buffer, sizeof(buffer), entry->read_speed / 10000, FALSE);
+        draw_text_right(460, y, 80, buffer,
+                        i == cache_matrix.best_read ? COLOR_HIGHLIGHT : COLOR_TEXT);
+
+        snprintf(buffer, sizeof(buffer), "%lu",
+                 best > 0 ? (unsigned long)(((uint64_t)entry->dhrystones * 100) / best) : 0UL);
+        draw_text_right(548, y, 64, buffer, color);
+        y += 8;
+    }
+}
+
+/*
+ * Draw CPU instruction timing view
+ */
+void draw_cpu_view(void)
+{
+    Button *btn;
+
+    /* Title panel */
+    draw_panel(20, 0, 600, 24, NULL);
+    draw_text_centered(20, 14, 600,
+                       app->cpu_show_latency ? get_string(MSG_EXEC_LATENCY) :
+                       app->cpu_show_blitter ? get_string(MSG_BLITTER_BENCH) :
+                       app->cpu_show_cache_matrix ? get_string(MSG_CACHE_MATRIX)
+                                                  : get_string(MSG_CPU_TIMING),
+                       COLOR_TEXT);
+
+    draw_panel(20, 28, 600, 156, NULL);
+
+    if (app->cpu_show_latency) {
+        draw_latency_bench();
+    } else if (app->cpu_show_blitter) {
+        draw_blitter_bench();
+    } else if (app->cpu_show_cache_matrix) {
+        draw_cache_matrix();
+    } else {
+        draw_cpu_timing();
+    }
+
+    /* Buttons */
+    btn = find_button(BTN_CPU_EXIT);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_CPU_RUN);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_CPU_CACHES);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_CPU_BLITTER);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_CPU_LATENCY);
+    if (btn) draw_button(btn);
+}
+
+/*
+ * Update buttons for CPU view
+ */
+void cpu_view_update_buttons(void)
+{
+    add_button(20, 188, 60, 12,
+               get_string(MSG_BTN_EXIT), BTN_CPU_EXIT, TRUE);
+    add_button(84, 188, 60, 12,
+               get_string(MSG_BTN_RUN), BTN_CPU_RUN, TRUE);
+    add_button(148, 188, 60, 12,
+               app->cpu_show_cache_matrix ? get_string(MSG_BTN_TIMING) : get_string(MSG_BTN_CACHES),
+               BTN_CPU_CACHES, TRUE);
+    add_button(212, 188, 60, 12,
+               app->cpu_show_blitter ? get_string(MSG_BTN_TIMING) : get_string(MSG_BTN_BLITTER),
+               BTN_CPU_BLITTER, TRUE);
+    add_button(276, 188, 60, 12,
+               app->cpu_show_latency ? get_string(MSG_BTN_TIMING) : get_string(MSG_LATENCY),
+               BTN_CPU_LATENCY, TRUE);
+}
+
+/*
+ * The status overlay holds Forbid(). The latency tests time
+ * Forbid()/Permit() and task switches, so they run with multitasking
+ * back on and the overlay's Forbid() is restored afterwards
+ */
+static void run_latency_permitted(void)
+{
+    Permit();
+    run_latency_benchmarks();
+    Forbid();
+}
+
+/*
+ * Handle button press for CPU view
+ */
+void cpu_view_handle_button(ButtonID id)
+{
+    switch (id) {
+        case BTN_CPU_EXIT:
+            switch_to_view(VIEW_MAIN);
+            break;
+
+        case BTN_CPU_RUN:
+            /* The background suite shares the Dhrystone globals and the CACR */
+            if (benchmark_task_running()) break;
+            show_status_overlay(get_string(MSG_MEASURING_SPEED));
+            if (app->cpu_show_latency) {
+                run_latency_permitted();
+            } else if (app->cpu_show_blitter) {
+                run_blitter_benchmarks();
+            } else if (app->cpu_show_cache_matrix) {
+                run_cache_matrix(&cache_matrix);
+            } else {
+                run_micro_benchmarks();
+            }
+            hide_status_overlay();
+            break;
+
+        case BTN_CPU_CACHES:
+            if (app->cpu_show_cache_matrix) {
+                app->cpu_show_cache_matrix = FALSE;
+                redraw_current_view();
+            } else {
+                app->cpu_show_cache_matrix = TRUE;
+                app->cpu_show_blitter = FALSE;
+                app->cpu_show_latency = FALSE;
+                if (!benchmark_task_running()) {
+                    show_status_overlay(get_string(MSG_MEASURING_SPEED));
+                    run_cache_matrix(&cache_matrix);
+                    hide_status_overlay();
+                }
+            }
+            break;
+
+        case BTN_CPU_BLITTER:
+            if (app->cpu_show_blitter) {
+                app->cpu_show_blitter = FALSE;
+                redraw_current_view();
+            } else {
+                app->cpu_show_blitter = TRUE;
+                app->cpu_show_cache_matrix = FALSE;
+                app->cpu_show_latency = FALSE;
+                if (!benchmark_task_running()) {
+                    show_status_overlay(get_string(MSG_MEASURING_SPEED));
+                    run_blitter_benchmarks();
+                    hide_status_overlay();
+                }
+            }
+            break;
+
+        case BTN_CPU_LATENCY:
+            if (app->cpu_show_latency) {
+                app->cpu_show_latency = FALSE;
+                redraw_current_view();
+            } else {
+                app->cpu_show_latency = TRUE;
+                app->cpu_show_cache_matrix = FALSE;
+                app->cpu_show_blitter = FALSE;
+                if (!benchmark_task_running()) {
+                    show_status_overlay(get_string(MSG_MEASURING_SPEED));
+                    run_latency_permitted();
+                    hide_status_overlay();
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+}
@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Instruction-level CPU microbenchmark header
+ */
+
+#ifndef MICROBENCH_H
+#define MICROBENCH_H
+
+#include "xsysinfo.h"
+
+/* Kernels in microbench.S (same order as ASM_MB_* there) */
+#define ASM_MB_MOVEQ        0
+#define ASM_MB_ADD_L        1
+#define ASM_MB_MULS_W       2
+#define ASM_MB_MULS_L       3
+#define ASM_MB_MULS_L64     4
+#define ASM_MB_DIVS_W       5
+#define ASM_MB_DIVS_L       6
+#define ASM_MB_DIVS_L64     7
+#define ASM_MB_BFEXTU       8
+#define ASM_MB_BFINS        9
+#define ASM_MB_CAS          10
+#define ASM_MB_MOVE_L       11
+#define ASM_MB_MOVE_L_ODD   12
+#define ASM_MB_MOVE16       13
+#define MICRO_KERNELS       14
+#define ASM_MB_MOVE16_RESET 14      /* Not listed, taken off MOVE16 */
+
+#define MICRO_INSNS_PER_LOOP    8
+#define MICRO_MIN_LOOPS         64
+#define MICRO_MAX_LOOPS         (1UL << 22)
+#define MICRO_MIN_US            20000   /* Minimum runtime per kernel */
+#define MICRO_BUFFER_SIZE       512
+
+/* Microbenchmark results */
+typedef struct {
+    ULONG cycles_x100[MICRO_KERNELS];   /* Cycles per instruction * 100 */
+    ULONG ns_x100[MICRO_KERNELS];       /* ns per instruction * 100 */
+    BOOL supported[MICRO_KERNELS];      /* Kernel was run on this CPU */
+    BOOL emulated[MICRO_KERNELS];       /* Trapped and emulated in software */
+    ULONG cpu_mhz;                      /* MHz * 100 the cycles are based on */
+    BOOL valid;
+} MicroBenchResults;
+
+extern MicroBenchResults micro_results;
+
+/* Function prototypes */
+void run_micro_benchmarks(void);
+const char *get_micro_kernel_name(ULONG kernel);
+
+/* CPU view */
+void draw_cpu_view(void);
+
+/* Assembly kernel */
+void DoMicroBench(ULONG loops __asm("d0"), ULONG kernel __asm("d1"), APTR buffer __asm("a0"));
+
+#endif /* MICROBENCH_H */
@@ -0,0 +1,468 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Live system monitor
+ *
+ * A timer.device request wakes the main loop once per sample period.
+ * CPU load comes from idle-time accounting: a priority -128 task counts
+ * loop iterations whenever nothing else wants the CPU, and the count is
+ * compared against the rate calibrated on an unloaded CPU. Memory is
+ * sampled from the MemList headers. Graphs are scrolled by one column
+ * per sample, so only the newest column is drawn.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <exec/execbase.h>
+#include <exec/memory.h>
+#include <devices/timer.h>
+
+#include <proto/exec.h>
+#include <proto/graphics.h>
+#include <clib/alib_protos.h>
+
+#include "xsysinfo.h"
+#include "monitor.h"
+#include "memory.h"
+#include "benchmark.h"
+#include "gui.h"
+#include "locale_str.h"
+#include "debug.h"
+
+extern struct ExecBase *SysBase;
+
+/* Idle task */
+#define IDLE_TASK_STACK     1024
+#define IDLE_SPIN_CHUNK     256
+#define IDLE_CALIBRATE_US   20000
+
+/* Graph geometry (one column per sample, newest on the right) */
+#define GRAPH_COLUMN        4
+#define GRAPH_X             100
+#define GRAPH_W             (MONITOR_SAMPLES * GRAPH_COLUMN)
+#define CPU_GRAPH_Y         32
+#define CPU_GRAPH_H         68
+#define MEM_GRAPH_Y         112
+#define MEM_GRAPH_H         68
+
+/* Global sample history */
+MonitorHistory monitor_history;
+
+static volatile ULONG idle_count = 0;
+static struct Task *idle_task = NULL;
+static ULONG idle_per_ms = 0;       /* Idle loops per ms on an unloaded CPU */
+
+static struct MsgPort *monitor_port = NULL;
+static struct timerequest *monitor_req = NULL;
+static BOOL monitor_open = FALSE;
+static BOOL monitor_pending = FALSE;
+
+static struct EClockVal last_sample;
+static ULONG last_idle;
+
+/*
+ * Count idle loop iterations
+ */
+static void idle_spin(ULONG loops)
+{
+    while (loops--) {
+        idle_count++;
+    }
+}
+
+/*
+ * Idle task entry, only runs when no other task is ready
+ */
+static void idle_task_entry(void)
+{
+    for (;;) {
+        idle_spin(IDLE_SPIN_CHUNK);
+    }
+}
+
+/*
+ * Idle loop iterations per ms with the CPU to ourselves
+ */
+static ULONG calibrate_idle_loop(void)
+{
+    struct EClockVal start, end;
+    ULONG E_Freq;
+    ULONG loops = IDLE_SPIN_CHUNK;
+    uint64_t elapsed;
+
+    for (;;) {
+        Forbid();
+        E_Freq = read_benchmark_clock(&start);
+        idle_spin(loops);
+        E_Freq = read_benchmark_clock(&end);
+        Permit();
+        elapsed = EClock_Diff_in_ms(&start, &end, E_Freq);
+
+        if (elapsed >= IDLE_CALIBRATE_US || loops >= 0x10000000) break;
+        loops *= 2;
+    }
+
+    debug("  monitor: %lu idle loops in %lu us\n", loops, (ULONG)elapsed);
+
+    return elapsed > 0 ? (ULONG)(((uint64_t)loops * 1000) / elapsed) : 0;
+}
+
+/*
+ * Queue the next sample tick
+ */
+static void send_monitor_request(void)
+{
+    monitor_req->tr_node.io_Command = TR_ADDREQUEST;
+    monitor_req->tr_time.tv_secs = MONITOR_INTERVAL_SECS;
+    monitor_req->tr_time.tv_micro = 0;
+    SendIO((struct IORequest *)monitor_req);
+    monitor_pending = TRUE;
+}
+
+/*
+ * Record CPU load and free memory of each region in the next slot
+ */
+static void take_sample(void)
+{
+    MonitorHistory *h = &monitor_history;
+    struct EClockVal now;
+    struct MemHeader *mh;
+    ULONG E_Freq;
+    ULONG slot = h->head;
+    ULONG idle, busy = 0;
+    ULONG r = 0;
+    uint64_t elapsed, expected;
+
+    E_Freq = read_benchmark_clock(&now);
+    idle = idle_count - last_idle;
+    elapsed = EClock_Diff_in_ms(&last_sample, &now, E_Freq);
+    last_sample = now;
+    last_idle += idle;
+
+    expected = (elapsed * idle_per_ms) / 1000;
+    if (expected > 0 && idle < expected) {
+        busy = 100 - (ULONG)(((uint64_t)idle * 100) / expected);
+    }
+    h->cpu_busy[slot] = (UBYTE)busy;
+
+    Forbid();
+    for (mh = (struct MemHeader *)SysBase->MemList.lh_Head;
+         (struct Node *)mh != (struct Node *)&SysBase->MemList.lh_Tail &&
+         r < MONITOR_REGIONS;
+         mh = (struct MemHeader *)mh->mh_Node.ln_Succ, r++) {
+        struct MemChunk *mc;
+        ULONG largest = 0;
+
+        for (mc = mh->mh_First; mc != NULL; mc = mc->mc_Next) {
+            if (mc->mc_Bytes > largest) largest = mc->mc_Bytes;
+        }
+        h->mem_free[r][slot] = mh->mh_Free;
+        h->mem_largest[r][slot] = largest;
+        h->region_size[r] = (ULONG)mh->mh_Upper - (ULONG)mh->mh_Lower;
+    }
+    Permit();
+
+    h->regions = r;
+    h->head = (slot + 1) % MONITOR_SAMPLES;
+    if (h->count < MONITOR_SAMPLES) h->count++;
+}
+
+/*
+ * Start the sampler. Returns FALSE if the timer or idle task is not available
+ */
+BOOL start_monitor(void)
+{
+    struct MemHeader *mh;
+
+    if (monitor_port) return TRUE;
+    if (!benchmark_timer_available()) return FALSE;
+
+    /* Before the idle task exists, or it would count against itself */
+    if (idle_per_ms == 0) {
+        idle_per_ms = calibrate_idle_loop();
+        if (idle_per_ms == 0) return FALSE;
+    }
+
+    monitor_port = CreatePort(NULL, 0);
+    if (!monitor_port) goto cleanup;
+
+    monitor_req = (struct timerequest *)
+        CreateExtIO(monitor_port, sizeof(struct timerequest));
+    if (!monitor_req) goto cleanup;
+
+    if (OpenDevice((CONST_STRPTR)"timer.device", UNIT_VBLANK,
+                   (struct IORequest *)monitor_req, 0) != 0) {
+        goto cleanup;
+    }
+    monitor_open = TRUE;
+
+    idle_task = CreateTask((STRPTR)XSYSINFO_NAME " idle", -128,
+                           (APTR)idle_task_entry, IDLE_TASK_STACK);
+    if (!idle_task) goto cleanup;
+
+    /* Region count is known before the first sample for the view buttons */
+    memset(&monitor_history, 0, sizeof(monitor_history));
+    Forbid();
+    for (mh = (struct MemHeader *)SysBase->MemList.lh_Head;
+         (struct Node *)mh != (struct Node *)&SysBase->MemList.lh_Tail &&
+         monitor_history.regions < MONITOR_REGIONS;
+         mh = (struct MemHeader *)mh->mh_Node.ln_Succ) {
+        monitor_history.regions++;
+    }
+    Permit();
+
+    read_benchmark_clock(&last_sample);
+    last_idle = idle_count;
+
+    send_monitor_request();
+    return TRUE;
+
+cleanup:
+    debug("  monitor: cannot start sampler\n");
+    stop_monitor();
+    return FALSE;
+}
+
+/*
+ * Stop the sampler and free its resources
+ */
+void stop_monitor(void)
+{
+    if (idle_task) {
+        DeleteTask(idle_task);
+        idle_task = NULL;
+    }
+    if (monitor_pending) {
+        AbortIO((struct IORequest *)monitor_req);
+        WaitIO((struct IORequest *)monitor_req);
+        monitor_pending = FALSE;
+    }
+    if (monitor_open) {
+        CloseDevice((struct IORequest *)monitor_req);
+        monitor_open = FALSE;
+    }
+    if (monitor_req) {
+        DeleteExtIO((struct IORequest *)monitor_req);
+        monitor_req = NULL;
+    }
+    if (monitor_port) {
+        DeletePort(monitor_port);
+        monitor_port = NULL;
+    }
+}
+
+/*
+ * Signal mask of the sample timer
+ */
+ULONG monitor_signal(void)
+{
+    return monitor_port ? 1UL << monitor_port->mp_SigBit : 0;
+}
+
+/*
+ * Slot of the k-th oldest sample
+ */
+static ULONG sample_slot(ULONG k)
+{
+    MonitorHistory *h = &monitor_history;
+
+    return (h->head + MONITOR_SAMPLES - h->count + k) % MONITOR_SAMPLES;
+}
+
+/*
+ * Draw one graph column: value as a bar, overlay (if any) on top of it
+ */
+static void draw_graph_column(WORD x, WORD y, WORD h, ULONG value, ULONG overlay,
+                              ULONG scale)
+{
+    struct RastPort *rp = app->rp;
+    WORD bar;
+
+    SetAPen(rp, COLOR_BACKGROUND);
+    RectFill(rp, x, y, x + GRAPH_COLUMN - 1, y + h - 1);
+
+    if (scale == 0) return;
+
+    bar = (WORD)(((uint64_t)(value > scale ? scale : value) * h) / scale);
+    if (bar > 0) {
+        SetAPen(rp, COLOR_BAR_FILL);
+        RectFill(rp, x, y + h - bar, x + GRAPH_COLUMN - 1, y + h - 1);
+    }
+
+    bar = (WORD)(((uint64_t)(overlay > scale ? scale : overlay) * h) / scale);
+    if (bar > 0) {
+        SetAPen(rp, COLOR_BAR_YOU);
+        RectFill(rp, x, y + h - bar, x + GRAPH_COLUMN - 1, y + h - 1);
+    }
+}
+
+/*
+ * Draw the CPU and memory columns of one sample at x
+ */
+static void draw_sample(WORD x, ULONG slot)
+{
+    MonitorHistory *h = &monitor_history;
+    ULONG r = (ULONG)app->monitor_region;
+
+    draw_graph_column(x, CPU_GRAPH_Y, CPU_GRAPH_H, h->cpu_busy[slot], 0, 100);
+    if (r < h->regions) {
+        draw_graph_column(x, MEM_GRAPH_Y, MEM_GRAPH_H, h->mem_free[r][slot],
+                          h->mem_largest[r][slot], h->region_size[r]);
+    }
+}
+
+/*
+ * Draw the current values left of the graphs
+ */
+static void draw_monitor_values(void)
+{
+    MonitorHistory *h = &monitor_history;
+    ULONG r = (ULONG)app->monitor_region;
+    char buffer[32];
+    char size_str[16];
+
+    if (h->count == 0) {
+        snprintf(buffer, sizeof(buffer), "%-9s", get_string(MSG_NA));
+        draw_text(28, 56, buffer, COLOR_HIGHLIGHT);
+        draw_text(28, 144, buffer, COLOR_HIGHLIGHT);
+        draw_text(28, 168, buffer, COLOR_HIGHLIGHT);
+        return;
+    }
+
+    snprintf(buffer, sizeof(buffer), "%3lu%%",
+             (unsigned long)h->cpu_busy[sample_slot(h->count - 1)]);
+    draw_text(28, 56, buffer, COLOR_HIGHLIGHT);
+
+    if (r < h->regions) {
+        ULONG slot = sample_slot(h->count - 1);
+
+        format_size(h->mem_free[r][slot], size_str, sizeof(size_str));
+        snprintf(buffer, sizeof(buffer), "%-9s", size_str);
+        draw_text(28, 144, buffer, COLOR_HIGHLIGHT);
+
+        format_size(h->mem_largest[r][slot], size_str, sizeof(size_str));
+        snprintf(buffer, sizeof(buffer), "%-9s", size_str);
+        draw_text(28, 168, buffer, COLOR_HIGHLIGHT);
+    }
+}
+
+/*
+ * Scroll the graphs by one column and draw the newest sample
+ */
+static void draw_new_sample(void)
+{
+    struct RastPort *rp = app->rp;
+
+    SetBPen(rp, COLOR_BACKGROUND);
+    ScrollRaster(rp, GRAPH_COLUMN, 0, GRAPH_X, CPU_GRAPH_Y,
+                 GRAPH_X + GRAPH_W - 1, CPU_GRAPH_Y + CPU_GRAPH_H - 1);
+    ScrollRaster(rp, GRAPH_COLUMN, 0, GRAPH_X, MEM_GRAPH_Y,
+                 GRAPH_X + GRAPH_W - 1, MEM_GRAPH_Y + MEM_GRAPH_H - 1);
+
+    draw_sample(GRAPH_X + GRAPH_W - GRAPH_COLUMN,
+                sample_slot(monitor_history.count - 1));
+    draw_monitor_values();
+}
+
+/*
+ * Take a sample when the timer has fired and queue the next one
+ */
+void handle_monitor_signal(void)
+{
+    if (!monitor_pending || !CheckIO((struct IORequest *)monitor_req)) return;
+
+    WaitIO((struct IORequest *)monitor_req);
+    monitor_pending = FALSE;
+
+    take_sample();
+    send_monitor_request();
+
+    if (app->current_view == VIEW_MONITOR) {
+        draw_new_sample();
+    }
+}
+
+/*
+ * Draw monitor view
+ */
+void draw_monitor_view(void)
+{
+    struct RastPort *rp = app->rp;
+    MonitorHistory *h = &monitor_history;
+    char buffer[16];
+    Button *btn;
+    ULONG k;
+    ULONG r = (ULONG)app->monitor_region;
+
+    /* Title panel */
+    draw_panel(20, 0, 600, 24, NULL);
+    draw_text_centered(20, 14, 600, get_string(MSG_MONITOR), COLOR_TEXT);
+
+    /* CPU load */
+    draw_panel(20, 28, 600, 76, NULL);
+    draw_text(28, 44, get_string(MSG_MON_CPU_LOAD), COLOR_TEXT);
+
+    /* Free memory (bar) and largest block (overlay) of one region */
+    draw_panel(20, 108, 600, 76, NULL);
+    if (r < memory_regions.count) {
+        snprintf(buffer, sizeof(buffer), "%.9s", memory_regions.regions[r].node_name);
+        draw_text(28, 120, buffer, COLOR_TEXT);
+    }
+    draw_text(28, 134, get_string(MSG_FRAG_FREE), COLOR_TEXT);
+    draw_text(28, 158, get_string(MSG_MON_LARGEST), COLOR_TEXT);
+
+    SetAPen(rp, COLOR_BACKGROUND);
+    RectFill(rp, GRAPH_X, CPU_GRAPH_Y, GRAPH_X + GRAPH_W - 1, CPU_GRAPH_Y + CPU_GRAPH_H - 1);
+    RectFill(rp, GRAPH_X, MEM_GRAPH_Y, GRAPH_X + GRAPH_W - 1, MEM_GRAPH_Y + MEM_GRAPH_H - 1);
+
+    for (k = 0; k < h->count; k++) {
+        draw_sample(GRAPH_X + GRAPH_W - (WORD)(h->count - k) * GRAPH_COLUMN, sample_slot(k));
+    }
+    draw_monitor_values();
+
+    /* Buttons */
+    btn = find_button(BTN_MON_EXIT);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_MON_REGION);
+    if (btn) draw_button(btn);
+}
+
+/*
+ * Update buttons for monitor view
+ */
+void monitor_view_update_buttons(void)
+{
+    static char counter_str[16];
+
+    snprintf(counter_str, sizeof(counter_str), "%ld / %lu",
+             (long)app->monitor_region + 1, (unsigned long)monitor_history.regions);
+    add_button(20, 188, 60, 12,
+               get_string(MSG_BTN_EXIT), BTN_MON_EXIT, TRUE);
+    add_button(84, 188, 60, 12,
+               counter_str, BTN_MON_REGION, monitor_history.regions > 1);
+}
+
+/*
+ * Handle button press for monitor view
+ */
+void monitor_view_handle_button(ButtonID id)
+{
+    switch (id) {
+        case BTN_MON_EXIT:
+            switch_to_view(VIEW_MAIN);
+            break;
+
+        case BTN_MON_REGION:
+            if (monitor_history.regions > 0) {
+                app->monitor_region = (app->monitor_region + 1) %
+                                      (LONG)monitor_history.regions;
+            }
+            redraw_current_view();
+            break;
+
+        default:
+            break;
+    }
+}
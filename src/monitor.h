@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Live system monitor header
+ */
+
+#ifndef MONITOR_H
+#define MONITOR_H
+
+#include "xsysinfo.h"
+
+/* Ring buffer length, one graph column per sample */
+#define MONITOR_SAMPLES         128
+
+/* Memory regions sampled (in MemList order) */
+#define MONITOR_REGIONS         8
+
+/* Sample period */
+#define MONITOR_INTERVAL_SECS   1
+
+/* Sample history, oldest sample at head when the buffer is full */
+typedef struct {
+    UBYTE cpu_busy[MONITOR_SAMPLES];                    /* Percent */
+    ULONG mem_free[MONITOR_REGIONS][MONITOR_SAMPLES];   /* Bytes */
+    ULONG mem_largest[MONITOR_REGIONS][MONITOR_SAMPLES];
+    ULONG region_size[MONITOR_REGIONS];
+    ULONG regions;          /* Regions sampled */
+    ULONG head;             /* Next slot to write */
+    ULONG count;            /* Valid samples */
+} MonitorHistory;
+
+extern MonitorHistory monitor_history;
+
+/* Start/stop the sampler (idle task and timer request) */
+BOOL start_monitor(void);
+void stop_monitor(void);
+
+/* Signal mask of the sample timer, 0 if the monitor is not running */
+ULONG monitor_signal(void);
+
+/* Take a sample after the timer fired and draw it if the view is shown */
+void handle_monitor_signal(void);
+
+/* Draw monitor view */
+void draw_monitor_view(void);
+
+#endif /* MONITOR_H */
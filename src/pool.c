@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Memory pool and string table
+ *
+ * The software, memory, drive and SCSI lists are sized to what the
+ * enumeration finds and live in one pool, so a small machine does not
+ * pay for tables dimensioned for a big one. Names are stored once per
+ * distinct string; re-enumerating finds the same names again and does
+ * not grow the pool.
+ */
+
+#include <string.h>
+
+#include <exec/memory.h>
+
+#include <proto/exec.h>
+#include <clib/alib_protos.h>
+
+#include "xsysinfo.h"
+#include "pool.h"
+#include "debug.h"
+
+#define POOL_PUDDLE_SIZE    4096
+#define POOL_THRESHOLD      1024
+
+/* Interned string, text follows the header */
+typedef struct PoolString {
+    struct PoolString *next;
+    char text[1];
+} PoolString;
+
+static APTR pool = NULL;
+static PoolString *strings[POOL_STRING_BUCKETS];
+
+/*
+ * Allocate cleared memory, the size is kept in front of the block.
+ * The amiga.lib pool functions use the exec ones on V39 and emulate
+ * them on older Kickstarts.
+ */
+APTR pool_alloc(ULONG size)
+{
+    ULONG *mem;
+
+    if (!pool) {
+        pool = LibCreatePool(MEMF_ANY, POOL_PUDDLE_SIZE, POOL_THRESHOLD);
+        if (!pool) {
+            debug("  pool: Failed to create pool\n");
+            return NULL;
+        }
+    }
+
+    mem = (ULONG *)LibAllocPooled(pool, size + sizeof(ULONG));
+    if (!mem) {
+        debug("  pool: Failed to allocate %ld bytes\n", (LONG)size);
+        return NULL;
+    }
+
+    /* Memory freed back into a puddle is not cleared again */
+    memset(mem, 0, size + sizeof(ULONG));
+    mem[0] = size + sizeof(ULONG);
+
+    return (APTR)(mem + 1);
+}
+
+void pool_free(APTR mem)
+{
+    ULONG *block;
+
+    if (!mem || !pool) return;
+
+    block = (ULONG *)mem - 1;
+    LibFreePooled(pool, block, block[0]);
+}
+
+/*
+ * Grow by doubling, copying the used part of the old array
+ */
+APTR pool_grow(APTR array, ULONG *capacity, ULONG needed, ULONG entry_size)
+{
+    APTR new_array;
+    ULONG new_capacity;
+
+    if (array && needed <= *capacity) return array;
+
+    new_capacity = *capacity ? *capacity : 8;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+
+    new_array = pool_alloc(new_capacity * entry_size);
+    if (!new_array) return NULL;
+
+    if (array) {
+        memcpy(new_array, array, *capacity * entry_size);
+        pool_free(array);
+    }
+    *capacity = new_capacity;
+
+    return new_array;
+}
+
+static ULONG hash_string(const char *str)
+{
+    ULONG hash = 5381;
+
+    while (*str) {
+        hash = hash * 33 + (UBYTE)*str++;
+    }
+
+    return hash % POOL_STRING_BUCKETS;
+}
+
+/*
+ * Look the string up and store it on first use
+ */
+const char *pool_string(const char *str)
+{
+    PoolString *ps;
+    ULONG bucket;
+    ULONG len;
+
+    if (!str || !str[0]) return "";
+
+    bucket = hash_string(str);
+    for (ps = strings[bucket]; ps; ps = ps->next) {
+        if (strcmp(ps->text, str) == 0) return ps->text;
+    }
+
+    len = strlen(str);
+    ps = (PoolString *)pool_alloc(sizeof(PoolString) + len);
+    if (!ps) return "";
+
+    memcpy(ps->text, str, len + 1);
+    ps->next = strings[bucket];
+    strings[bucket] = ps;
+
+    return ps->text;
+}
+
+/*
+ * Deleting the pool frees every list and string at once
+ */
+void pool_cleanup(void)
+{
+    if (pool) {
+        LibDeletePool(pool);
+        pool = NULL;
+    }
+    memset(strings, 0, sizeof(strings));
+}
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Memory pool and string table header
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#include "xsysinfo.h"
+
+/* Strings are hashed into this many chains */
+#define POOL_STRING_BUCKETS     64
+
+/* Allocate cleared memory from the pool, NULL if out of memory */
+APTR pool_alloc(ULONG size);
+void pool_free(APTR mem);
+
+/*
+ * Make room for 'needed' entries of an array allocated from the pool.
+ * Returns the (possibly moved) array, or NULL with the old array intact.
+ */
+APTR pool_grow(APTR array, ULONG *capacity, ULONG needed, ULONG entry_size);
+
+/* Shared copy of a string, "" if out of memory, never NULL */
+const char *pool_string(const char *str);
+
+/* Free all lists and strings */
+void pool_cleanup(void);
+
+#endif /* POOL_H */
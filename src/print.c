@@ -22,6 +22,13 @@
 #include "memory.h"
 #include "boards.h"
 #include "drives.h"
+#include "history.h"
+#include "microbench.h"
+#include "blitbench.h"
+#include "latency.h"
+#include "gfxbench.h"
+#include "harness.h"
+#include "profile.h"
 #include "locale_str.h"
 
 /* External references */
@@ -30,6 +37,7 @@ extern BenchmarkResults bench_results;
 extern SoftwareList libraries_list;
 extern SoftwareList devices_list;
 extern SoftwareList resources_list;
+extern SoftwareList mmu_list;
 extern MemoryRegionList memory_regions;
 extern BoardList board_list;
 extern DriveList drive_list;
@@ -310,6 +318,16 @@ void export_software(BPTR fh)
                         (unsigned long)e->address, e->version, e->revision);
     }
     WRITE_LINE(fh, "");
+
+    /* MMU mappings and tuning findings */
+    WRITE_LINE(fh, "--- MMU ---");
+    analyze_mmu_mappings();
+    for (i = 0; i < mmu_list.count; i++) {
+        char buffer[128];
+        write_formatted(fh, "%s", get_software_entry_name(&mmu_list.entries[i],
+                                                          buffer, sizeof(buffer)));
+    }
+    WRITE_LINE(fh, "");
 }
 
 /*
@@ -322,20 +340,69 @@ void export_benchmarks(BPTR fh)
 
     if (bench_results.benchmarks_valid) {
         write_formatted(fh, "Dhrystones:        %lu", (unsigned long)bench_results.dhrystones);
+        if (bench_results.dhry_stats.runs > 1) {
+            write_formatted(fh, "  Median of %lu runs, min %lu, max %lu, stddev %lu%s",
+                            (unsigned long)bench_results.dhry_stats.runs,
+                            (unsigned long)bench_results.dhry_stats.min,
+                            (unsigned long)bench_results.dhry_stats.max,
+                            (unsigned long)bench_results.dhry_stats.stddev,
+                            bench_results.dhry_stats.unstable ? " (unstable)" : "");
+        }
         {
             char scaled_buf[16];
             format_scaled(scaled_buf, sizeof(scaled_buf), bench_results.mips, FALSE);
             write_formatted(fh, "MIPS:              %s", scaled_buf);
         }
+        /* The figures above come from the baseline 68000 binary */
+        if (bench_results.dhry_build != DHRY_BUILD_68000) {
+            char scaled_buf[16];
+            format_scaled(scaled_buf, sizeof(scaled_buf), bench_results.mips_native, FALSE);
+            write_formatted(fh, "Native build:      %lu Dhrystones, %s MIPS (%s code, above: 68000)",
+                            (unsigned long)bench_results.dhrystones_native, scaled_buf,
+                            get_dhry_build_name(bench_results.dhry_build));
+        }
 
         if (hw_info.fpu_type != FPU_NONE) {
             char scaled_buf[16];
             format_scaled(scaled_buf, sizeof(scaled_buf), bench_results.mflops, FALSE);
             write_formatted(fh, "MFLOPS:            %s", scaled_buf);
+            if (bench_results.mflops_stats.runs > 1) {
+                char min_buf[16], max_buf[16], sd_buf[16];
+                format_scaled(min_buf, sizeof(min_buf), bench_results.mflops_stats.min, FALSE);
+                format_scaled(max_buf, sizeof(max_buf), bench_results.mflops_stats.max, FALSE);
+                format_scaled(sd_buf, sizeof(sd_buf), bench_results.mflops_stats.stddev, FALSE);
+                write_formatted(fh, "  Median of %lu runs, min %s, max %s, stddev %s%s",
+                                (unsigned long)bench_results.mflops_stats.runs,
+                                min_buf, max_buf, sd_buf,
+                                bench_results.mflops_stats.unstable ? " (unstable)" : "");
+            }
         } else {
             WRITE_LINE(fh, "MFLOPS:            N/A (no FPU)");
         }
 
+        /* Per-operation FPU breakdown */
+        if (bench_results.fpu_suite.valid) {
+            const FpuSuite *suite = &bench_results.fpu_suite;
+            ULONG op;
+
+            WRITE_LINE(fh, "FPU Operations:");
+            for (op = 0; op < FPU_OPS; op++) {
+                char mops_str[16];
+                BOOL emulated = suite->emulated && op >= FPU_OP_FSIN && op <= FPU_OP_FETOX;
+
+                if (suite->mops[op] == 0) {
+                    write_formatted(fh, "  %-8s N/A", get_fpu_op_name((FpuOp)op));
+                    continue;
+                }
+                format_scaled(mops_str, sizeof(mops_str), suite->mops[op], FALSE);
+                write_formatted(fh, "  %-8s %8s %s  %6lu ns/op%s",
+                                get_fpu_op_name((FpuOp)op), mops_str,
+                                op == FPU_OP_DAXPY ? "MFLOPS" : "Mops  ",
+                                (unsigned long)suite->ns_per_op[op],
+                                emulated ? "  (FPSP emulated)" : "");
+            }
+        }
+
         /* Memory speeds */
         {
             char chip_str[16], fast_str[16], rom_str[16];
@@ -360,6 +427,82 @@ void export_benchmarks(BPTR fh)
 
             write_formatted(fh, "Memory Speed:      CHIP %s  FAST %s  ROM %s MB/s",
                            chip_str, fast_str, rom_str);
+
+            if (bench_results.chip_write_speed > 0) {
+                format_scaled(chip_str, sizeof(chip_str), bench_results.chip_write_speed / 10000, TRUE);
+            } else {
+                strncpy(chip_str, "N/A", sizeof(chip_str));
+            }
+
+            if (bench_results.fast_write_speed > 0) {
+                format_scaled(fast_str, sizeof(fast_str), bench_results.fast_write_speed / 10000, TRUE);
+            } else {
+                strncpy(fast_str, "N/A", sizeof(fast_str));
+            }
+
+            write_formatted(fh, "Memory Write:      CHIP %s  FAST %s MB/s",
+                           chip_str, fast_str);
+
+            if (bench_results.chip_copy_speed > 0) {
+                format_scaled(chip_str, sizeof(chip_str), bench_results.chip_copy_speed / 10000, TRUE);
+            } else {
+                strncpy(chip_str, "N/A", sizeof(chip_str));
+            }
+
+            if (bench_results.fast_copy_speed > 0) {
+                format_scaled(fast_str, sizeof(fast_str), bench_results.fast_copy_speed / 10000, TRUE);
+            } else {
+                strncpy(fast_str, "N/A", sizeof(fast_str));
+            }
+
+            write_formatted(fh, "Memory Copy:       CHIP %s  FAST %s MB/s",
+                           chip_str, fast_str);
+        }
+
+        /* Kickstart shadowing */
+        if (bench_results.rom_shadow != ROM_SHADOW_UNKNOWN) {
+            char call_str[16];
+            const char *state;
+
+            switch (bench_results.rom_shadow) {
+                case ROM_SHADOW_MMU:
+                    state = "remapped to RAM by mmu.library";
+                    break;
+                case ROM_SHADOW_FAST:
+                    state = "reads at RAM speed (MAPROM)";
+                    break;
+                default:
+                    state = "not shadowed";
+                    break;
+            }
+            write_formatted(fh, "Kickstart ROM:     %s", state);
+
+            format_scaled(call_str, sizeof(call_str), bench_results.rom_call_ns_x100, FALSE);
+            write_formatted(fh, "Exec call:         %s ns%s", call_str,
+                            bench_results.rom_call_in_rom ? "" : " (FindTask() patched)");
+            if (bench_results.maprom_hint) {
+                WRITE_LINE(fh, "                   Enabling MAPROM would speed up the OS");
+            }
+        }
+
+        /* Emu68 JIT passes */
+        if (bench_results.jit.valid) {
+            const JitResults *jit = &bench_results.jit;
+            char cold_str[16], warm_str[16];
+
+            write_formatted(fh, "JIT Dhrystones:    cold %lu  warm %lu",
+                            (unsigned long)jit->dhry_cold, (unsigned long)jit->dhry_warm);
+            if (jit->mflops_warm > 0) {
+                format_scaled(cold_str, sizeof(cold_str), jit->mflops_cold, FALSE);
+                format_scaled(warm_str, sizeof(warm_str), jit->mflops_warm, FALSE);
+                write_formatted(fh, "JIT MFLOPS:        cold %s  warm %s", cold_str, warm_str);
+            }
+            format_scaled(cold_str, sizeof(cold_str), jit->mem_cold / 10000, TRUE);
+            format_scaled(warm_str, sizeof(warm_str), jit->mem_warm / 10000, TRUE);
+            write_formatted(fh, "JIT Memory Read:   cold %s  warm %s MB/s", cold_str, warm_str);
+            format_scaled(cold_str, sizeof(cold_str), jit->flush_us_x100, FALSE);
+            write_formatted(fh, "JIT Cache Flush:   %s us per CacheClearU(), %lu us to retranslate",
+                            cold_str, (unsigned long)jit->retranslate_us);
         }
     } else {
         WRITE_LINE(fh, "Benchmarks not run. Press SPEED button to run benchmarks.");
@@ -382,6 +525,345 @@ void export_benchmarks(BPTR fh)
     WRITE_LINE(fh, "");
 }
 
+/*
+ * Export instruction timings (only if measured in the CPU view)
+ */
+void export_microbench(BPTR fh)
+{
+    ULONG k;
+
+    WRITE_LINE(fh, "=== CPU INSTRUCTION TIMING ===");
+    WRITE_LINE(fh, "");
+
+    if (!micro_results.valid) {
+        WRITE_LINE(fh, "Not measured. Press RUN in the CPU view to measure.");
+        WRITE_LINE(fh, "");
+        return;
+    }
+
+    if (micro_results.cpu_mhz > 0) {
+        char mhz_str[16];
+        format_scaled(mhz_str, sizeof(mhz_str), micro_results.cpu_mhz, FALSE);
+        write_formatted(fh, "Cycles at %s MHz (%s), loop overhead subtracted", mhz_str, hw_info.cpu_string);
+    }
+    WRITE_LINE(fh, "Instruction          Cycles        ns");
+    WRITE_LINE(fh, "-------------------  ------  --------");
+    for (k = 0; k < MICRO_KERNELS; k++) {
+        char cycles_str[16], ns_str[16];
+
+        if (!micro_results.supported[k]) {
+            write_formatted(fh, "%-19s  %6s  %8s", get_micro_kernel_name(k), "N/A", "N/A");
+            continue;
+        }
+        if (micro_results.cpu_mhz > 0) {
+            format_scaled(cycles_str, sizeof(cycles_str), micro_results.cycles_x100[k], FALSE);
+        } else {
+            strncpy(cycles_str, "N/A", sizeof(cycles_str));
+        }
+        format_scaled(ns_str, sizeof(ns_str), micro_results.ns_x100[k], FALSE);
+        write_formatted(fh, "%-19s  %6s  %8s%s", get_micro_kernel_name(k), cycles_str, ns_str,
+                        micro_results.emulated[k] ? "  (emulated)" : "");
+    }
+    WRITE_LINE(fh, "");
+}
+
+/*
+ * Export cache configuration matrix
+ */
+void export_cache_matrix(BPTR fh)
+{
+    ULONG i;
+    ULONG best;
+
+    WRITE_LINE(fh, "=== CACHE CONFIGURATIONS ===");
+    WRITE_LINE(fh, "");
+
+    if (!cache_matrix.valid) {
+        WRITE_LINE(fh, "Not measured. Press CACHES in the CPU view to measure.");
+        WRITE_LINE(fh, "");
+        return;
+    }
+
+    best = cache_matrix.entries[cache_matrix.best_dhrystones].dhrystones;
+
+    WRITE_LINE(fh, "ICache DCache IBurst DBurst CBack SuperS  Dhrystones  Read MB/s     %");
+    WRITE_LINE(fh, "------ ------ ------ ------ ----- ------  ----------  ---------  ----");
+    for (i = 0; i < cache_matrix.count; i++) {
+        CacheMatrixEntry *entry = &cache_matrix.entries[i];
+        char read_str[16];
+
+        format_scaled(read_str, sizeof(read_str), entry->read_speed / 10000, FALSE);
+        write_formatted(fh, "%-6s %-6s %-6s %-6s %-5s %-6s  %10lu  %9s  %4lu%s",
+                        entry->config.icache ? "ON" : "OFF",
+                        entry->config.dcache ? "ON" : "OFF",
+                        entry->config.iburst ? "ON" : "OFF",
+                        entry->config.dburst ? "ON" : "OFF",
+                        entry->config.copyback ? "ON" : "OFF",
+                        entry->config.super_scalar ? "ON" : "OFF",
+                        (unsigned long)entry->dhrystones, read_str,
+                        best > 0 ? (unsigned long)(((uint64_t)entry->dhrystones * 100) / best) : 0UL,
+                        i == cache_matrix.best_dhrystones ? "  (best)" : "");
+    }
+    WRITE_LINE(fh, "");
+}
+
+/*
+ * Export blitter throughput and the CPU copy crossover
+ */
+void export_blitter_bench(BPTR fh)
+{
+    ULONG s;
+
+    WRITE_LINE(fh, "=== BLITTER VS CPU THROUGHPUT ===");
+    WRITE_LINE(fh, "");
+
+    if (!blit_results.valid) {
+        WRITE_LINE(fh, "Not measured. Press BLITTER in the CPU view to measure.");
+        WRITE_LINE(fh, "");
+        return;
+    }
+
+    write_formatted(fh, "%s, %s", hw_info.cpu_string, get_agnus_string(hw_info.agnus_type));
+    WRITE_LINE(fh, "Size     Copy MB/s  Fill MB/s  Line Mpx/s  CPU MB/s");
+    WRITE_LINE(fh, "-------  ---------  ---------  ----------  --------");
+    for (s = 0; s < BLIT_SIZES; s++) {
+        char size_str[16], copy_str[16], fill_str[16], line_str[16], cpu_str[16];
+        ULONG side = get_blit_side(s);
+
+        snprintf(size_str, sizeof(size_str), "%lux%lu", (unsigned long)side, (unsigned long)side);
+        format_scaled(copy_str, sizeof(copy_str), blit_results.speed[BLIT_OP_COPY][s] / 10000, FALSE);
+        format_scaled(fill_str, sizeof(fill_str), blit_results.speed[BLIT_OP_FILL][s] / 10000, FALSE);
+        format_scaled(line_str, sizeof(line_str), blit_results.speed[BLIT_OP_LINE][s] / 10000, FALSE);
+        format_scaled(cpu_str, sizeof(cpu_str), blit_results.speed[BLIT_OP_CPU_COPY][s] / 10000, FALSE);
+        write_formatted(fh, "%-7s  %9s  %9s  %10s  %8s", size_str, copy_str, fill_str, line_str, cpu_str);
+    }
+
+    if (blit_results.cpu_faster_up_to == 0) {
+        WRITE_LINE(fh, "Blitter copy faster at all sizes");
+    } else if (blit_results.cpu_faster_up_to == BLIT_MAX_SIDE) {
+        WRITE_LINE(fh, "CPU copy to CHIP faster at all sizes");
+    } else {
+        write_formatted(fh, "CPU copy to CHIP faster up to %lux%lu",
+                        (unsigned long)blit_results.cpu_faster_up_to,
+                        (unsigned long)blit_results.cpu_faster_up_to);
+    }
+    WRITE_LINE(fh, "");
+}
+
+/*
+ * Export Exec scheduling latency
+ */
+void export_latency_bench(BPTR fh)
+{
+    ULONG t;
+
+    WRITE_LINE(fh, "=== EXEC SCHEDULING LATENCY ===");
+    WRITE_LINE(fh, "");
+
+    if (!latency_results.valid) {
+        WRITE_LINE(fh, "Not measured. Press LATENCY in the CPU view to measure.");
+        WRITE_LINE(fh, "");
+        return;
+    }
+
+    WRITE_LINE(fh, "Test       Samples    Min us    Avg us    Max us");
+    WRITE_LINE(fh, "---------  -------  --------  --------  --------");
+    for (t = 0; t < LAT_TESTS; t++) {
+        const LatencyStats *st = &latency_results.test[t];
+        char min_str[16], avg_str[16], max_str[16];
+
+        if (st->samples == 0) {
+            write_formatted(fh, "%-9s  not run", get_latency_test_name(t));
+            continue;
+        }
+        format_scaled(min_str, sizeof(min_str), st->min_ns / 10, FALSE);
+        format_scaled(avg_str, sizeof(avg_str), st->avg_ns / 10, FALSE);
+        format_scaled(max_str, sizeof(max_str), st->max_ns / 10, FALSE);
+        write_formatted(fh, "%-9s  %7lu  %8s  %8s  %8s", get_latency_test_name(t),
+                        (unsigned long)st->samples, min_str, avg_str, max_str);
+    }
+    write_formatted(fh, "Timer: %lu us UNIT_MICROHZ requests, time past the delay",
+                    (unsigned long)LAT_TIMER_DELAY_US);
+    WRITE_LINE(fh, "");
+}
+
+/*
+ * Export graphics.library throughput per screen
+ */
+void export_gfx_bench(BPTR fh)
+{
+    ULONG s, op;
+
+    WRITE_LINE(fh, "=== GRAPHICS OPERATIONS ===");
+    WRITE_LINE(fh, "");
+
+    if (!gfx_results.valid) {
+        WRITE_LINE(fh, "Not measured. Select GFX OPS in the hardware panel to measure.");
+        WRITE_LINE(fh, "");
+        return;
+    }
+
+    for (s = 0; s < GFX_SCREENS; s++) {
+        const GfxScreenResults *res = &gfx_results.screen[s];
+
+        if (!res->valid) {
+            if (s == GFX_SCREEN_MODE) {
+                WRITE_LINE(fh, "No RTG screen mode measured (set GFXMODE to choose one).");
+            }
+            continue;
+        }
+
+        write_formatted(fh, "%s screen: mode $%08lx, %ux%ux%u%s",
+                        s == GFX_SCREEN_CURRENT ? "Current" : "Selected",
+                        (unsigned long)res->mode_id, (unsigned)res->width,
+                        (unsigned)res->height, (unsigned)res->depth,
+                        res->rtg ? " (RTG)" : "");
+        WRITE_LINE(fh, "Operation    Ops/s      MB/s");
+        WRITE_LINE(fh, "---------  -------  --------");
+        for (op = 0; op < GFX_OPS; op++) {
+            char mb_str[16];
+
+            if (res->ops_sec[op] == 0) {
+                write_formatted(fh, "%-9s  %7s  %8s", get_gfx_op_name(op), "N/A", "N/A");
+                continue;
+            }
+            format_scaled(mb_str, sizeof(mb_str), res->bytes_sec[op] / 10000, FALSE);
+            write_formatted(fh, "%-9s  %7lu  %8s", get_gfx_op_name(op),
+                            (unsigned long)res->ops_sec[op], mb_str);
+        }
+        WRITE_LINE(fh, "");
+    }
+}
+
+/*
+ * Date of a history entry
+ */
+static void format_history_date(char *buffer, size_t size, const HistoryEntry *entry)
+{
+#ifndef __KICK13__
+    char date_str[16]; date_str[0] = '\0';
+    char time_str[16]; time_str[0] = '\0';
+    struct DateTime dt;
+
+    memset(&dt, 0, sizeof(dt));
+    dt.dat_Stamp.ds_Days = entry->days;
+    dt.dat_Stamp.ds_Minute = entry->minutes;
+    dt.dat_Format = FORMAT_DOS;
+    dt.dat_StrDate = (STRPTR)date_str;
+    dt.dat_StrTime = (STRPTR)time_str;
+
+    DateToStr(&dt);
+    /* Drop the seconds, runs are stored to the minute */
+    time_str[5] = '\0';
+    snprintf(buffer, size, "%s %s", date_str, time_str);
+#else
+    snprintf(buffer, size, "Day %lu %02lu:%02lu", (unsigned long)entry->days,
+             (unsigned long)(entry->minutes / 60), (unsigned long)(entry->minutes % 60));
+#endif
+}
+
+/*
+ * Write one "current vs previous/best" comparison line
+ */
+static void write_history_delta(BPTR fh, const char *label, ULONG current,
+                                ULONG previous, ULONG best)
+{
+    char prev_str[12], best_str[12];
+
+    format_history_delta(prev_str, sizeof(prev_str), current, previous);
+    format_history_delta(best_str, sizeof(best_str), current, best);
+    write_formatted(fh, "  %-16s %-10s %s", label, prev_str, best_str);
+}
+
+/*
+ * Export stored benchmark runs and compare the current one with them
+ */
+void export_history(BPTR fh)
+{
+    const HistoryEntry *prev = history_get_previous();
+    const HistoryEntry *best = history_get_best();
+    ULONG count = history_count();
+    ULONG i, d;
+
+    WRITE_LINE(fh, "=== BENCHMARK HISTORY ===");
+    WRITE_LINE(fh, "");
+
+    if (count == 0) {
+        WRITE_LINE(fh, "No benchmark runs stored.");
+        WRITE_LINE(fh, "");
+        return;
+    }
+
+    WRITE_LINE(fh, "Date                CPU MHz  Dhrystones  MFLOPS  CHIP    FAST    ROM MB/s");
+    WRITE_LINE(fh, "------------------  -------  ----------  ------  ------  ------  ------");
+    for (i = 0; i < count; i++) {
+        const HistoryEntry *entry = history_get(i);
+        char date_str[32], mhz_str[16], mflops_str[16];
+        char chip_str[16], fast_str[16], rom_str[16];
+
+        format_history_date(date_str, sizeof(date_str), entry);
+        format_scaled(mhz_str, sizeof(mhz_str), entry->cpu_mhz, FALSE);
+        format_scaled(mflops_str, sizeof(mflops_str), entry->mflops, FALSE);
+        format_scaled(chip_str, sizeof(chip_str), entry->chip_speed / 10000, TRUE);
+        format_scaled(fast_str, sizeof(fast_str), entry->fast_speed / 10000, TRUE);
+        format_scaled(rom_str, sizeof(rom_str), entry->rom_speed / 10000, TRUE);
+
+        write_formatted(fh, "%-18s  %7s  %10lu  %6s  %-6s  %-6s  %s",
+                        date_str, mhz_str, (unsigned long)entry->dhrystones,
+                        mflops_str, chip_str, fast_str, rom_str);
+        for (d = 0; d < entry->drive_count; d++) {
+            char speed_str[16];
+            format_size(entry->drives[d].speed_bytes_sec, speed_str, sizeof(speed_str));
+            write_formatted(fh, "  %-16s %s/s", entry->drives[d].device_name, speed_str);
+        }
+    }
+    WRITE_LINE(fh, "");
+
+    if (!bench_results.benchmarks_valid || !prev || !best) {
+        return;
+    }
+
+    WRITE_LINE(fh, "Current run compared with:");
+    WRITE_LINE(fh, "                   Previous   Best");
+    write_history_delta(fh, "Dhrystones:", bench_results.dhrystones,
+                        prev->dhrystones, best->dhrystones);
+    if (hw_info.fpu_type != FPU_NONE) {
+        write_history_delta(fh, "MFLOPS:", bench_results.mflops,
+                            prev->mflops, best->mflops);
+    }
+    write_history_delta(fh, "Chip RAM read:", bench_results.chip_speed,
+                        prev->chip_speed, best->chip_speed);
+    write_history_delta(fh, "Fast RAM read:", bench_results.fast_speed,
+                        prev->fast_speed, best->fast_speed);
+    write_history_delta(fh, "ROM read:", bench_results.rom_speed,
+                        prev->rom_speed, best->rom_speed);
+
+    /* Drives measured both now and in the previous/best run */
+    for (i = 0; i < drive_list.count; i++) {
+        const DriveInfo *drive = &drive_list.drives[i];
+        ULONG prev_speed = 0, best_speed = 0;
+
+        if (!drive->speed_measured || drive->speed_bytes_sec == 0) continue;
+
+        for (d = 0; d < prev->drive_count; d++) {
+            if (strcmp(prev->drives[d].device_name, drive->device_name) == 0) {
+                prev_speed = prev->drives[d].speed_bytes_sec;
+            }
+        }
+        for (d = 0; d < best->drive_count; d++) {
+            if (strcmp(best->drives[d].device_name, drive->device_name) == 0) {
+                best_speed = best->drives[d].speed_bytes_sec;
+            }
+        }
+        if (prev_speed || best_speed) {
+            write_history_delta(fh, drive->device_name, drive->speed_bytes_sec,
+                                prev_speed, best_speed);
+        }
+    }
+
+    WRITE_LINE(fh, "");
+}
+
 /*
  * Export memory information
  */
@@ -407,6 +889,72 @@ void export_memory(BPTR fh)
         write_formatted(fh, "  Free:   %lu bytes", (unsigned long)r->amount_free);
         write_formatted(fh, "  Largest: %lu bytes", (unsigned long)r->largest_block);
         write_formatted(fh, "  Chunks: %lu", (unsigned long)r->num_chunks);
+        write_formatted(fh, "  Fragmentation: %lu%%", (unsigned long)r->fragmentation.index);
+        {
+            ULONG b;
+            WRITE_LINE(fh, "  Free chunks   Size   Count        Bytes         Fits");
+            for (b = 0; b < MEM_FRAG_BUCKETS; b++) {
+                ULONG size = mem_frag_bucket_size(b);
+                char bucket_str[16];
+
+                if (r->fragmentation.chunks[b] == 0) continue;
+                if (size >= 1024) {
+                    snprintf(bucket_str, sizeof(bucket_str), "%luK%s", (unsigned long)(size / 1024),
+                             b == MEM_FRAG_BUCKETS - 1 ? "+" : "");
+                } else {
+                    snprintf(bucket_str, sizeof(bucket_str), "%luB", (unsigned long)size);
+                }
+                write_formatted(fh, "              %5s  %6lu  %11lu  %11lu", bucket_str,
+                                (unsigned long)r->fragmentation.chunks[b],
+                                (unsigned long)r->fragmentation.bytes[b],
+                                (unsigned long)r->fragmentation.fits[b]);
+            }
+        }
+        if (r->speed_measured) {
+            write_formatted(fh, "  Speed:  read %lu, write %lu, copy %lu, byte copy %lu bytes/sec",
+                            (unsigned long)r->speed_bytes_sec,
+                            (unsigned long)r->write_bytes_sec,
+                            (unsigned long)r->copy_bytes_sec,
+                            (unsigned long)r->byte_copy_bytes_sec);
+        }
+        if (r->latency_measured) {
+            ULONG l;
+            for (l = 0; l < MEM_LATENCY_SIZES; l++) {
+                char lat_str[16];
+                if (r->latency_ns_x100[l] == 0) continue;
+                format_scaled(lat_str, sizeof(lat_str), r->latency_ns_x100[l], FALSE);
+                write_formatted(fh, "  Latency %4luK: %s ns/access",
+                                (unsigned long)(latency_sizes[l] / 1024), lat_str);
+            }
+        }
+        if (r->cache_sweep.valid) {
+            ULONG l, size;
+            write_formatted(fh, "  Cache sweep (ICache %s, DCache %s, IBurst %s, DBurst %s, CBack %s):",
+                            r->cache_sweep.icache ? "ON" : "OFF",
+                            r->cache_sweep.dcache ? "ON" : "OFF",
+                            r->cache_sweep.iburst ? "ON" : "OFF",
+                            r->cache_sweep.dburst ? "ON" : "OFF",
+                            r->cache_sweep.copyback ? "ON" : "OFF");
+            for (l = 0, size = CACHE_SWEEP_MIN_SIZE; l < CACHE_SWEEP_SIZES; l++, size <<= 1) {
+                if (r->cache_sweep.bytes_sec[l] == 0) continue;
+                write_formatted(fh, "    %8lu bytes: %lu bytes/sec",
+                                (unsigned long)size,
+                                (unsigned long)r->cache_sweep.bytes_sec[l]);
+            }
+        }
+        WRITE_LINE(fh, "");
+    }
+
+    if (dma_contention.measured) {
+        write_formatted(fh, "CHIP bandwidth under DMA (%s):",
+                        get_agnus_string(dma_contention.agnus));
+        write_formatted(fh, "  %-18s %12s %12s", "Display", "Read B/s", "Write B/s");
+        for (i = 0; i < DMA_CONFIGS; i++) {
+            if (dma_contention.read_bytes_sec[i] == 0) continue;
+            write_formatted(fh, "  %-18s %12lu %12lu", get_dma_config_name(i),
+                            (unsigned long)dma_contention.read_bytes_sec[i],
+                            (unsigned long)dma_contention.write_bytes_sec[i]);
+        }
         WRITE_LINE(fh, "");
     }
 }
@@ -442,6 +990,22 @@ void export_boards(BPTR fh)
                         (long)b->serial_number);
     }
 
+    /* Bandwidth of the boards measured in the boards view */
+    for (i = 0; i < board_list.count; i++) {
+        BoardInfo *b = &board_list.boards[i];
+        char read_str[16], write_str[16], lat_str[16];
+
+        if (!b->speed_measured || b->read_bytes_sec == 0) continue;
+
+        format_scaled(read_str, sizeof(read_str), b->read_bytes_sec / 10000, FALSE);
+        format_scaled(write_str, sizeof(write_str), b->write_bytes_sec / 10000, FALSE);
+        format_scaled(lat_str, sizeof(lat_str), b->latency_ns_x100, FALSE);
+        write_formatted(fh, "$%08lX   Read %s MB/s, Write %s MB/s, Latency %s ns%s",
+                        (unsigned long)b->board_address, read_str, write_str, lat_str,
+                        (b->board_type == BOARD_ZORRO_III &&
+                         b->read_bytes_sec < BOARD_Z2_PEAK_BYTES_SEC) ? " (Zorro II speed)" : "");
+    }
+
     WRITE_LINE(fh, "");
 }
 
@@ -480,11 +1044,126 @@ void export_drives(BPTR fh)
         if (d->speed_measured) {
             write_formatted(fh, "  Speed:       %lu bytes/sec", (unsigned long)d->speed_bytes_sec);
         }
+        if (d->queue_measured) {
+            ULONG q;
+            for (q = 0; q < DRIVE_QUEUE_DEPTHS; q++) {
+                write_formatted(fh, "  Queue depth %lu: %lu bytes/sec",
+                                (unsigned long)drive_queue_depths[q],
+                                (unsigned long)d->queue_bytes_sec[q]);
+            }
+        }
+        if (d->random_measured) {
+            ULONG r;
+            for (r = 0; r < DRIVE_RANDOM_SIZES; r++) {
+                write_formatted(fh, "  Random %lu:  %lu IOPS, avg %lu us, max %lu us",
+                                (unsigned long)drive_random_sizes[r],
+                                (unsigned long)d->random_iops[r],
+                                (unsigned long)d->random_avg_us[r],
+                                (unsigned long)d->random_max_us[r]);
+            }
+        }
+        if (d->matrix_measured) {
+            ULONG m;
+            write_formatted(fh, "  MaxTransfer: 0x%08lX  Mask: 0x%08lX",
+                            (unsigned long)d->max_transfer, (unsigned long)d->dma_mask);
+            WRITE_LINE(fh, "  Transfer matrix (bytes/sec, 0 = not tested):");
+            WRITE_LINE(fh, "       Size        Chip      Fast24      Fast32");
+            for (m = 0; m < DRIVE_MATRIX_SIZES; m++) {
+                write_formatted(fh, "    %7lu  %10lu  %10lu  %10lu",
+                                (unsigned long)(DRIVE_MATRIX_MIN_SIZE << m),
+                                (unsigned long)d->matrix_bytes_sec[DRIVE_BUF_CHIP][m],
+                                (unsigned long)d->matrix_bytes_sec[DRIVE_BUF_FAST24][m],
+                                (unsigned long)d->matrix_bytes_sec[DRIVE_BUF_FAST32][m]);
+            }
+        }
+        if (d->fs_measured) {
+            ULONG f;
+            WRITE_LINE(fh, "  Filesystem (bytes/sec):");
+            WRITE_LINE(fh, "     Buffer       Write        Read");
+            for (f = 0; f < DRIVE_FS_BUFFER_SIZES; f++) {
+                write_formatted(fh, "    %7lu  %10lu  %10lu",
+                                (unsigned long)(DRIVE_FS_MIN_BUFFER << (3 * f)),
+                                (unsigned long)d->fs_write_bytes_sec[f],
+                                (unsigned long)d->fs_read_bytes_sec[f]);
+            }
+            write_formatted(fh, "  Files:       %lu created/sec, %lu deleted/sec",
+                            (unsigned long)d->fs_creates_sec, (unsigned long)d->fs_deletes_sec);
+            write_formatted(fh, "  Dir scan:    ExNext %lu, ExAll %lu entries/sec",
+                            (unsigned long)d->fs_exnext_sec, (unsigned long)d->fs_exall_sec);
+            write_formatted(fh, "  Buffers:     %lu", (unsigned long)d->num_buffers);
+        }
 
         WRITE_LINE(fh, "");
     }
 }
 
+/*
+ * Export calibration and overhead of the harness kernels that ran
+ */
+void export_benchmark_harness(BPTR fh)
+{
+    ULONG count = harness_count();
+    ULONG i;
+
+    WRITE_LINE(fh, "=== BENCHMARK HARNESS ===");
+    WRITE_LINE(fh, "");
+
+    if (count == 0) {
+        WRITE_LINE(fh, "No benchmarks run.");
+        WRITE_LINE(fh, "");
+        return;
+    }
+
+    WRITE_LINE(fh, "Kernel               Iterations  Calib  Runs  Dropped  Overhead ns  Total ms");
+    WRITE_LINE(fh, "-------------------  ----------  -----  ----  -------  -----------  --------");
+    for (i = 0; i < count; i++) {
+        const BenchKernel *kernel = harness_get(i);
+
+        write_formatted(fh, "%-19s  %10lu  %5lu  %4lu  %7lu  %11lu  %8lu",
+                        kernel->name, (unsigned long)kernel->iterations,
+                        (unsigned long)kernel->attempts, (unsigned long)kernel->stats.runs,
+                        (unsigned long)kernel->stats.outliers,
+                        (unsigned long)kernel->overhead_ns,
+                        (unsigned long)(kernel->total_us / 1000));
+    }
+    write_formatted(fh, "Runs 0 = calibration only. From %lu runs on, results more than %lu%% off",
+                    (unsigned long)BENCH_OUTLIER_MIN_RUNS, (unsigned long)BENCH_OUTLIER_PERCENT);
+    WRITE_LINE(fh, "the median are dropped.");
+    WRITE_LINE(fh, "");
+}
+
+/*
+ * Export the startup phase timings
+ */
+void export_startup_profile(BPTR fh)
+{
+    ULONG count = profile_count();
+    ULONG i;
+
+    WRITE_LINE(fh, "=== STARTUP PROFILE ===");
+    WRITE_LINE(fh, "");
+
+    if (count == 0) {
+        WRITE_LINE(fh, "No phases recorded.");
+        WRITE_LINE(fh, "");
+        return;
+    }
+
+    WRITE_LINE(fh, "  Start ms  Phase                               Time us");
+    WRITE_LINE(fh, "  --------  ----------------------------------  ----------");
+    for (i = 0; i < count; i++) {
+        const ProfilePhase *phase = profile_get(i);
+        char name[40];
+
+        /* Nested phases are indented below their parent */
+        snprintf(name, sizeof(name), "%*s%s", (int)(phase->depth * 2), "", phase->name);
+        write_formatted(fh, "  %8lu  %-34s  %10lu",
+                        (unsigned long)(phase->start_us / 1000), name,
+                        (unsigned long)phase->elapsed_us);
+    }
+    WRITE_LINE(fh, "");
+}
+
 /*
  * Export all information to file
  */
@@ -497,13 +1176,24 @@ BOOL export_to_file(const char *filename)
         return FALSE;
     }
 
+    /* The report covers everything, not just the views visited so far */
+    ensure_enumerated(ENUM_ALL);
+
     export_header(fh);
     export_hardware(fh);
     export_software(fh);
     export_benchmarks(fh);
+    export_history(fh);
+    export_microbench(fh);
+    export_cache_matrix(fh);
+    export_blitter_bench(fh);
+    export_latency_bench(fh);
+    export_gfx_bench(fh);
     export_memory(fh);
     export_boards(fh);
     export_drives(fh);
+    export_benchmark_harness(fh);
+    export_startup_profile(fh);
 
     WRITE_LINE(fh, "================================================================================");
     WRITE_LINE(fh, "                          End of " XSYSINFO_NAME " Report");
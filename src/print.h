@@ -24,8 +24,16 @@ void export_header(BPTR fh);
 void export_hardware(BPTR fh);
 void export_software(BPTR fh);
 void export_benchmarks(BPTR fh);
+void export_history(BPTR fh);
+void export_microbench(BPTR fh);
+void export_cache_matrix(BPTR fh);
+void export_blitter_bench(BPTR fh);
+void export_latency_bench(BPTR fh);
+void export_gfx_bench(BPTR fh);
 void export_memory(BPTR fh);
 void export_boards(BPTR fh);
 void export_drives(BPTR fh);
+void export_benchmark_harness(BPTR fh);
+void export_startup_profile(BPTR fh);
 
 #endif /* PRINT_H */
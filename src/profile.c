@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Startup phase profiler
+ *
+ * Detection and enumeration phases are stamped with the EClock so
+ * slow probes on a particular configuration show up in the debug
+ * output and in the exported report.
+ */
+
+#include <string.h>
+
+#include <proto/exec.h>
+
+#include "xsysinfo.h"
+#include "profile.h"
+#include "benchmark.h"
+#include "debug.h"
+
+static ProfilePhase phases[PROFILE_MAX_PHASES];
+static ULONG phase_count = 0;
+static UWORD phase_depth = 0;
+static struct EClockVal zero_time;
+static ULONG eclock_freq = 0;
+static BOOL profile_running = FALSE;
+
+/*
+ * Set time zero, call once the benchmark timer is open
+ */
+void profile_init(void)
+{
+    if (!benchmark_timer_available()) return;
+
+    eclock_freq = read_benchmark_clock(&zero_time);
+    phase_count = 0;
+    phase_depth = 0;
+    profile_running = TRUE;
+}
+
+/*
+ * Start timing a phase
+ */
+void profile_start(ProfileTimer *timer, const char *name)
+{
+    timer->name = name;
+    timer->index = PROFILE_MAX_PHASES;
+
+    if (!profile_running) return;
+
+    read_benchmark_clock(&timer->start);
+
+    /* Slot is taken at start so nested phases list after their parent */
+    if (phase_count < PROFILE_MAX_PHASES) {
+        timer->index = phase_count++;
+        phases[timer->index].name = name;
+        phases[timer->index].start_us = EClock_Diff_in_ms(&zero_time, &timer->start, eclock_freq);
+        phases[timer->index].elapsed_us = 0;
+        phases[timer->index].depth = phase_depth;
+    }
+    phase_depth++;
+}
+
+/*
+ * Stop timing a phase and record it
+ */
+void profile_stop(ProfileTimer *timer)
+{
+    struct EClockVal end;
+    ULONG start_us, elapsed_us;
+
+    if (!profile_running) return;
+
+    read_benchmark_clock(&end);
+    start_us = EClock_Diff_in_ms(&zero_time, &timer->start, eclock_freq);
+    elapsed_us = EClock_Diff_in_ms(&timer->start, &end, eclock_freq);
+    if (phase_depth > 0) phase_depth--;
+
+    if (timer->index < PROFILE_MAX_PHASES) {
+        phases[timer->index].elapsed_us = elapsed_us;
+    }
+
+    debug("  profile: [%6lu ms] %s took %lu us\n",
+          start_us / 1000, (LONG)timer->name, elapsed_us);
+}
+
+ULONG profile_count(void)
+{
+    return phase_count;
+}
+
+const ProfilePhase *profile_get(ULONG index)
+{
+    return index < phase_count ? &phases[index] : NULL;
+}
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Startup phase profiler header
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <devices/timer.h>
+
+#include "xsysinfo.h"
+
+/* Recorded phases, later ones are only shown in the debug output */
+#define PROFILE_MAX_PHASES  48
+
+/* One timed phase */
+typedef struct {
+    const char *name;       /* Static string */
+    ULONG start_us;         /* Since profile_init() */
+    ULONG elapsed_us;
+    UWORD depth;            /* Nesting level */
+} ProfilePhase;
+
+/* Phase timer, lives on the stack of the timed code */
+typedef struct {
+    struct EClockVal start;
+    const char *name;
+    ULONG index;            /* Slot in the phase table */
+} ProfileTimer;
+
+/* Time a statement as one phase:
+ *     PROFILE_PHASE("detect_cpu", detect_cpu());
+ */
+#define PROFILE_PHASE(name, statement) \
+    do { \
+        ProfileTimer profile_timer_; \
+        profile_start(&profile_timer_, name); \
+        statement; \
+        profile_stop(&profile_timer_); \
+    } while (0)
+
+/* Set time zero, call once the benchmark timer is open */
+void profile_init(void);
+
+/* Scoped phase timer */
+void profile_start(ProfileTimer *timer, const char *name);
+void profile_stop(ProfileTimer *timer);
+
+/* Recorded phases */
+ULONG profile_count(void);
+const ProfilePhase *profile_get(ULONG index);
+
+#endif /* PROFILE_H */
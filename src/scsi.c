@@ -12,6 +12,7 @@
 #include <exec/memory.h>
 #include <exec/io.h>
 #include <exec/errors.h>
+#include <exec/tasks.h>
 #include <devices/scsidisk.h>
 #include <devices/trackdisk.h>
 #include <devices/newstyle.h>
@@ -27,6 +28,9 @@
 
 #include "xsysinfo.h"
 #include "scsi.h"
+#include "inventory.h"
+#include "benchmark.h"
+#include "pool.h"
 #include "gui.h"
 #include "locale_str.h"
 #include "debug.h"
@@ -34,6 +38,9 @@
 /* Global SCSI device list */
 ScsiDeviceList scsi_device_list;
 
+/* Blocks per READ(10) command for each read_bytes_sec entry */
+const UWORD scsi_read_blocks[SCSI_READ_SIZES] = { 1, 8, 64, SCSI_READ_MAX_BLOCKS };
+
 /* External references */
 extern AppContext *app;
 extern Button buttons[];
@@ -58,6 +65,17 @@ struct SCSICapacityData {
     ULONG block_size;           /* Block size in bytes */
 };
 
+/* One target/LUN probed by its own task during the bus scan */
+typedef struct {
+    struct Task *parent;        /* Task waiting for the probe */
+    ULONG done_mask;            /* Signal sent to parent when finished */
+    volatile BOOL finished;
+    int target;
+    int lun;
+    BOOL present;               /* Device answered INQUIRY */
+    struct SCSIInquiryData inquiry;
+} ScsiProbe;
+
 /*
  * Calculate unit number for wide SCSI controllers
  * Phase V wide SCSI scheme for IDs/LUNs > 7
@@ -142,6 +160,28 @@ static ScsiAnsiVersion convert_ansi_version(UBYTE version)
 }
 
 
+/*
+ * The device array is kept for the next scan
+ */
+void scsi_list_reset(ScsiDeviceList *list, const char *device_name)
+{
+    list->count = 0;
+    list->device_name = pool_string(device_name);
+}
+
+ScsiDeviceInfo *scsi_list_add(ScsiDeviceList *list)
+{
+    ScsiDeviceInfo *devices;
+
+    devices = pool_grow(list->devices, &list->capacity, list->count + 1,
+                        sizeof(ScsiDeviceInfo));
+    if (!devices) return NULL;
+    list->devices = devices;
+
+    memset(&devices[list->count], 0, sizeof(ScsiDeviceInfo));
+    return &devices[list->count++];
+}
+
 /*
  * Check if a device supports SCSI direct commands
  * Returns TRUE if the device responds to HD_SCSICMD or NSCMD_TD_SCSI
@@ -221,48 +261,21 @@ BOOL check_scsi_direct_support(const char *handler_name, ULONG unit_number)
 }
 
 /*
- * Send SCSI INQUIRY command to a device
+ * Send SCSI INQUIRY command on an opened unit
  */
-static BOOL scsi_inquiry(int target, int lun,
+static BOOL scsi_inquiry(struct IOStdReq *io, int lun,
                          struct SCSIInquiryData *inquiry_data)
 {
-    struct IOStdReq *io;
-    struct MsgPort *mp;
     struct SCSICmd scsi_cmd;
     UBYTE cmd[6];
     UBYTE sense_data[20];
     BYTE error;
-    ULONG unit;
 
     memset(&scsi_cmd, 0, sizeof(scsi_cmd));
     memset(cmd, 0, sizeof(cmd));
     memset(sense_data, 0, sizeof(sense_data));
     memset(inquiry_data, 0, sizeof(struct SCSIInquiryData));
 
-
-    if ((mp = (struct MsgPort *)CreatePort(NULL, 0)) == NULL) return FALSE;
-
-    if ((io = (struct IOStdReq *)CreateExtIO(mp, sizeof(struct IOStdReq))) == NULL) {
-        DeletePort(mp);
-        return FALSE;
-    }
-
-    /* Calculate unit number for this target/LUN */
-    unit = calculate_unit_number(target, lun);
-
-    error = OpenDevice((CONST_STRPTR)scsi_device_list.device_name, unit,
-                       (struct IORequest *)io, 0);
-    if (error != 0) {
-        /* Try opening with unit 0 and addressing via command */
-        error = OpenDevice((CONST_STRPTR)scsi_device_list.device_name, 0,
-                           (struct IORequest *)io, 0);
-        if (error != 0) {
-            DeleteExtIO((struct IORequest *)io);
-            DeletePort(mp);
-            return FALSE;
-        }
-    }
-
     /* SCSI INQUIRY command */
     cmd[0] = 0x12;              /* INQUIRY opcode */
     cmd[1] = (lun << 5);        /* LUN in command for older devices */
@@ -285,10 +298,6 @@ static BOOL scsi_inquiry(int target, int lun,
 
     error = DoIO((struct IORequest *)io);
 
-    CloseDevice((struct IORequest *)io);
-    DeleteExtIO((struct IORequest *)io);
-    DeletePort(mp);
-
     if (error != 0 || scsi_cmd.scsi_Status != 0) {
         return FALSE;
     }
@@ -296,6 +305,115 @@ static BOOL scsi_inquiry(int target, int lun,
     return TRUE;
 }
 
+/*
+ * Probe one target/LUN: open the unit and send INQUIRY.
+ * Runs on a probe task, so no DOS calls (debug output) in here
+ */
+static void probe_scsi_unit(ScsiProbe *probe)
+{
+    struct MsgPort *mp;
+    struct IOStdReq *io;
+    ULONG unit;
+
+    probe->present = FALSE;
+
+    if ((mp = (struct MsgPort *)CreatePort(NULL, 0)) == NULL) return;
+
+    if ((io = (struct IOStdReq *)CreateExtIO(mp, sizeof(struct IOStdReq))) == NULL) {
+        DeletePort(mp);
+        return;
+    }
+
+    /* Missing targets cost a selection timeout here or in the INQUIRY */
+    unit = calculate_unit_number(probe->target, probe->lun);
+    if (OpenDevice((CONST_STRPTR)scsi_device_list.device_name, unit,
+                   (struct IORequest *)io, 0) == 0) {
+        if (scsi_inquiry(io, probe->lun, &probe->inquiry)) {
+            UBYTE type = probe->inquiry.device_type;
+
+            /* 0x7F = no device; peripheral qualifier != 0 = LUN not connected */
+            probe->present = ((type & 0x1F) != 0x1F) && ((type & 0xE0) == 0);
+        }
+        CloseDevice((struct IORequest *)io);
+    }
+
+    DeleteExtIO((struct IORequest *)io);
+    DeletePort(mp);
+}
+
+/*
+ * Probe task entry: the ScsiProbe is passed in tc_UserData
+ */
+static void scsi_probe_task(void)
+{
+    struct Task *self = FindTask(NULL);
+    ScsiProbe *probe = (ScsiProbe *)self->tc_UserData;
+
+    probe_scsi_unit(probe);
+
+    /* Stay in Forbid() until the task is gone, the parent frees the probes */
+    Forbid();
+    probe->finished = TRUE;
+    Signal(probe->parent, probe->done_mask);
+}
+
+/*
+ * Run a batch of probes concurrently, one task each, and wait until all
+ * of them are done. Probes whose task cannot be created run inline
+ */
+static void run_scsi_probes(ScsiProbe *probes, int count)
+{
+    struct Task *self = FindTask(NULL);
+    BYTE signal;
+    ULONG mask;
+    BOOL done;
+    int i;
+
+    signal = AllocSignal(-1);
+    if (signal == -1) {
+        for (i = 0; i < count; i++) {
+            probe_scsi_unit(&probes[i]);
+        }
+        return;
+    }
+    mask = 1UL << signal;
+
+    for (i = 0; i < count; i++) {
+        struct Task *task;
+
+        probes[i].parent = self;
+        probes[i].done_mask = mask;
+        probes[i].finished = FALSE;
+
+        /* Hold off the task until it can find its probe */
+        Forbid();
+        task = CreateTask((STRPTR)"xSysInfo SCSI probe", self->tc_Node.ln_Pri,
+                          (APTR)scsi_probe_task, SCSI_PROBE_STACK);
+        if (task) {
+            task->tc_UserData = &probes[i];
+        }
+        Permit();
+
+        if (!task) {
+            probe_scsi_unit(&probes[i]);
+            probes[i].finished = TRUE;
+        }
+    }
+
+    for (;;) {
+        done = TRUE;
+        Forbid();
+        for (i = 0; i < count; i++) {
+            if (!probes[i].finished) done = FALSE;
+        }
+        Permit();
+        if (done) break;
+        Wait(mask);
+    }
+
+    FreeSignal(signal);
+}
+
 /*
  * Send SCSI READ CAPACITY command to a device
  */
@@ -371,6 +489,111 @@ static BOOL scsi_read_capacity(int target, int lun,
     return TRUE;
 }
 
+/*
+ * Open the unit of a target/LUN on the current controller
+ */
+static struct IOStdReq *open_scsi_unit(int target, int lun)
+{
+    struct MsgPort *mp;
+    struct IOStdReq *io;
+
+    if ((mp = (struct MsgPort *)CreatePort(NULL, 0)) == NULL) return NULL;
+
+    if ((io = (struct IOStdReq *)CreateExtIO(mp, sizeof(struct IOStdReq))) == NULL) {
+        DeletePort(mp);
+        return NULL;
+    }
+
+    if (OpenDevice((CONST_STRPTR)scsi_device_list.device_name,
+                   calculate_unit_number(target, lun),
+                   (struct IORequest *)io, 0) != 0) {
+        DeleteExtIO((struct IORequest *)io);
+        DeletePort(mp);
+        return NULL;
+    }
+
+    return io;
+}
+
+static void close_scsi_unit(struct IOStdReq *io)
+{
+    struct MsgPort *mp = io->io_Message.mn_ReplyPort;
+
+    CloseDevice((struct IORequest *)io);
+    DeleteExtIO((struct IORequest *)io);
+    DeletePort(mp);
+}
+
+/*
+ * Read the caching mode page (8) with MODE SENSE(6).
+ * Returns SCSI_CACHE_* flags, 0 if the drive does not report the page
+ */
+static UBYTE scsi_mode_sense_caching(int target, int lun)
+{
+    struct IOStdReq *io;
+    struct SCSICmd scsi_cmd;
+    UBYTE cmd[6];
+    UBYTE sense_data[20];
+    UBYTE data[36];
+    UBYTE *page;
+    UBYTE flags = 0;
+    ULONG actual;
+    BYTE error;
+
+    io = open_scsi_unit(target, lun);
+    if (!io) return 0;
+
+    memset(&scsi_cmd, 0, sizeof(scsi_cmd));
+    memset(cmd, 0, sizeof(cmd));
+    memset(sense_data, 0, sizeof(sense_data));
+    memset(data, 0, sizeof(data));
+
+    /* SCSI MODE SENSE(6) command, current values */
+    cmd[0] = 0x1A;              /* MODE SENSE(6) opcode */
+    cmd[1] = (lun << 5) | 0x08; /* LUN, DBD: no block descriptors */
+    cmd[2] = 0x08;              /* Caching page */
+    cmd[4] = sizeof(data);      /* Allocation length */
+
+    scsi_cmd.scsi_Data = (UWORD *)data;
+    scsi_cmd.scsi_Length = sizeof(data);
+    scsi_cmd.scsi_Command = cmd;
+    scsi_cmd.scsi_CmdLength = 6;
+    scsi_cmd.scsi_Flags = SCSIF_READ | SCSIF_AUTOSENSE;
+    scsi_cmd.scsi_SenseData = sense_data;
+    scsi_cmd.scsi_SenseLength = sizeof(sense_data);
+
+    io->io_Command = HD_SCSICMD;
+    io->io_Data = &scsi_cmd;
+    io->io_Length = sizeof(struct SCSICmd);
+
+    error = DoIO((struct IORequest *)io);
+
+    close_scsi_unit(io);
+
+    if (error != 0 || scsi_cmd.scsi_Status != 0) {
+        return 0;
+    }
+
+    /* Not every driver sets scsi_Actual, the page code check catches that */
+    actual = scsi_cmd.scsi_Actual ? scsi_cmd.scsi_Actual : sizeof(data);
+
+    /* 4 byte header, then block descriptors (DBD is only a hint) */
+    if (4 + (ULONG)data[3] + 3 > actual) return 0;
+    page = data + 4 + data[3];
+    if ((page[0] & 0x3F) != 0x08) return 0;
+
+    flags = SCSI_CACHE_KNOWN;
+    if (!(page[2] & 0x01)) flags |= SCSI_CACHE_READ;    /* RCD */
+    if (page[2] & 0x04) flags |= SCSI_CACHE_WRITE;      /* WCE */
+
+    /* DRA came with SCSI-3, older pages are only 10 bytes long */
+    if (page[1] >= 11 && (ULONG)(page - data) + 13 <= actual) {
+        if (!(page[12] & 0x20)) flags |= SCSI_CACHE_READ_AHEAD;
+    }
+
+    return flags;
+}
+
 /*
  * Trim trailing spaces from a string
  */
@@ -383,121 +606,272 @@ static void trim_trailing_spaces(char *str)
 }
 
 /*
- * Scan all SCSI devices on a controller
+ * Add a device found by a probe to the device list
  */
-void scan_scsi_devices(const char *handler_name, ULONG base_unit)
+static void add_scsi_device(const ScsiProbe *probe)
 {
-    struct MsgPort *port = NULL;
-    struct IOStdReq *io = NULL;
-    struct SCSIInquiryData inquiry_data;
     struct SCSICapacityData capacity_data;
+    ScsiDeviceInfo *dev;
+
+    dev = scsi_list_add(&scsi_device_list);
+    if (!dev) return;
+
+    dev->target_id = probe->target;
+    dev->lun = probe->lun;
+    dev->device_type = convert_device_type(probe->inquiry.device_type);
+    dev->ansi_version = convert_ansi_version(probe->inquiry.ansi_version);
+
+    /* Copy and trim strings */
+    memcpy(dev->manufacturer, probe->inquiry.vendor, 8);
+    dev->manufacturer[8] = '\0';
+    trim_trailing_spaces(dev->manufacturer);
+
+    memcpy(dev->model, probe->inquiry.product, 16);
+    dev->model[16] = '\0';
+    trim_trailing_spaces(dev->model);
+
+    memcpy(dev->revision, probe->inquiry.revision, 4);
+    dev->revision[4] = '\0';
+    trim_trailing_spaces(dev->revision);
+
+    /* Try to get capacity info */
+    if (scsi_read_capacity(probe->target, probe->lun, &capacity_data)) {
+        dev->max_blocks = capacity_data.last_block;
+        dev->block_size = capacity_data.block_size;
+
+        if (dev->block_size > 0) {
+            /* Calculate sizes in MB */
+            ULONG total_blocks = capacity_data.last_block + 1;
+            ULONG size_kb = (total_blocks / 1024) * dev->block_size +
+                            ((total_blocks % 1024) * dev->block_size) / 1024;
+            dev->real_size_mb = size_kb / 1024;
+            dev->format_size_mb = dev->real_size_mb;  /* Simplified */
+        }
+    } else {
+        dev->max_blocks = 0;
+        dev->block_size = 0;
+        dev->real_size_mb = 0;
+        dev->format_size_mb = 0;
+    }
+
+    /* Random access devices have a caching page */
+    if (dev->device_type == SCSI_TYPE_DISK || dev->device_type == SCSI_TYPE_OPTICAL ||
+        dev->device_type == SCSI_TYPE_WORM || dev->device_type == SCSI_TYPE_CDROM) {
+        dev->cache_flags = scsi_mode_sense_caching(probe->target, probe->lun);
+    }
+
+    dev->is_valid = TRUE;
+
+    debug("  scsi: Found device ID %d LUN %d: %s %s\n",
+          (LONG)probe->target, (LONG)probe->lun,
+          (LONG)dev->manufacturer, (LONG)dev->model);
+}
+
+/*
+ * Scan all SCSI devices on a controller.
+ * All targets are probed at once so a sparse bus costs about one
+ * selection timeout, then the remaining LUNs of every target that
+ * answered are probed the same way
+ */
+void scan_scsi_devices(const char *handler_name, ULONG base_unit, BOOL force_probe)
+{
+    ScsiProbe *probes;
+    ScsiProbe *targets;
+    ScsiProbe *luns;
     int target, lun;
-    BYTE error;
+    int num_luns = 0;
 
     (void)base_unit;  /* Not used in current implementation */
 
-    memset(&scsi_device_list, 0, sizeof(scsi_device_list));
-    strncpy(scsi_device_list.device_name, handler_name,
-            sizeof(scsi_device_list.device_name) - 1);
+    if (!force_probe && inventory_get_scsi_list(handler_name, &scsi_device_list)) {
+        return;
+    }
+
+    scsi_list_reset(&scsi_device_list, handler_name);
 
     debug("  scsi: Scanning SCSI devices on %s\n", (LONG)handler_name);
 
-    /* Create message port */
-    port = (struct MsgPort *)CreatePort(NULL, 0);
-    if (!port) {
-        debug("  scsi: Failed to create message port\n");
+    /* One probe per target for LUN 0, then room for LUNs 1-7 of each */
+    probes = (ScsiProbe *)AllocMem(sizeof(ScsiProbe) * SCSI_MAX_TARGETS * SCSI_MAX_LUNS,
+                                   MEMF_CLEAR);
+    if (!probes) {
+        debug("  scsi: Failed to allocate probes\n");
         return;
     }
+    targets = probes;
+    luns = probes + SCSI_MAX_TARGETS;
 
-    /* Create I/O request */
-    io = (struct IOStdReq *)CreateExtIO(port, sizeof(struct IOStdReq));
-    if (!io) {
-        debug("  scsi: Failed to create IO request\n");
-        DeletePort(port);
-        return;
+    /* Scan all possible SCSI IDs (0-15 for wide SCSI) */
+    for (target = 0; target < SCSI_MAX_TARGETS; target++) {
+        targets[target].target = target;
+        targets[target].lun = 0;
+    }
+    run_scsi_probes(targets, SCSI_MAX_TARGETS);
+
+    /* Only targets that answered can have further LUNs */
+    for (target = 0; target < SCSI_MAX_TARGETS; target++) {
+        if (!targets[target].present) continue;
+        for (lun = 1; lun < SCSI_MAX_LUNS; lun++) {
+            luns[num_luns].target = target;
+            luns[num_luns].lun = lun;
+            num_luns++;
+        }
+    }
+    if (num_luns > 0) {
+        run_scsi_probes(luns, num_luns);
     }
 
-    /* Scan all possible SCSI IDs (0-15 for wide SCSI) */
-    for (target = 0; target < 16; target++) {
-        /* For now just check LUN 0 */
-        for (lun = 0; lun < 1; lun++) {
-            ULONG unit = calculate_unit_number(target, lun);
-
-            /* Open device with this unit */
-            error = OpenDevice((CONST_STRPTR)handler_name, unit,
-                               (struct IORequest *)io, 0);
-            if (error != 0) {
-                continue;
+    /* List in target/LUN order */
+    for (target = 0; target < SCSI_MAX_TARGETS; target++) {
+        if (!targets[target].present) continue;
+        add_scsi_device(&targets[target]);
+        for (lun = 0; lun < num_luns; lun++) {
+            if (luns[lun].target == target && luns[lun].present) {
+                add_scsi_device(&luns[lun]);
             }
+        }
+    }
 
-            /* Try INQUIRY command */
-            if (scsi_inquiry(target, lun, &inquiry_data)) {
-                /* Check if device is present (not 0x7F = no device) */
-                if ((inquiry_data.device_type & 0x1F) != 0x1F) {
-                    ScsiDeviceInfo *dev = &scsi_device_list.devices[scsi_device_list.count];
-
-                    dev->target_id = target;
-                    dev->lun = lun;
-                    dev->device_type = convert_device_type(inquiry_data.device_type);
-                    dev->ansi_version = convert_ansi_version(inquiry_data.ansi_version);
-
-                    /* Copy and trim strings */
-                    memcpy(dev->manufacturer, inquiry_data.vendor, 8);
-                    dev->manufacturer[8] = '\0';
-                    trim_trailing_spaces(dev->manufacturer);
-
-                    memcpy(dev->model, inquiry_data.product, 16);
-                    dev->model[16] = '\0';
-                    trim_trailing_spaces(dev->model);
-
-                    memcpy(dev->revision, inquiry_data.revision, 4);
-                    dev->revision[4] = '\0';
-                    trim_trailing_spaces(dev->revision);
-
-                    /* Try to get capacity info */
-                    if (scsi_read_capacity(target, lun, &capacity_data)) {
-                        dev->max_blocks = capacity_data.last_block;
-                        dev->block_size = capacity_data.block_size;
-
-                        if (dev->block_size > 0) {
-                            /* Calculate sizes in MB */
-                            ULONG total_blocks = capacity_data.last_block + 1;
-                            ULONG size_kb = (total_blocks / 1024) * dev->block_size +
-                                            ((total_blocks % 1024) * dev->block_size) / 1024;
-                            dev->real_size_mb = size_kb / 1024;
-                            dev->format_size_mb = dev->real_size_mb;  /* Simplified */
-                        }
-                    } else {
-                        dev->max_blocks = 0;
-                        dev->block_size = 0;
-                        dev->real_size_mb = 0;
-                        dev->format_size_mb = 0;
-                    }
-
-                    dev->is_valid = TRUE;
-                    scsi_device_list.count++;
-
-                    debug("  scsi: Found device ID %d: %s %s\n",
-                          (LONG)target, (LONG)dev->manufacturer, (LONG)dev->model);
-
-                    if (scsi_device_list.count >= MAX_SCSI_DEVICES) {
-                        break;
-                    }
-                }
-            }
+    FreeMem(probes, sizeof(ScsiProbe) * SCSI_MAX_TARGETS * SCSI_MAX_LUNS);
+
+    inventory_set_scsi_list(handler_name, &scsi_device_list);
+    inventory_save();
+
+    debug("  scsi: Scan complete, found %d devices\n", (LONG)scsi_device_list.count);
+}
 
-            CloseDevice((struct IORequest *)io);
+/*
+ * Time READ(10) commands of each block count on one device, reading
+ * on from block 0. HD_SCSICMD goes straight to the controller, so
+ * unlike CMD_READ this skips the driver's block translation
+ */
+static void measure_scsi_device(ScsiDeviceInfo *dev)
+{
+    struct IOStdReq *io;
+    struct SCSICmd scsi_cmd;
+    UBYTE cmd[10];
+    UBYTE sense_data[20];
+    APTR buffer;
+    ULONG buffer_size;
+    ULONG E_Freq;
+    struct EClockVal start, end;
+    uint64_t elapsed;
+    ULONG s, i;
+    BYTE error = 0;
+
+    for (s = 0; s < SCSI_READ_SIZES; s++) {
+        dev->read_bytes_sec[s] = 0;
+    }
+    dev->speed_measured = FALSE;
+
+    if (dev->block_size == 0 || dev->block_size > SCSI_READ_MAX_BLOCK_SIZE ||
+        dev->max_blocks < SCSI_READ_MAX_BLOCKS) {
+        return;
+    }
+
+    buffer_size = SCSI_READ_MAX_BLOCKS * dev->block_size;
+    buffer = AllocMem(buffer_size, MEMF_FAST | MEMF_CLEAR);
+    if (!buffer) {
+        buffer = AllocMem(buffer_size, MEMF_ANY | MEMF_CLEAR);
+    }
+    if (!buffer) return;
+
+    io = open_scsi_unit(dev->target_id, dev->lun);
+    if (!io) {
+        FreeMem(buffer, buffer_size);
+        return;
+    }
+
+    for (s = 0; s < SCSI_READ_SIZES; s++) {
+        ULONG blocks = scsi_read_blocks[s];
+        ULONG length = blocks * dev->block_size;
+        ULONG num_cmds = SCSI_READ_BYTES / length;
+        ULONG lba = 0;
+        ULONG total_read = 0;
+
+        if (num_cmds < SCSI_READ_MIN_CMDS) num_cmds = SCSI_READ_MIN_CMDS;
+
+        E_Freq = read_benchmark_clock(&start);
+        for (i = 0; i < num_cmds; i++) {
+            /* Wrap around on small media */
+            if (lba + blocks > dev->max_blocks + 1) lba = 0;
+
+            memset(&scsi_cmd, 0, sizeof(scsi_cmd));
+            memset(cmd, 0, sizeof(cmd));
+
+            /* SCSI READ(10) command */
+            cmd[0] = 0x28;              /* READ(10) opcode */
+            cmd[1] = (dev->lun << 5);   /* LUN */
+            cmd[2] = (UBYTE)(lba >> 24);
+            cmd[3] = (UBYTE)(lba >> 16);
+            cmd[4] = (UBYTE)(lba >> 8);
+            cmd[5] = (UBYTE)lba;
+            cmd[7] = (UBYTE)(blocks >> 8);
+            cmd[8] = (UBYTE)blocks;
+
+            scsi_cmd.scsi_Data = (UWORD *)buffer;
+            scsi_cmd.scsi_Length = length;
+            scsi_cmd.scsi_Command = cmd;
+            scsi_cmd.scsi_CmdLength = 10;
+            scsi_cmd.scsi_Flags = SCSIF_READ | SCSIF_AUTOSENSE;
+            scsi_cmd.scsi_SenseData = sense_data;
+            scsi_cmd.scsi_SenseLength = sizeof(sense_data);
+
+            io->io_Command = HD_SCSICMD;
+            io->io_Data = &scsi_cmd;
+            io->io_Length = sizeof(struct SCSICmd);
+
+            error = DoIO((struct IORequest *)io);
+            if (error != 0 || scsi_cmd.scsi_Status != 0) {
+                break;
+            }
+            /* Not every driver sets scsi_Actual */
+            total_read += scsi_cmd.scsi_Actual ? scsi_cmd.scsi_Actual : length;
+            lba += blocks;
         }
+        E_Freq = read_benchmark_clock(&end);
+        elapsed = EClock_Diff_in_ms(&start, &end, E_Freq);
 
-        if (scsi_device_list.count >= MAX_SCSI_DEVICES) {
+        if (i < num_cmds) {
+            debug("  scsi: READ(10) of %lu blocks failed on ID %ld (error %ld, status %ld)\n",
+                  (unsigned long)blocks, (LONG)dev->target_id,
+                  (LONG)error, (LONG)scsi_cmd.scsi_Status);
             break;
         }
+        if (elapsed > 0) {
+            dev->read_bytes_sec[s] = (ULONG)(((uint64_t)total_read * 1000000ULL) / elapsed);
+        }
+
+        debug("  scsi: ID %ld READ(10) %lu blocks: %lu bytes/sec\n",
+              (LONG)dev->target_id, (unsigned long)blocks,
+              (unsigned long)dev->read_bytes_sec[s]);
     }
 
-    DeleteExtIO((struct IORequest *)io);
-    DeletePort(port);
+    close_scsi_unit(io);
+    FreeMem(buffer, buffer_size);
 
-    debug("  scsi: Scan complete, found %d devices\n", (LONG)scsi_device_list.count);
+    dev->speed_measured = TRUE;
+}
+
+/*
+ * Time READ(10) on every disk-like device of the current list
+ */
+void measure_scsi_speed(void)
+{
+    ULONG i;
+
+    if (!benchmark_timer_available()) return;
+
+    for (i = 0; i < scsi_device_list.count; i++) {
+        ScsiDeviceInfo *dev = &scsi_device_list.devices[i];
+
+        if (!dev->is_valid) continue;
+        if (dev->device_type != SCSI_TYPE_DISK && dev->device_type != SCSI_TYPE_OPTICAL &&
+            dev->device_type != SCSI_TYPE_WORM && dev->device_type != SCSI_TYPE_CDROM) {
+            continue;
+        }
+        measure_scsi_device(dev);
+    }
 }
 
 /*
@@ -512,6 +886,98 @@ static void format_size_mb(ULONG size_mb, char *buffer, ULONG bufsize)
     }
 }
 
+/*
+ * Cache flag as ON/OFF, N/A if the drive did not return the page
+ */
+static const char *cache_state(UBYTE flags, UBYTE flag)
+{
+    if (!(flags & SCSI_CACHE_KNOWN)) return get_string(MSG_NA);
+    return get_string((flags & flag) ? MSG_ON : MSG_OFF);
+}
+
+static void draw_scsi_buttons(void)
+{
+    Button *btn;
+
+    btn = find_button(BTN_SCSI_EXIT);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_SCSI_REFRESH);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_SCSI_SPEED);
+    if (btn) draw_button(btn);
+}
+
+/*
+ * Draw drive caches and READ(10) speed per device
+ */
+static void draw_scsi_speed_view(void)
+{
+    static const WORD columns[SCSI_READ_SIZES] = { 316, 392, 468, 544 };
+    struct RastPort *rp = app->rp;
+    char buffer[64];
+    WORD y;
+    ULONG i, s;
+
+    SetAPen(rp, COLOR_BACKGROUND);
+    RectFill(rp, 0, 0, SCREEN_WIDTH - 1, app->screen_height - 1);
+
+    draw_panel(20, 0, 600, 24, NULL);
+    draw_text_centered(20, 14, 600, get_string(MSG_SCSI_SPEED_TITLE), COLOR_TEXT);
+
+    /* Column headers */
+    draw_panel(20, 28, 600, 16, NULL);
+    y = 40;
+    draw_text(28, y, get_string(MSG_SCSI_ID), COLOR_TEXT);
+    draw_text(56, y, get_string(MSG_SCSI_MODEL), COLOR_TEXT);
+    draw_text(192, y, get_string(MSG_SCSI_READ_CACHE), COLOR_TEXT);
+    draw_text(232, y, get_string(MSG_SCSI_READ_AHEAD), COLOR_TEXT);
+    draw_text(272, y, get_string(MSG_SCSI_WRITE_CACHE), COLOR_TEXT);
+    for (s = 0; s < SCSI_READ_SIZES; s++) {
+        snprintf(buffer, sizeof(buffer), "%u %s", (unsigned)scsi_read_blocks[s],
+                 get_string(MSG_SCSI_BLOCKS));
+        draw_text_right(columns[s], y, 68, buffer, COLOR_TEXT);
+    }
+
+    draw_panel(20, 46, 600, 130, NULL);
+
+    y = 60;
+    for (i = 0; i < scsi_device_list.count && i < 11; i++) {
+        const ScsiDeviceInfo *dev = &scsi_device_list.devices[i];
+
+        if (!dev->is_valid) continue;
+
+        if (dev->lun > 0) {
+            snprintf(buffer, sizeof(buffer), "%d.%d", dev->target_id, dev->lun);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%d", dev->target_id);
+        }
+        draw_text(28, y, buffer, COLOR_HIGHLIGHT);
+        draw_text(56, y, dev->model, COLOR_HIGHLIGHT);
+
+        draw_text(192, y, cache_state(dev->cache_flags, SCSI_CACHE_READ), COLOR_HIGHLIGHT);
+        draw_text(232, y, cache_state(dev->cache_flags, SCSI_CACHE_READ_AHEAD), COLOR_HIGHLIGHT);
+        draw_text(272, y, cache_state(dev->cache_flags, SCSI_CACHE_WRITE), COLOR_HIGHLIGHT);
+
+        for (s = 0; s < SCSI_READ_SIZES; s++) {
+            if (dev->speed_measured && dev->read_bytes_sec[s] > 0) {
+                format_scaled(buffer, sizeof(buffer), dev->read_bytes_sec[s] / 10000, FALSE);
+            } else {
+                snprintf(buffer, sizeof(buffer), "%s", get_string(MSG_DASH_PLACEHOLDER));
+            }
+            draw_text_right(columns[s], y, 68, buffer, COLOR_HIGHLIGHT);
+        }
+        y += 10;
+    }
+
+    if (scsi_device_list.count == 0) {
+        draw_text(250, 100, get_string(MSG_SCSI_NO_DEVICES), COLOR_TEXT);
+    } else {
+        draw_text(28, 170, get_string(MSG_SCSI_SPEED_HINT), COLOR_TEXT);
+    }
+
+    draw_scsi_buttons();
+}
+
 /*
  * Draw the SCSI device information screen
  */
@@ -521,7 +987,11 @@ void draw_scsi_view(void)
     char buffer[128];
     WORD y;
     ULONG i;
-    Button *btn;
+
+    if (app->scsi_show_speed) {
+        draw_scsi_speed_view();
+        return;
+    }
 
     /* Clear background */
     SetAPen(rp, COLOR_BACKGROUND);
@@ -571,8 +1041,12 @@ void draw_scsi_view(void)
         SetAPen(rp, COLOR_HIGHLIGHT);
         SetBPen(rp, COLOR_PANEL_BG);
 
-        /* ID */
-        snprintf(buffer, sizeof(buffer), "%d", dev->target_id);
+        /* ID, with LUN if not 0 */
+        if (dev->lun > 0) {
+            snprintf(buffer, sizeof(buffer), "%d.%d", dev->target_id, dev->lun);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%d", dev->target_id);
+        }
         Move(rp, 28, y);
         Text(rp, (CONST_STRPTR)buffer, strlen(buffer));
 
@@ -626,9 +1100,8 @@ void draw_scsi_view(void)
         Text(rp, (CONST_STRPTR)get_string(MSG_SCSI_NO_DEVICES), strlen(get_string(MSG_SCSI_NO_DEVICES)));
     }
 
-    /* Draw EXIT button */
-    btn = find_button(BTN_SCSI_EXIT);
-    if (btn) draw_button(btn);
+    /* Draw buttons */
+    draw_scsi_buttons();
 }
 
 /*
@@ -638,6 +1111,11 @@ void scsi_view_update_buttons(void)
 {
     add_button(20, 188, 60, 12,
                get_string(MSG_BTN_EXIT), BTN_SCSI_EXIT, TRUE);
+    add_button(88, 188, 60, 12,
+               get_string(MSG_BTN_REFRESH), BTN_SCSI_REFRESH, TRUE);
+    add_button(156, 188, 60, 12,
+               app->scsi_show_speed ? get_string(MSG_BTN_INFO) : get_string(MSG_BTN_SPEED),
+               BTN_SCSI_SPEED, scsi_device_list.count > 0 || app->scsi_show_speed);
 }
 
 /*
@@ -647,5 +1125,22 @@ void scsi_view_handle_button(ButtonID id)
 {
     if (id == BTN_SCSI_EXIT) {
         switch_to_view(VIEW_DRIVES);
+    } else if (id == BTN_SCSI_REFRESH) {
+        /* Pooled name, stays valid while the list is rebuilt */
+        show_status_overlay(get_string(MSG_PROBING_DRIVES));
+        scan_scsi_devices(scsi_device_list.device_name, 0, TRUE);
+        hide_status_overlay();
+    } else if (id == BTN_SCSI_SPEED) {
+        /* The background suite would compete for the bus */
+        if (benchmark_task_running()) return;
+        if (app->scsi_show_speed) {
+            app->scsi_show_speed = FALSE;
+            redraw_current_view();
+        } else {
+            app->scsi_show_speed = TRUE;
+            show_status_overlay(get_string(MSG_MEASURING_SPEED));
+            measure_scsi_speed();
+            hide_status_overlay();
+        }
     }
 }
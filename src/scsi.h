@@ -10,8 +10,23 @@
 
 #include "xsysinfo.h"
 
-/* Maximum SCSI devices we'll track */
-#define MAX_SCSI_DEVICES    64
+/* Bus scan */
+#define SCSI_MAX_TARGETS    16      /* IDs 0-15 for wide SCSI */
+#define SCSI_MAX_LUNS       8
+#define SCSI_PROBE_STACK    4096    /* Stack per probe task */
+
+/* Native READ(10) benchmark through HD_SCSICMD */
+#define SCSI_READ_SIZES     4       /* 1, 8, 64 and 256 blocks per command */
+#define SCSI_READ_MAX_BLOCKS 256
+#define SCSI_READ_BYTES     (256 * 1024) /* Bytes read per size (at least) */
+#define SCSI_READ_MIN_CMDS  4       /* Commands per size (at least) */
+#define SCSI_READ_MAX_BLOCK_SIZE 2048
+
+/* MODE SENSE caching page (8) */
+#define SCSI_CACHE_KNOWN        0x01    /* Drive returned the page */
+#define SCSI_CACHE_READ         0x02    /* RCD clear: read cache enabled */
+#define SCSI_CACHE_READ_AHEAD   0x04    /* DRA clear: read-ahead enabled */
+#define SCSI_CACHE_WRITE        0x08    /* WCE set: write cache enabled */
 
 /* Wide SCSI indicator (from Phase V scheme) */
 #define HD_WIDESCSI     0x80
@@ -53,14 +68,18 @@ typedef struct {
     ULONG block_size;               /* Block size in bytes */
     ULONG real_size_mb;             /* Real size in MB */
     ULONG format_size_mb;           /* Formatted size in MB */
+    UBYTE cache_flags;              /* SCSI_CACHE_* */
+    ULONG read_bytes_sec[SCSI_READ_SIZES]; /* READ(10) speed, 0 = not measured */
+    BOOL speed_measured;
     BOOL is_valid;                  /* Entry contains valid data */
 } ScsiDeviceInfo;
 
-/* SCSI device list */
+/* SCSI device list, devices allocated from the pool */
 typedef struct {
-    ScsiDeviceInfo devices[MAX_SCSI_DEVICES];
+    ScsiDeviceInfo *devices;
     ULONG count;
-    char device_name[64];           /* Device driver name */
+    ULONG capacity;
+    const char *device_name;        /* Device driver name (pooled) */
 } ScsiDeviceList;
 
 /* Global SCSI device list */
@@ -68,11 +87,23 @@ extern ScsiDeviceList scsi_device_list;
 
 /* Function prototypes */
 
+/* Empty a list and set the controller it describes */
+void scsi_list_reset(ScsiDeviceList *list, const char *device_name);
+
+/* Append a cleared device, NULL if out of memory */
+ScsiDeviceInfo *scsi_list_add(ScsiDeviceList *list);
+
 /* Check if a device supports SCSI direct commands */
 BOOL check_scsi_direct_support(const char *handler_name, ULONG unit_number);
 
-/* Scan all SCSI devices on a controller */
-void scan_scsi_devices(const char *handler_name, ULONG base_unit);
+/* Scan all SCSI devices on a controller, or use the cached scan */
+void scan_scsi_devices(const char *handler_name, ULONG base_unit, BOOL force_probe);
+
+/* Block count of each read_bytes_sec entry */
+extern const UWORD scsi_read_blocks[SCSI_READ_SIZES];
+
+/* Time READ(10) on every disk-like device of the current list */
+void measure_scsi_speed(void);
 
 /* Draw the SCSI device information screen */
 void draw_scsi_view(void);
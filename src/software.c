@@ -8,6 +8,7 @@
 #include <string.h>
 
 #include <exec/execbase.h>
+#include <exec/memory.h>
 #include <exec/libraries.h>
 #include <exec/devices.h>
 #include <exec/resident.h>
@@ -18,6 +19,9 @@
 #include "xsysinfo.h"
 #include "software.h"
 #include "hardware.h"
+#include "memory.h"
+#include "pool.h"
+#include "profile.h"
 #include "locale_str.h"
 
 /* Global software lists */
@@ -26,6 +30,23 @@ SoftwareList devices_list;
 SoftwareList resources_list;
 SoftwareList mmu_list;
 
+/* Mappings of the default MMU context, see enumerate_mmu_entries() */
+static MmuMapping *mmu_mappings = NULL;
+static ULONG mmu_mapping_count = 0;
+static ULONG mmu_mapping_capacity = 0;
+static ULONG mmu_page_size = 0;
+static BOOL mmu_scanned = FALSE;
+
+/* Kickstart ROM and Zorro address spaces */
+#define ROM_START           0x00F80000
+#define ROM_END             0x00FFFFFF
+#define SLOW_RAM_START      0x00C00000
+#define SLOW_RAM_END        0x00D7FFFF
+#define ZORRO2_RAM_START    0x00200000
+#define ZORRO2_RAM_END      0x009FFFFF
+#define ZORRO3_START        0x10000000
+#define ZORRO3_END          0x7FFFFFFF
+
 /* External references */
 extern struct ExecBase *SysBase;
 
@@ -61,6 +82,57 @@ static void copy_base_name(char *dest, const char *src, size_t destsize)
     }
 }
 
+/*
+ * Pooled name with the suffix stripped if it has one
+ */
+static const char *entry_name(const char *name, const char *suffix)
+{
+    char buffer[64];
+
+    if (!name) return pool_string("(unknown)");
+    if (strstr(name, suffix) == NULL) return pool_string(name);
+
+    copy_base_name(buffer, name, sizeof(buffer));
+    return pool_string(buffer);
+}
+
+/*
+ * Append a cleared entry, NULL if out of memory
+ */
+static SoftwareEntry *add_entry(SoftwareList *list)
+{
+    SoftwareEntry *entries;
+
+    entries = pool_grow(list->entries, &list->capacity, list->count + 1,
+                        sizeof(SoftwareEntry));
+    if (!entries) return NULL;
+    list->entries = entries;
+
+    memset(&entries[list->count], 0, sizeof(SoftwareEntry));
+    return &entries[list->count++];
+}
+
+/*
+ * Insert a cleared entry at the beginning, NULL if out of memory
+ */
+static SoftwareEntry *insert_first_entry(SoftwareList *list)
+{
+    if (!add_entry(list)) return NULL;
+
+    memmove(&list->entries[1], &list->entries[0],
+            (list->count - 1) * sizeof(SoftwareEntry));
+    memset(&list->entries[0], 0, sizeof(SoftwareEntry));
+
+    return &list->entries[0];
+}
+
+static void add_text_entry(SoftwareList *list, const char *text)
+{
+    SoftwareEntry *entry = add_entry(list);
+
+    if (entry) entry->name = pool_string(text);
+}
+
 /* Comparison function for sorting */
 static int compare_entries(const void *a, const void *b)
 {
@@ -96,10 +168,9 @@ void sort_software_list(SoftwareList *list)
 void enumerate_libraries(void)
 {
     struct Library *lib;
-    ULONG i;
     SoftwareEntry *entry;
 
-    memset(&libraries_list, 0, sizeof(libraries_list));
+    libraries_list.count = 0;
 
     Forbid();
 
@@ -107,7 +178,7 @@ void enumerate_libraries(void)
          (struct Node *)lib != (struct Node *)&SysBase->LibList.lh_Tail;
          lib = (struct Library *)lib->lib_Node.ln_Succ) {
 
-        /* Detect FPU library presence (outside entry limit check) */
+        /* Detect FPU library presence */
         if (lib->lib_Node.ln_Name) {
             if (strcmp(lib->lib_Node.ln_Name, "68040.library") == 0) {
                 if (hw_info.fpu_type == FPU_68040)
@@ -122,78 +193,47 @@ void enumerate_libraries(void)
             }
         }
 
-        if (libraries_list.count >= MAX_SOFTWARE_ENTRIES)
-            continue;
-
-        entry = &libraries_list.entries[libraries_list.count];
-
-        if (lib->lib_Node.ln_Name) {
-            if (strstr(lib->lib_Node.ln_Name, ".library") != NULL) {
-                copy_base_name(entry->name, lib->lib_Node.ln_Name, sizeof(entry->name));
-            } else { /* not a ".library" */
-                strncpy(entry->name, lib->lib_Node.ln_Name, sizeof(entry->name));
-            }
-        } else {
-            strncpy(entry->name, "(unknown)", sizeof(entry->name) - 1);
-        }
+        entry = add_entry(&libraries_list);
+        if (!entry) continue;
 
+        entry->name = entry_name(lib->lib_Node.ln_Name, ".library");
         entry->address = (APTR)lib;
         entry->version = lib->lib_Version;
         entry->revision = lib->lib_Revision;
         entry->location = determine_mem_location((APTR)lib);
-
-        libraries_list.count++;
     }
 
     Permit();
 
     sort_software_list(&libraries_list);
 
-    /* Insert artificial "kickstart" entry at the beginning */
-    /* Insert artificial "kickstart (soft)" entry at the beginning */
-    if ((libraries_list.count+1) < MAX_SOFTWARE_ENTRIES) {
-        if (hw_info.kickstart_version != hw_info.kickstart_patch_version &&
-            hw_info.kickstart_revision != hw_info.kickstart_patch_revision &&
-            0 != hw_info.kickstart_patch_version &&
-            0 != hw_info.kickstart_patch_revision &&
-            hw_info.kickstart_version >= 40 /* softkick from Kick 3.1 (v40)+ */
-        ) {
-            /* Shift all entries by 1 position */
-            for (i = libraries_list.count; i > 0; i--) {
-                libraries_list.entries[i] = libraries_list.entries[i - 1];
-            }
-
-            /* Insert kickstart entry at position 0 */
-            entry = &libraries_list.entries[0];
-            strncpy(entry->name, "kick update", sizeof(entry->name) - 1);
-            entry->name[sizeof(entry->name) - 1] = '\0';
+    /* Insert artificial "kick update" entry at the beginning */
+    if (hw_info.kickstart_version != hw_info.kickstart_patch_version &&
+        hw_info.kickstart_revision != hw_info.kickstart_patch_revision &&
+        0 != hw_info.kickstart_patch_version &&
+        0 != hw_info.kickstart_patch_revision &&
+        hw_info.kickstart_version >= 40 /* softkick from Kick 3.1 (v40)+ */
+    ) {
+        entry = insert_first_entry(&libraries_list);
+        if (entry) {
+            entry->name = pool_string("kick update");
             entry->location = LOC_KICKSTART;
             /* ROM base: 0x00f80000 for 512K, 0x00fc0000 for 256K */
             entry->address = (APTR)(hw_info.kickstart_size >= 512 ? 0x00f80000 : 0x00fc0000);
             entry->version = hw_info.kickstart_patch_version;
             entry->revision = hw_info.kickstart_patch_revision;
-
-            libraries_list.count++;
-
-        }
-
-
-        /* Shift all entries by 1 position */
-        for (i = libraries_list.count; i > 0; i--) {
-            libraries_list.entries[i] = libraries_list.entries[i - 1];
         }
+    }
 
-        /* Insert kickstart entry at position 0 */
-        entry = &libraries_list.entries[0];
-        strncpy(entry->name, "kickstart", sizeof(entry->name) - 1);
-        entry->name[sizeof(entry->name) - 1] = '\0';
+    /* Insert artificial "kickstart" entry at the beginning */
+    entry = insert_first_entry(&libraries_list);
+    if (entry) {
+        entry->name = pool_string("kickstart");
         entry->location = LOC_KICKSTART;
         /* ROM base: 0x00f80000 for 512K, 0x00fc0000 for 256K */
         entry->address = (APTR)(hw_info.kickstart_size >= 512 ? 0x00f80000 : 0x00fc0000);
         entry->version = hw_info.kickstart_version;
         entry->revision = hw_info.kickstart_revision;
-
-        libraries_list.count++;
     }
 }
 
@@ -203,8 +243,9 @@ void enumerate_libraries(void)
 void enumerate_devices(void)
 {
     struct Device *dev;
+    SoftwareEntry *entry;
 
-    memset(&devices_list, 0, sizeof(devices_list));
+    devices_list.count = 0;
 
     Forbid();
 
@@ -212,27 +253,14 @@ void enumerate_devices(void)
          (struct Node *)dev != (struct Node *)&SysBase->DeviceList.lh_Tail;
          dev = (struct Device *)dev->dd_Library.lib_Node.ln_Succ) {
 
-        if (devices_list.count >= MAX_SOFTWARE_ENTRIES) break;
-
-        SoftwareEntry *entry = &devices_list.entries[devices_list.count];
-
-        if (dev->dd_Library.lib_Node.ln_Name) {
-            if (strstr(dev->dd_Library.lib_Node.ln_Name, ".device") != NULL) {
-                copy_base_name(entry->name, dev->dd_Library.lib_Node.ln_Name,
-                               sizeof(entry->name));
-            } else { //not a ".device"
-                strncpy(entry->name, dev->dd_Library.lib_Node.ln_Name, sizeof(entry->name));
-            }
-        } else {
-            strncpy(entry->name, "(unknown)", sizeof(entry->name) - 1);
-        }
+        entry = add_entry(&devices_list);
+        if (!entry) break;
 
+        entry->name = entry_name(dev->dd_Library.lib_Node.ln_Name, ".device");
         entry->address = (APTR)dev;
         entry->version = dev->dd_Library.lib_Version;
         entry->revision = dev->dd_Library.lib_Revision;
         entry->location = determine_mem_location((APTR)dev);
-
-        devices_list.count++;
     }
 
     Permit();
@@ -246,8 +274,9 @@ void enumerate_devices(void)
 void enumerate_resources(void)
 {
     struct Library *res;
+    SoftwareEntry *entry;
 
-    memset(&resources_list, 0, sizeof(resources_list));
+    resources_list.count = 0;
 
     Forbid();
 
@@ -255,27 +284,14 @@ void enumerate_resources(void)
          (struct Node *)res != (struct Node *)&SysBase->ResourceList.lh_Tail;
          res = (struct Library *)res->lib_Node.ln_Succ) {
 
-        if (resources_list.count >= MAX_SOFTWARE_ENTRIES) break;
-
-        SoftwareEntry *entry = &resources_list.entries[resources_list.count];
-
-        if (res->lib_Node.ln_Name) {
-            if (strstr(res->lib_Node.ln_Name, ".resource") != NULL) {
-                copy_base_name(entry->name, res->lib_Node.ln_Name,
-                               sizeof(entry->name));
-            } else { //not a ".resource"
-                strncpy(entry->name, res->lib_Node.ln_Name, sizeof(entry->name));
-            }
-        } else {
-            strncpy(entry->name, "(unknown)", sizeof(entry->name) - 1);
-        }
+        entry = add_entry(&resources_list);
+        if (!entry) break;
 
+        entry->name = entry_name(res->lib_Node.ln_Name, ".resource");
         entry->address = (APTR)res;
         entry->version = res->lib_Version;
         entry->revision = res->lib_Revision;
         entry->location = determine_mem_location((APTR)res);
-
-        resources_list.count++;
     }
 
     Permit();
@@ -283,13 +299,143 @@ void enumerate_resources(void)
     sort_software_list(&resources_list);
 }
 
+/*
+ * Format a mapping as shown in the MMU list
+ */
+static void format_mmu_mapping(const MmuMapping *m, char *buffer, ULONG bufsize)
+{
+    size_t pos;
+
+    pos = snprintf(buffer, bufsize, "%08lx-%08lx", m->lower, m->higher);
+    if (m->properties & MAPP_WINDOW)
+    {
+        pos += snprintf(buffer + pos, bufsize - pos, " Window %08lx", m->data);
+        /* All other flags do not care then */
+    }
+    else {
+        if (m->properties & MAPP_WRITEPROTECTED) {
+            pos += snprintf(buffer + pos, bufsize - pos, " WP");
+        }
+
+        if (m->properties & MAPP_USED) {
+            pos += snprintf(buffer + pos, bufsize - pos, " U");
+        }
+
+        if (m->properties & MAPP_MODIFIED) {
+            pos += snprintf(buffer + pos, bufsize - pos, " M");
+        }
+
+        if (m->properties & MAPP_GLOBAL) {
+            pos += snprintf(buffer + pos, bufsize - pos, " G");
+        }
+
+        if (m->properties & MAPP_TRANSLATED) {
+            pos += snprintf(buffer + pos, bufsize - pos, " TT");
+        }
+
+        if (m->properties & MAPP_ROM) {
+            pos += snprintf(buffer + pos, bufsize - pos, " ROM");
+        }
+
+        if (m->properties & MAPP_USERPAGE0) {
+            pos += snprintf(buffer + pos, bufsize - pos, " UP0");
+        }
+
+        if (m->properties & MAPP_USERPAGE1) {
+            pos += snprintf(buffer + pos, bufsize - pos, " UP1");
+        }
+
+        if (m->properties & MAPP_CACHEINHIBIT) {
+            pos += snprintf(buffer + pos, bufsize - pos, " CI");
+        }
+
+        if (m->properties & MAPP_IMPRECISE) {
+            pos += snprintf(buffer + pos, bufsize - pos, " IM");
+        }
+
+        if (m->properties & MAPP_NONSERIALIZED) {
+            pos += snprintf(buffer + pos, bufsize - pos, " NS");
+        }
+
+        if (m->properties & MAPP_COPYBACK) {
+            pos += snprintf(buffer + pos, bufsize - pos, " CB");
+        }
+
+        if (m->properties & MAPP_SUPERVISORONLY) {
+            pos += snprintf(buffer + pos, bufsize - pos, " SO");
+        }
+
+        if (m->properties & MAPP_BLANK) {
+            pos += snprintf(buffer + pos, bufsize - pos, " BL");
+        }
+
+        if (m->properties & MAPP_SHARED) {
+            pos += snprintf(buffer + pos, bufsize - pos, " SH");
+        }
+
+        if (m->properties & MAPP_SINGLEPAGE) {
+            pos += snprintf(buffer + pos, bufsize - pos, " SNG");
+        }
+
+        if (m->properties & MAPP_REPAIRABLE) {
+            pos += snprintf(buffer + pos, bufsize - pos, " RP");
+        }
+
+        if (m->properties & MAPP_IO) {
+            pos += snprintf(buffer + pos, bufsize - pos, " IO");
+        }
+
+        if (m->properties & MAPP_USER0) {
+            pos += snprintf(buffer + pos, bufsize - pos, " U0");
+        }
+
+        if (m->properties & MAPP_USER1) {
+            pos += snprintf(buffer + pos, bufsize - pos, " U1");
+        }
+
+        if (m->properties & MAPP_USER2) {
+            pos += snprintf(buffer + pos, bufsize - pos, " U2");
+        }
+
+        if (m->properties & MAPP_USER3) {
+            pos += snprintf(buffer + pos, bufsize - pos, " U3");
+        }
+
+        if (m->properties & MAPP_INVALID) {
+            pos += snprintf(buffer + pos, bufsize - pos, " INV %08lx", m->data);
+        }
+
+        if (m->properties & MAPP_SWAPPED) {
+            pos += snprintf(buffer + pos, bufsize - pos, " SW %08lx", m->data);
+        }
+
+        if (m->properties & MAPP_REMAPPED) {
+            pos += snprintf(buffer + pos, bufsize - pos, " MAP %08lx", m->data + m->lower);
+        }
+
+        if (m->properties & MAPP_BUNDLED) {
+            pos += snprintf(buffer + pos, bufsize - pos, " BN %08lx", m->data);
+        }
+
+        if (m->properties & MAPP_INDIRECT) {
+            pos += snprintf(buffer + pos, bufsize - pos, " IND %08lx", m->data);
+        }
+    }
+}
+
+/*
+ * Copy the mappings of the default context, they are formatted and
+ * analyzed from the copy
+ */
 void enumerate_mmu_entries(void)
 {
     struct MinList *list;
     struct MappingNode *mn;
-    SoftwareEntry *entry;
-    char buffer[128];
-    memset(&mmu_list, 0, sizeof(mmu_list));
+    MmuMapping *mappings;
+    MmuMapping *m;
+
+    mmu_mapping_count = 0;
+    mmu_scanned = FALSE;
 
     Forbid();
 
@@ -299,184 +445,260 @@ void enumerate_mmu_entries(void)
         if ((DOSBase = (struct DosLibrary *)OpenLibrary((CONST_STRPTR)"dos.library", 37L))) {
             if ((MMUBase = OpenLibrary((CONST_STRPTR)"mmu.library", 40L))) {
 
-                entry = &mmu_list.entries[mmu_list.count];
-                snprintf(entry->name, sizeof(entry->name), "%s: %lukB.",
-                         get_string(MSG_MMU_SIZE),
-                         (unsigned long)(GetPageSize(NULL) / 1024));
-                mmu_list.count++;
+                mmu_page_size = GetPageSize(NULL);
+                mmu_scanned = TRUE;
+
                 /* Get the mapping of the default context */
                 list = GetMapping(NULL);
                 for (mn = (struct MappingNode *)(list->mlh_Head);
-                     mn->map_succ && mmu_list.count < 256;
+                     mn->map_succ;
                      mn = mn->map_succ)
                 {
-                    size_t pos;
-                    memset(buffer, 0, sizeof(buffer));
-                    pos = snprintf(buffer, sizeof(buffer), "%08lx-%08lx", mn->map_Lower, mn->map_Higher);
-                    if (mn->map_Properties & MAPP_WINDOW)
-                    {
-                        pos += snprintf(buffer + pos, sizeof(buffer) - pos, " Window %08lx", ((ULONG)mn->map_un.map_UserData));
-                        /* All other flags do not care then */
-                    }
-                    else {
-                        if (mn->map_Properties & MAPP_WRITEPROTECTED) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " WP");
-                        }
-
-                        if (mn->map_Properties & MAPP_USED) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " U");
-                        }
-
-                        if (mn->map_Properties & MAPP_MODIFIED) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " M");
-                        }
-
-                        if (mn->map_Properties & MAPP_GLOBAL) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " G");
-                        }
-
-                        if (mn->map_Properties & MAPP_TRANSLATED) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " TT");
-                        }
-
-                        if (mn->map_Properties & MAPP_ROM) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " ROM");
-                        }
-
-                        if (mn->map_Properties & MAPP_USERPAGE0) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " UP0");
-                        }
-
-                        if (mn->map_Properties & MAPP_USERPAGE1) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " UP1");
-                        }
-
-                        if (mn->map_Properties & MAPP_CACHEINHIBIT) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " CI");
-                        }
-
-                        if (mn->map_Properties & MAPP_IMPRECISE) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " IM");
-                        }
-
-                        if (mn->map_Properties & MAPP_NONSERIALIZED) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " NS");
-                        }
-
-                        if (mn->map_Properties & MAPP_COPYBACK) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " CB");
-                        }
-
-                        if (mn->map_Properties & MAPP_SUPERVISORONLY) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " SO");
-                        }
-
-                        if (mn->map_Properties & MAPP_BLANK) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " BL");
-                        }
-
-                        if (mn->map_Properties & MAPP_SHARED) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " SH");
-                        }
-
-                        if (mn->map_Properties & MAPP_SINGLEPAGE) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " SNG");
-                        }
-
-                        if (mn->map_Properties & MAPP_REPAIRABLE) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " RP");
-                        }
-
-                        if (mn->map_Properties & MAPP_IO) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " IO");
-                        }
-
-                        if (mn->map_Properties & MAPP_USER0) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " U0");
-                        }
-
-                        if (mn->map_Properties & MAPP_USER1) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " U1");
-                        }
-
-                        if (mn->map_Properties & MAPP_USER2) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " U2");
-                        }
-
-                        if (mn->map_Properties & MAPP_USER3) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " U3");
-                        }
-
-                        if (mn->map_Properties & MAPP_INVALID) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " INV %08lx", ((ULONG)mn->map_un.map_UserData));
-                        }
-
-                        if (mn->map_Properties & MAPP_SWAPPED) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " SW %08lx", ((ULONG)mn->map_un.map_UserData));
-                        }
-
-                        if (mn->map_Properties & MAPP_REMAPPED) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " MAP %08lx", ((ULONG)(mn->map_un.map_Delta + mn->map_Lower)));
-                        }
-
-                        if (mn->map_Properties & MAPP_BUNDLED) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " BN %08lx", ((ULONG)mn->map_un.map_Page));
-                        }
-
-                        if (mn->map_Properties & MAPP_INDIRECT) {
-                            pos += snprintf(buffer + pos, sizeof(buffer) - pos, " IND %08lx", ((ULONG)mn->map_un.map_Descriptor));
-                        }
-                    }
-                    entry = &mmu_list.entries[mmu_list.count];
-                    snprintf(entry->name, sizeof(entry->name), "%s", buffer);
-                    mmu_list.count++;
-                }
-                /* Append hint entries at end of list */
-                if (mmu_list.count < 256 - 8) {
-                    entry = &mmu_list.entries[mmu_list.count];
-                    snprintf(entry->name, sizeof(entry->name), "%s",
-                             get_string(MSG_MMU_ADDRESS_HINT));
-                    mmu_list.count++;
-                    entry = &mmu_list.entries[mmu_list.count];
-                    snprintf(entry->name, sizeof(entry->name), "%s",
-                             get_string(MSG_MMU_FLAGS1_HINT));
-                    mmu_list.count++;
-                    entry = &mmu_list.entries[mmu_list.count];
-                    snprintf(entry->name, sizeof(entry->name), "%s",
-                             get_string(MSG_MMU_FLAGS2_HINT));
-                    mmu_list.count++;
-                    entry = &mmu_list.entries[mmu_list.count];
-                    snprintf(entry->name, sizeof(entry->name), "%s",
-                             get_string(MSG_MMU_FLAGS3_HINT));
-                    mmu_list.count++;
-                    entry = &mmu_list.entries[mmu_list.count];
-                    snprintf(entry->name, sizeof(entry->name), "%s",
-                             get_string(MSG_MMU_FLAGS4_HINT));
-                    mmu_list.count++;
-                    entry = &mmu_list.entries[mmu_list.count];
-                    snprintf(entry->name, sizeof(entry->name), "%s",
-                             get_string(MSG_MMU_FLAGS5_HINT));
-                    mmu_list.count++;
-                    entry = &mmu_list.entries[mmu_list.count];
-                    snprintf(entry->name, sizeof(entry->name), "%s",
-                             get_string(MSG_MMU_FLAGS6_HINT));
-                    mmu_list.count++;
-                    entry = &mmu_list.entries[mmu_list.count];
-                    snprintf(entry->name, sizeof(entry->name), "%s",
-                             get_string(MSG_MMU_FLAGS7_HINT));
-                    mmu_list.count++;
+                    mappings = pool_grow(mmu_mappings, &mmu_mapping_capacity,
+                                         mmu_mapping_count + 1, sizeof(MmuMapping));
+                    if (!mappings) break;
+                    mmu_mappings = mappings;
+
+                    m = &mmu_mappings[mmu_mapping_count++];
+                    m->lower = mn->map_Lower;
+                    m->higher = mn->map_Higher;
+                    m->properties = mn->map_Properties;
+                    m->data = (ULONG)mn->map_un.map_UserData;
                 }
 
                 CloseLibrary((struct Library *)MMUBase);
             }
             CloseLibrary((struct Library *)DOSBase);
         }
-    } else {
-        SoftwareEntry *entry = &mmu_list.entries[0];
-        strncpy(entry->name, "mmu.library not loaded", sizeof(entry->name) - 1);
-        mmu_list.count++;
     }
     Permit();
+
+    analyze_mmu_mappings();
+}
+
+/*
+ * Attributes of the memory a mapping covers, 0 if it maps no RAM
+ */
+static UWORD mapping_mem_attrs(const MmuMapping *m)
+{
+    struct MemHeader *mh;
+    UWORD attrs = 0;
+
+    Forbid();
+    for (mh = (struct MemHeader *)SysBase->MemList.lh_Head;
+         (struct Node *)mh != (struct Node *)&SysBase->MemList.lh_Tail;
+         mh = (struct MemHeader *)mh->mh_Node.ln_Succ) {
+        if ((ULONG)mh->mh_Lower <= m->higher && (ULONG)mh->mh_Upper > m->lower) {
+            attrs |= mh->mh_Attributes;
+        }
+    }
+    Permit();
+
+    return attrs;
+}
+
+static BOOL is_zorro_address(ULONG address)
+{
+    return (address >= ZORRO2_RAM_START && address <= ZORRO2_RAM_END) ||
+           (address >= ZORRO3_START && address <= ZORRO3_END);
+}
+
+/*
+ * TRUE if an mmu.library mapping serves the Kickstart ROM from RAM
+ */
+BOOL mmu_rom_remapped(void)
+{
+    ULONG i;
+
+    for (i = 0; i < mmu_mapping_count; i++) {
+        const MmuMapping *m = &mmu_mappings[i];
+
+        if (m->lower <= ROM_END && m->higher >= ROM_START &&
+            (m->properties & MAPP_REMAPPED)) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/*
+ * Performance problem of a mapping, MSG_COUNT if there is none
+ */
+static LocaleStringID mapping_problem(const MmuMapping *m)
+{
+    ULONG props = m->properties;
+    UWORD attrs;
+
+    /* Not backed by memory */
+    if (props & (MAPP_WINDOW | MAPP_INVALID | MAPP_SWAPPED | MAPP_BLANK | MAPP_IO)) {
+        return MSG_COUNT;
+    }
+
+    /* MuFastROM and friends remap the ROM to a FAST RAM copy */
+    if (m->lower <= ROM_END && m->higher >= ROM_START) {
+        return (props & MAPP_REMAPPED) ? MSG_COUNT : MSG_MMU_ROM_NOT_SHADOWED;
+    }
+
+    attrs = mapping_mem_attrs(m);
+
+    if (attrs & MEMF_CHIP) {
+        return (props & MAPP_IMPRECISE) ? MSG_MMU_CHIP_IMPRECISE : MSG_COUNT;
+    }
+
+    /* Slow RAM is not worth caching */
+    if (!(attrs & MEMF_FAST) ||
+        (m->lower >= SLOW_RAM_START && m->higher <= SLOW_RAM_END)) {
+        return MSG_COUNT;
+    }
+
+    if (props & MAPP_CACHEINHIBIT) {
+        return is_zorro_address(m->lower) ? MSG_MMU_ZORRO_INHIBITED : MSG_MMU_FAST_INHIBITED;
+    }
+
+    /* Only the 68040 and 68060 (with their LC variants) have a copyback data cache */
+    if (!(props & MAPP_COPYBACK) &&
+        (hw_info.cpu_type == CPU_68040 || hw_info.cpu_type == CPU_68LC040 ||
+         hw_info.cpu_type == CPU_68060 || hw_info.cpu_type == CPU_68LC060)) {
+        return MSG_MMU_FAST_WRITETHROUGH;
+    }
+
+    return MSG_COUNT;
+}
+
+static void add_finding(ULONG lower, ULONG higher, LocaleStringID problem)
+{
+    char buffer[64];
+
+    snprintf(buffer, sizeof(buffer), "%08lx-%08lx %s",
+             (unsigned long)lower, (unsigned long)higher, get_string(problem));
+    add_text_entry(&mmu_list, buffer);
+}
+
+/*
+ * Flag mappings that slow the machine down. Adjacent mappings with the
+ * same problem are reported as one range.
+ */
+static ULONG check_mappings(void)
+{
+    LocaleStringID current = MSG_COUNT;
+    ULONG lower = 0, higher = 0;
+    ULONG findings = 0;
+    ULONG i;
+
+    for (i = 0; i < mmu_mapping_count; i++) {
+        const MmuMapping *m = &mmu_mappings[i];
+        LocaleStringID problem = mapping_problem(m);
+
+        if (problem == current && problem != MSG_COUNT && m->lower == higher + 1) {
+            higher = m->higher;
+            continue;
+        }
+
+        if (current != MSG_COUNT) {
+            add_finding(lower, higher, current);
+            findings++;
+        }
+        current = problem;
+        lower = m->lower;
+        higher = m->higher;
+    }
+
+    if (current != MSG_COUNT) {
+        add_finding(lower, higher, current);
+        findings++;
+    }
+
+    return findings;
+}
+
+/*
+ * Cross-check with measured speeds: whatever the mapping says, FAST RAM
+ * that reads no faster than CHIP RAM is not being cached
+ */
+static ULONG check_region_speeds(void)
+{
+    ULONG chip_speed = 0;
+    ULONG findings = 0;
+    ULONG i;
+
+    for (i = 0; i < memory_regions.count; i++) {
+        MemoryRegion *region = &memory_regions.regions[i];
+        if ((region->mem_type & MEMF_CHIP) && region->speed_measured) {
+            chip_speed = region->speed_bytes_sec;
+            break;
+        }
+    }
+    if (chip_speed == 0) return 0;
+
+    for (i = 0; i < memory_regions.count; i++) {
+        MemoryRegion *region = &memory_regions.regions[i];
+
+        if ((region->mem_type & MEMF_FAST) && !(region->mem_type & MEMF_CHIP) &&
+            region->speed_measured && region->speed_bytes_sec <= chip_speed) {
+            add_finding((ULONG)region->start_address, (ULONG)region->end_address,
+                        MSG_MMU_FAST_SLOW);
+            findings++;
+        }
+    }
+
+    return findings;
+}
+
+/*
+ * Build the MMU list from the copied mappings: one row per mapping
+ * (formatted when it is shown), the tuning findings and the flag legend
+ */
+void analyze_mmu_mappings(void)
+{
+    SoftwareEntry *entry;
+    char buffer[64];
+    ULONG i;
+
+    mmu_list.count = 0;
+
+    if (!mmu_scanned) {
+        if (!mmuLoaded || !hw_info.mmu_enabled) {
+            add_text_entry(&mmu_list, "mmu.library not loaded");
+        }
+        return;
+    }
+
+    snprintf(buffer, sizeof(buffer), "%s: %lukB.",
+             get_string(MSG_MMU_SIZE), (unsigned long)(mmu_page_size / 1024));
+    add_text_entry(&mmu_list, buffer);
+
+    for (i = 0; i < mmu_mapping_count; i++) {
+        entry = add_entry(&mmu_list);
+        if (!entry) break;
+        entry->mapping = &mmu_mappings[i];
+    }
+
+    add_text_entry(&mmu_list, get_string(MSG_MMU_TUNING));
+    if (check_mappings() + check_region_speeds() == 0) {
+        add_text_entry(&mmu_list, get_string(MSG_MMU_NO_PROBLEMS));
+    }
+
+    /* Append hint entries at end of list */
+    add_text_entry(&mmu_list, get_string(MSG_MMU_ADDRESS_HINT));
+    add_text_entry(&mmu_list, get_string(MSG_MMU_FLAGS1_HINT));
+    add_text_entry(&mmu_list, get_string(MSG_MMU_FLAGS2_HINT));
+    add_text_entry(&mmu_list, get_string(MSG_MMU_FLAGS3_HINT));
+    add_text_entry(&mmu_list, get_string(MSG_MMU_FLAGS4_HINT));
+    add_text_entry(&mmu_list, get_string(MSG_MMU_FLAGS5_HINT));
+    add_text_entry(&mmu_list, get_string(MSG_MMU_FLAGS6_HINT));
+    add_text_entry(&mmu_list, get_string(MSG_MMU_FLAGS7_HINT));
+}
+
+/*
+ * Name of an entry, MMU mappings are formatted into buffer
+ */
+const char *get_software_entry_name(const SoftwareEntry *entry, char *buffer, ULONG bufsize)
+{
+    if (entry->mapping) {
+        format_mmu_mapping(entry->mapping, buffer, bufsize);
+        return buffer;
+    }
+    return entry->name ? entry->name : "";
 }
 
 /*
@@ -484,10 +706,10 @@ void enumerate_mmu_entries(void)
  */
 void enumerate_all_software(void)
 {
-    enumerate_libraries();
-    enumerate_devices();
-    enumerate_resources();
-    enumerate_mmu_entries();
+    PROFILE_PHASE("enumerate_libraries", enumerate_libraries());
+    PROFILE_PHASE("enumerate_devices", enumerate_devices());
+    PROFILE_PHASE("enumerate_resources", enumerate_resources());
+    PROFILE_PHASE("enumerate_mmu_entries", enumerate_mmu_entries());
 }
 
 /*
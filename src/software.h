@@ -10,28 +10,36 @@
 
 #include "xsysinfo.h"
 
-/* Maximum entries we'll track */
-#define MAX_SOFTWARE_ENTRIES    256
+/* mmu.library mapping, formatted only when it is displayed */
+typedef struct {
+    ULONG lower;
+    ULONG higher;
+    ULONG properties;       /* MAPP_* flags */
+    ULONG data;             /* map_un, meaning depends on the flags */
+} MmuMapping;
 
 /* Software entry */
 typedef struct {
-    char name[64];
+    const char *name;       /* Pooled string */
+    const MmuMapping *mapping; /* MMU list mapping row, NULL otherwise */
     MemoryLocation location;
     APTR address;
     UWORD version;
     UWORD revision;
 } SoftwareEntry;
 
-/* Software list */
+/* Software list, entries allocated from the pool */
 typedef struct {
-    SoftwareEntry entries[MAX_SOFTWARE_ENTRIES];
+    SoftwareEntry *entries;
     ULONG count;
+    ULONG capacity;
 } SoftwareList;
 
 /* Global software lists */
 extern SoftwareList libraries_list;
 extern SoftwareList devices_list;
 extern SoftwareList resources_list;
+extern SoftwareList mmu_list;
 
 /* Function prototypes */
 void enumerate_libraries(void);
@@ -40,6 +48,13 @@ void enumerate_resources(void);
 void enumerate_mmu_entries(void);
 void enumerate_all_software(void);
 
+/* Rebuild the MMU list and its tuning findings, e.g. after speed tests */
+void analyze_mmu_mappings(void);
+BOOL mmu_rom_remapped(void);    /* mmu.library maps Kickstart to RAM */
+
+/* Display name of an entry, MMU mappings are formatted into buffer */
+const char *get_software_entry_name(const SoftwareEntry *entry, char *buffer, ULONG bufsize);
+
 /* Get the current list based on type */
 SoftwareList *get_software_list(SoftwareType type);
 
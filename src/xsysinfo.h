@@ -78,7 +78,9 @@ typedef enum {
     VIEW_MEMORY,
     VIEW_DRIVES,
     VIEW_BOARDS,
-    VIEW_SCSI
+    VIEW_SCSI,
+    VIEW_CPU,
+    VIEW_MONITOR
 } ViewMode;
 
 /* Software list types */
@@ -92,7 +94,11 @@ typedef enum {
 /* Software list types */
 typedef enum {
     HARDWARE_STD,
-    HARDWARE_EXT
+    HARDWARE_EXT,
+    HARDWARE_FPU,
+    HARDWARE_ROM,
+    HARDWARE_GFX,
+    HARDWARE_JIT
 } HardwareType;
 
 
@@ -111,6 +117,13 @@ typedef enum {
     SCALE_EXPAND        /* Linear scale to fit all */
 } BarScale;
 
+/* Memory speed line modes */
+typedef enum {
+    MEMSPEED_READ,
+    MEMSPEED_WRITE,
+    MEMSPEED_COPY
+} MemSpeedMode;
+
 /* Display mode (from tooltype or command line) */
 typedef enum {
     DISPLAY_AUTO,       /* Auto-detect based on screen resolution */
@@ -145,20 +158,39 @@ typedef struct {
     HardwareType hardware_type;     /* Which list is shown */
     LONG software_scroll;           /* Scroll offset */
     BarScale bar_scale;             /* Current bar graph scale */
+    MemSpeedMode mem_speed_mode;    /* Read/write/copy memory speeds shown */
     BOOL benchmarks_run;            /* Have benchmarks been executed? */
     BOOL scrollbar_dragging;        /* TRUE while dragging scrollbar */
     WORD pressed_button;            /* Currently pressed button ID, or -1 */
+    struct MsgPort *bench_port;     /* Background benchmark progress */
 
     /* Memory view state */
     LONG memory_region_index;       /* Currently displayed region */
     LONG memory_region_count;       /* Total regions */
+    BOOL memory_show_sweep;         /* Show cache-size sweep instead of info */
+    BOOL memory_show_frag;          /* Show free-list fragmentation instead of info */
+    BOOL memory_show_dma;           /* Show CHIP DMA contention instead of info */
 
     /* Drives view state */
     LONG selected_drive;            /* Currently selected drive */
     LONG drive_count;               /* Total drives */
+    BOOL drives_show_matrix;        /* Show transfer matrix instead of info */
+    BOOL drives_show_fs;            /* Show filesystem results instead of info */
+
+    /* SCSI view state */
+    BOOL scsi_show_speed;           /* Show READ(10) speed and caches instead of info */
+
+    /* CPU view state */
+    BOOL cpu_show_cache_matrix;     /* Show cache matrix instead of timing */
+    BOOL cpu_show_blitter;          /* Show blitter throughput instead of timing */
+    BOOL cpu_show_latency;          /* Show Exec latency instead of timing */
+
+    /* Monitor view state */
+    LONG monitor_region;            /* Region shown in the memory graph */
 
     /* Boards view state */
     LONG board_scroll;              /* Scroll offset */
+    LONG selected_board;            /* Board shown below the list, -1 if none */
     LONG board_count;               /* Total boards */
 
     /* Exit flag */
@@ -178,6 +210,14 @@ void cleanup_libraries(void);
 BOOL init_display(void);
 void cleanup_display(void);
 
+/* Subsystems for ensure_enumerated() */
+#define ENUM_MEMORY     0x01
+#define ENUM_BOARDS     0x02
+#define ENUM_DRIVES     0x04
+#define ENUM_ALL        (ENUM_MEMORY | ENUM_BOARDS | ENUM_DRIVES)
+
+void ensure_enumerated(ULONG subsystems);
+
 /* Utility functions */
 MemoryLocation determine_mem_location(APTR addr);
 const char *get_location_string(MemoryLocation loc);